@@ -35,4 +35,14 @@ constexpr int MIN_NUTRIENTS_TO_SPAWN_WORKER = 2000;
 constexpr int MIN_NUTRIENTS_TO_SPAWN_SOLDIER = 5000;
 constexpr int MIN_NUTRIENTS_TO_SPAWN_SCOUT = 7000;
 constexpr int MIN_NUTRIENTS_TO_SPAWN_QUEEN = 10000;
-constexpr int MAX_RECURSION_ALLOWED = 10;
\ No newline at end of file
+constexpr int MAX_RECURSION_ALLOWED = 10;
+constexpr int AGENT_CHUNK_SIZE = 16;	//Agents decided per job when the turn is split across threads
+constexpr int FOOD_CLAIM_TURNS = 16;	//Turns a worker's claim on food lasts unless the food auction renews it
+constexpr int FOOD_AUCTION_CANDIDATES = 6;	//Closest food tiles each idle worker bids on
+constexpr int FOOD_AUCTION_MAX_BIDS_PER_WORKER = 32;	//Bounds the auction, workers still bidding after that are left to the greedy search
+constexpr float FOOD_AUCTION_PRICE_CARRYOVER = 0.5f;	//Share of last turn's price a food tile starts the next auction with
+constexpr float FOOD_AUCTION_EPSILON = 0.5f;	//Least a food auction bid raises a price by, in tile cost
+constexpr double TURN_WINDOW_SECONDS = 0.030;	//minTurnTime of the Final match, the server doesn't hand it to the DLL
+constexpr double TURN_WORK_BUDGET_SHARE = 0.6;	//Share of the turn window expensive work may start in
+constexpr double TURN_FALLBACK_SHARE = 0.9;	//Past this share of the window the default orders go out if the turn isn't done
+constexpr int TURN_PROFILE_PRINT_INTERVAL = 0;	//Turns between phase timing printouts, 0 only prints them at shutdown
\ No newline at end of file
@@ -3,11 +3,16 @@
 #include "AICommons.hpp"
 #include "MathUtils.hpp"
 #include <math.h>
+#include <algorithm>
+#include <chrono>
 #include "ErrorWarningAssert.hpp"
 
 AIPlayerController* g_thePlayer = nullptr;
 extern volatile std::atomic<bool> gCanShutDown;
 
+//Chunk the calling thread is deciding agents for, nullptr outside of ProcessAgentChunk
+static thread_local AgentChunk_T* g_currentAgentChunk = nullptr;
+
 //------------------------------------------------------------------------------------------------------------------------------
 // Statics and locals
 //------------------------------------------------------------------------------------------------------------------------------
@@ -59,11 +64,45 @@ void AIPlayerController::Startup(const StartupInfo& info)
 	m_debugInterface = info.debugInterface;
 
 	// setup the turn number
-	m_currentTurnInfo.turnNumber = -1;
+	for (int bufferIndex = 0; bufferIndex < TripleBuffer<TurnSnapshot>::NUM_BUFFERS; bufferIndex++)
+	{
+		m_turnStateBuffer.GetBuffer(bufferIndex).Init(m_matchInfo.mapWidth);
+	}
+
+	m_currentTurnInfo = &m_turnStateBuffer.GetReadBuffer();
+	m_currentTurnInfo->turnNumber = -1;
 	m_lastTurnProcessed = -1;
+	m_lastTurnReceived = -1;
 	m_running = true;
 
 	m_queenReports = std::vector<AgentReport>(MAX_QUEENS);
+
+	m_turnScheduler.Init(info.maxTurnSeconds);
+	m_profiler.Init(info.expectedThreadCount);
+	m_jobSystem.Startup(info.expectedThreadCount);
+	m_pathingService.Startup(IntVec2(m_matchInfo.mapWidth, m_matchInfo.mapWidth), info.expectedThreadCount);
+	m_worldModel.Init(m_matchInfo.mapWidth);
+	m_observedAgentGrid.Init(m_matchInfo.mapWidth);
+	m_agentRegistry.Init(MAX_AGENTS_PER_PLAYER);
+	m_agentStore.Init(MAX_AGENTS_PER_PLAYER);
+	m_readyAgents.reserve(MAX_AGENTS_PER_PLAYER);
+	m_pathArena.Init(MAX_AGENTS_PER_PLAYER);
+	m_foodIndex.Init(m_matchInfo.mapWidth);
+	m_foodClaims.Init(m_matchInfo.mapWidth);
+	m_foodAuction.Init(m_matchInfo.mapWidth);
+	BuildTileCostTables();
+	m_workerFlowPather.Init(IntVec2(m_matchInfo.mapWidth, m_matchInfo.mapWidth), 1.f);
+	m_hierarchicalPatherScouts.Init(IntVec2(m_matchInfo.mapWidth, m_matchInfo.mapWidth));
+	m_hierarchicalPatherSoldiers.Init(IntVec2(m_matchInfo.mapWidth, m_matchInfo.mapWidth));
+
+	//Every tile starts unseen, from then on the world model's subscribers keep the maps and paths in step with it
+	BuildCostMapsFromWorldModel();
+	m_worldModel.Subscribe([this](const WorldModel& worldModel) { UpdateCostMapsForChangedTiles(worldModel); });
+	m_worldModel.Subscribe([this](const WorldModel& worldModel) { InvalidatePathsThroughChangedTiles(worldModel); });
+
+	//Incremental pathers allocate their map sized state the first time they are handed out
+	m_incrementalPathers.clear();
+	m_incrementalPathers.resize(DSTAR_MAX_POOLED_PATHERS);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -71,8 +110,45 @@ void AIPlayerController::Shutdown(const MatchResults& results)
 {
 	m_running = false;
 	m_turnCV.notify_all();
+	m_jobSystem.RequestStop();
 
-	DebuggerPrintf("\n Largest Open List: %d", m_pather.m_largestOpenList);
+	int largestOpenList = 0;
+	unsigned long long heapOperations = 0;
+	unsigned long long nodesExpanded = 0;
+	for (int threadIdx = 0; threadIdx < m_pathingService.GetNumContexts(); threadIdx++)
+	{
+		const AStarPather& pather = m_pathingService.GetAStarPather(threadIdx);
+		if (pather.m_largestOpenList > largestOpenList)
+		{
+			largestOpenList = pather.m_largestOpenList;
+		}
+		heapOperations += pather.m_heapOperations;
+		nodesExpanded += pather.m_nodesExpanded;
+	}
+
+	DebuggerPrintf("\n Job Threads: %d", m_jobSystem.GetNumThreads());
+	DebuggerPrintf("\n Jobs Run: %llu (%llu stolen)", (unsigned long long)m_jobSystem.m_jobsRun, (unsigned long long)m_jobSystem.m_jobsStolen);
+	DebuggerPrintf("\n Largest Open List: %d", largestOpenList);
+	DebuggerPrintf("\n Open List Heap Operations: %llu", heapOperations);
+	DebuggerPrintf("\n Nodes Expanded: %llu", nodesExpanded);
+	DebuggerPrintf("\n Paths Invalidated By Map Changes: %d", m_pathsInvalidated);
+	DebuggerPrintf("\n HPA Clusters Rebuilt: %d", m_hierarchicalPatherScouts.m_clustersRebuilt + m_hierarchicalPatherSoldiers.m_clustersRebuilt);
+	DebuggerPrintf("\n JPS+ Lines Rebuilt: %d", m_jumpPointsScouts.m_linesRebuilt + m_jumpPointsSoldiers.m_linesRebuilt);
+
+	unsigned long long incrementalNodesExpanded = 0;
+	for (int patherIndex = 0; patherIndex < (int)m_incrementalPathers.size(); patherIndex++)
+	{
+		incrementalNodesExpanded += m_incrementalPathers[patherIndex].m_nodesExpanded;
+	}
+	DebuggerPrintf("\n D* Lite Nodes Expanded: %llu", incrementalNodesExpanded);
+	DebuggerPrintf("\n Path Arena: %d steps (%d writes dropped)", m_pathArena.GetCapacityInCodes(), (int)m_pathArena.m_numWritesDropped);
+	DebuggerPrintf("\n Food Auction Bids: %llu (%d auctions cut short)", m_foodAuction.m_bidsPlaced, m_foodAuction.m_auctionsCutShort);
+	DebuggerPrintf("\n Food Claims Expired: %d", m_foodClaims.m_claimsExpired);
+	DebuggerPrintf("\n Turn Budget Used: %.0f%% average, %.0f%% worst (%d of %d turns over)", m_turnScheduler.GetAverageBudgetUsed() * 100.f,
+		m_turnScheduler.m_maxBudgetUsed * 100.f, m_turnScheduler.m_turnsOverBudget, m_turnScheduler.m_turnsScheduled);
+	DebuggerPrintf("\n Deferred To Next Turn: %d agents, %d tasks (default orders sent %d times)", m_turnScheduler.m_agentsDeferred,
+		m_turnScheduler.m_tasksSkipped, m_fallbacksSent);
+	m_profiler.PrintSummary("Turn Phases");
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -89,448 +165,629 @@ void AIPlayerController::WorkerThreadEntry(int threadIdx)
 	// wait for data
 	// process turn
 	// mark turn as finished;
-	ArenaTurnStateForPlayer turnState;
-
 	IntVec2 mapSize = IntVec2(m_matchInfo.mapWidth, m_matchInfo.mapWidth);
 
 	while (m_running)
 	{
-		std::unique_lock lk(m_turnLock);
-		m_turnCV.wait(lk, [&]() { return !m_running || m_lastTurnProcessed != m_currentTurnInfo.turnNumber; });
+		{
+			//The server thread only notifies and never takes this lock, so a publish can land between the check and the
+			//wait. The timeout picks that turn up instead of sleeping until the next notify
+			std::unique_lock lk(m_turnLock);
+			m_turnCV.wait_for(lk, std::chrono::milliseconds(1), [&]() { return !m_running || m_turnStateBuffer.HasNewData(); });
+		}
 
-		if (m_running)
+		if (m_running && m_turnStateBuffer.Acquire())
 		{
-			turnState = m_currentTurnInfo;
-			lk.unlock();
+			//The read buffer is ours until the next Acquire, process it in place instead of copying it again
+			m_currentTurnInfo = &m_turnStateBuffer.GetReadBuffer();
+			TurnSnapshot& turnState = *m_currentTurnInfo;
 
-			SetMapCostBasedOnAntVision(AGENT_TYPE_WORKER, m_costMapWorkers);
-			SetMapCostBasedOnAntVision(AGENT_TYPE_SCOUT, m_costMapScouts);
-			SetMapCostBasedOnAntVision(AGENT_TYPE_SOLDIER, m_costMapSoldiers);
+			//Costs and food come from what we remember of the map, the turn only adds the tiles we can see now
+			//The world model's subscribers recost the changed tiles and drop paths that became blocked
+			{
+				ScopedPhaseTimer timer(m_profiler, TURN_PHASE_COST_MAPS, threadIdx);
+				m_worldModel.MergeVisibleTiles(turnState);
+			}
 
-			SetVisionHeatMapForFood(m_foodVisionHeatMap);
+			{
+				ScopedPhaseTimer timer(m_profiler, TURN_PHASE_FOOD_INDEX, threadIdx);
+				UpdateFoodIndex();
+			}
 
 			// process a turn and then mark that the turn is ready; 
-			ProcessTurn(turnState);
+			ProcessTurn(turnState, threadIdx);
 
 			// notify the turn is ready; 
 			m_lastTurnProcessed = turnState.turnNumber;
-			m_debugInterface->LogText("Pronay's Turn Complete: %i", turnState.turnNumber);
+			m_debugInterface->LogText("Pronay's Turn Complete: %i (%.0f%% of budget)", turnState.turnNumber, m_turnScheduler.GetLastBudgetUsed() * 100.f);
+
+			double turnSeconds = TurnScheduler::GetCurrentTimeSeconds() - turnState.receivedSeconds;
+			m_profiler.Record(TURN_PHASE_TURN_LATENCY, threadIdx, (unsigned long long)(turnSeconds * 1e9));
+
+			if (TURN_PROFILE_PRINT_INTERVAL > 0 && turnState.turnNumber % TURN_PROFILE_PRINT_INTERVAL == 0)
+			{
+				m_profiler.PrintSummary("Turn Phases So Far");
+			}
 		}
 	}
 
+	//The job workers run on the other server threads and have to be out of the DLL too
+	m_jobSystem.WaitForWorkersToExit();
+
 	//This thread needs to now set the Shut Down condition as true(Not the ANT arena!)
 	gCanShutDown = true;
 	return;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+void AIPlayerController::JobThreadEntry(int threadIdx)
+{
+	m_jobSystem.WorkerThreadEntry(threadIdx);
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 // This has to finish in less than 1MS otherwise you will be faulted
+// Copies into the free turn state buffer and publishes it, nothing here can wait on the worker thread
 void AIPlayerController::ReceiveTurnState(const ArenaTurnStateForPlayer& state)
 {
-	// lock and copy information to thread
+	double receivedSeconds = TurnScheduler::GetCurrentTimeSeconds();
+
 	{
-		std::unique_lock lk(m_turnLock);
-		m_currentTurnInfo = state;
+		ScopedPhaseTimer timer(m_profiler, TURN_PHASE_TURN_COPY, PROFILER_SERVER_THREAD);
+
+		TurnSnapshot& snapshot = m_turnStateBuffer.GetWriteBuffer();
+		snapshot.CopyFrom(state);
+		snapshot.receivedSeconds = receivedSeconds;
+		m_turnStateBuffer.Publish();
 	}
 
-	// unlock, and notify
+	m_lastTurnReceivedSeconds = receivedSeconds;
+	m_lastTurnReceived = state.turnNumber;
+
+	// notify without the lock, the worker's wait times out if it misses this
 	m_turnCV.notify_one();
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
 bool AIPlayerController::TurnOrderRequest(PlayerTurnOrders* orders)
 {
-	std::unique_lock lk(m_turnLock);
-	if (m_lastTurnProcessed == m_currentTurnInfo.turnNumber)
+	int turnNumber = m_lastTurnReceived;
+
+	//Once the default orders went out they stay the turn's answer
+	if (turnNumber >= 0 && m_fallbackSentTurn == turnNumber)
+	{
+		ScopedPhaseTimer timer(m_profiler, TURN_PHASE_ORDER_PUBLISH, PROFILER_SERVER_THREAD);
+		*orders = m_fallbackOrders;
+		return true;
+	}
+
+	//The orders are complete once the worker stores the turn number it made them for
+	if (m_lastTurnProcessed == turnNumber)
 	{
+		ScopedPhaseTimer timer(m_profiler, TURN_PHASE_ORDER_PUBLISH, PROFILER_SERVER_THREAD);
 		*orders = m_turnOrders;
+		m_fullOrdersSentTurn = turnNumber;
 		return true;
 	}
-	else
+
+	//Still deciding. Close to the end of the turn the default orders beat sending none at all
+	double secondsSinceReceived = TurnScheduler::GetCurrentTimeSeconds() - m_lastTurnReceivedSeconds;
+	if (m_fallbackOrdersTurn == turnNumber && secondsSinceReceived >= m_turnScheduler.GetFallbackSeconds())
 	{
-		return false;
+		ScopedPhaseTimer timer(m_profiler, TURN_PHASE_ORDER_PUBLISH, PROFILER_SERVER_THREAD);
+		*orders = m_fallbackOrders;
+		m_fallbackSentTurn = turnNumber;
+		m_fallbacksSent++;
+		return true;
 	}
+
+	return false;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-void AIPlayerController::ProcessTurn(ArenaTurnStateForPlayer& turnState)
+void AIPlayerController::ProcessTurn(TurnSnapshot& turnState, int threadIdx)
 {
+	m_turnScheduler.BeginTurn(turnState.turnNumber, turnState.receivedSeconds);
+
 	// reset the orders
 	m_turnOrders.numberOfOrders = 0;
 
-	// for each ant I know about, give him something to do
-	int agentCount = turnState.numReports;
+	{
+		ScopedPhaseTimer timer(m_profiler, TURN_PHASE_AGENT_SYNC, threadIdx);
+
+		// Make sure we have an updated list of all the agents
+		UpdateAllAgentsFromTurnState(turnState);
 
-	// Make sure we have an updated list of all the agents
-	UpdateAllAgentsFromTurnState(turnState);
+		RemoveAnyDeadAgentsFromList();
+		m_agentStore.Build(m_agentRegistry);
 
-	RemoveAnyDeadAgentsFromList();
+		//Paths still being walked move to the other arena buffer, everything else in the old one is garbage now
+		m_pathArena.BeginTurn();
+		for (int agentIndex = 0; agentIndex < m_agentRegistry.GetNumAgents(); agentIndex++)
+		{
+			m_pathArena.CarryPath(m_agentRegistry.GetAgent(agentIndex).m_currentPath);
+		}
+
+		//Paths were stepped for orders the server never got if it took the default orders, or nothing, last turn
+		if (m_fullOrdersSentTurn != m_lastTurnProcessed)
+		{
+			ReconcilePathsWithPositions();
+		}
 
-	m_assignedTargets.clear();
+		m_assignedTargetIDs.clear();
+		m_observedAgentGrid.Build(turnState);
+	}
 
 	//Find the queen's location
 	m_queenReports[0] = *FindFirstAgentOfType(AGENT_TYPE_QUEEN);
 
 	m_moveDelay--;
-	
-	if (m_matchInfo.numTurnsBeforeSuddenDeath > turnState.turnNumber)
+
+	bool isSuddenDeath = m_matchInfo.numTurnsBeforeSuddenDeath <= turnState.turnNumber;
+
+	m_foodClaims.BeginTurn(turnState.turnNumber);
+
 	{
-		for (int i = 0; i < m_agentList.size(); ++i)
+		ScopedPhaseTimer timer(m_profiler, TURN_PHASE_QUEEN_DECISIONS, threadIdx);
+
+		//Queens change the spawn counters and the repath flag the carrying workers read, so they go first on this thread
+		m_readyAgents.clear();
+		m_agentStore.GatherReadyAgents(AGENT_TYPE_QUEEN, isSuddenDeath, m_readyAgents);
+
+		for (int i = 0; i < (int)m_readyAgents.size(); ++i)
 		{
-			Agent& report = m_agentList[i];
-			if ((report.state != STATE_DEAD) && (report.exhaustion == 0))
-			{
-				// agent is alive and ready to get an order, so do something
-				switch (report.type)
-				{
-				case AGENT_TYPE_SCOUT:
-					if (report.result == AGENT_ORDER_ERROR_MOVE_BLOCKED_BY_TILE)
-					{
-						report.m_currentPath.clear();
-						PathToFarthestVisible(report);
-					}
-					else
-					{
-						PathToFarthestVisible(report);
-					}
+			ProcessQueen(m_agentRegistry.GetAgent(m_readyAgents[i]), isSuddenDeath);
+		}
 
-					break;
-				case AGENT_TYPE_WORKER:
-				{
-					int tileIndex = GetTileIndex(report.tileX, report.tileY);
-					if (m_currentTurnInfo.observedTiles[tileIndex] == TILE_TYPE_DIRT)
-					{
-						AddOrder(report.agentID, ORDER_DIG_HERE);
-						continue;
-					}
+		CommitDefaultOrders(turnState.turnNumber, isSuddenDeath);
+	}
 
-					if (report.state == STATE_HOLDING_FOOD)
-					{
-						if (IsAgentOnQueen(report))
-						{
-							AddOrder(report.agentID, ORDER_DROP_CARRIED_OBJECT);
-						}
-						else
-						{
-							if (report.result == AGENT_ORDER_ERROR_MOVE_BLOCKED_BY_TILE)
-							{
-								//MoveRandom(report);
-								report.m_currentPath.clear();
-								PathToQueen(report, m_repathOnQueenMove);
-							}
-							else
-							{
-								PathToQueen(report, m_repathOnQueenMove);
-							}
-						}
-					}
-					else
-					{
-						int tileIdx = GetTileIndex(report.tileX, report.tileY);
-						bool tileHasFood = m_currentTurnInfo.tilesThatHaveFood[tileIdx];
-						if (tileHasFood)
-						{
-							AddOrder(report.agentID, ORDER_PICK_UP_FOOD);
-						}
-						else
-						{
-							PathToClosestFood(report);
-						}
-					}
+	//The default orders above walk last turn's flow fields. A rebuild that doesn't fit the budget keeps its change flags
+	//and runs next turn, the decisions below use the fields as they are
+	if (!m_turnScheduler.IsPastDeadline())
+	{
+		ScopedPhaseTimer timer(m_profiler, TURN_PHASE_FLOW_FIELDS, threadIdx);
+		UpdateQueenFlowField();
+		UpdateFoodFlowField();
+	}
+	else
+	{
+		m_turnScheduler.SkipTask();
+	}
 
-				}
-					break;
+	//The expensive work runs by priority until the budget is spent: food assignment, deciding each agent, then the paths
+	//they asked for. Assignment skipped this turn runs next turn, agents left over are decided first next turn
+	if (!m_turnScheduler.IsPastDeadline())
+	{
+		ScopedPhaseTimer timer(m_profiler, TURN_PHASE_FOOD_ASSIGNMENT, threadIdx);
+		AssignFoodToIdleWorkers(isSuddenDeath);
+	}
+	else
+	{
+		m_turnScheduler.SkipTask();
+	}
 
-				case AGENT_TYPE_SOLDIER:
-				{
-					if (report.result == AGENT_ORDER_ERROR_MOVE_BLOCKED_BY_TILE)
-					{
-						MoveRandom(report);
-						report.m_currentPath.clear();
-					}
-					else
-					{
-						PathToClosestEnemy(report);
-					}
-				}
-				break;
-				case AGENT_TYPE_QUEEN:
-				{
-					bool reportFound = false;
-					for (int i = 0; i < m_numQueens; i++)
-					{
-						if (m_queenReports[i].agentID == report.agentID)
-						{
-							reportFound = true;
-						}
-					}
+	// for each other ant I know about, give him something to do
+	{
+		ScopedPhaseTimer timer(m_profiler, TURN_PHASE_AGENT_DECISIONS, threadIdx);
+		ProcessAgentsInParallel(turnState.turnNumber, isSuddenDeath, threadIdx);
+		MergeAgentChunks();
+	}
 
-					if (!reportFound)
-					{
-						m_queenReports.push_back(report);
-					}
+	//Every path queued above is solved on all threads before the orders are handed to the server
+	{
+		ScopedPhaseTimer timer(m_profiler, TURN_PHASE_PATHING, threadIdx);
+		ResolveQueuedPaths(threadIdx);
+	}
 
-					if (report.receivedCombatDamage > 0)
-					{
-						eOrderCode order = (eOrderCode)(ORDER_BIRTH_SOLDIER);
-						AddOrder(report.agentID, order);
-						m_numSoldiers++;
-					}
-					else if (m_numSoldiers < MAX_SOLDIERS && m_numWorkers == MAX_WORKERS * m_numQueens&& m_currentTurnInfo.currentNutrients > MIN_NUTRIENTS_TO_SPAWN_SOLDIER)
-					{
-						eOrderCode order = (eOrderCode)(ORDER_BIRTH_SOLDIER);
-						AddOrder(report.agentID, order);
-						m_numSoldiers++;
-					}
-					else if (m_numScouts < MAX_SCOUTS && m_numSoldiers == MAX_SOLDIERS && m_numWorkers == MAX_WORKERS * m_numQueens && m_currentTurnInfo.currentNutrients > MIN_NUTRIENTS_TO_SPAWN_SCOUT)
-					{
-						eOrderCode order = (eOrderCode)(ORDER_BIRTH_SCOUT);
-						AddOrder(report.agentID, order);
-						m_numScouts++;
-					}
-					else if (m_numQueens < MAX_QUEENS && m_numScouts == MAX_SCOUTS && m_numSoldiers == MAX_SOLDIERS && m_numWorkers == MAX_WORKERS * m_numQueens && m_currentTurnInfo.currentNutrients > MIN_NUTRIENTS_TO_SPAWN_QUEEN * m_numQueens)
-					{
-						eOrderCode order = (eOrderCode)(ORDER_BIRTH_QUEEN);
-						AddOrder(report.agentID, order);
-						m_numQueens++;
-					}
-					else if (m_numWorkers < MAX_WORKERS * m_numQueens && report.exhaustion == 0 && m_currentTurnInfo.currentNutrients > MIN_NUTRIENTS_TO_SPAWN_WORKER)
-					{
-						eOrderCode order = (eOrderCode)(ORDER_BIRTH_WORKER);
-						AddOrder(report.agentID, order);
-						m_numWorkers++;
-					}
-					else
-					{
-						if (m_currentTurnInfo.currentNutrients > MIN_NUTRIENTS_TO_MOVE_QUEEN * m_numQueens && m_moveDelay <= 0)
-						{
-							MoveRandom(report);
-							m_repathOnQueenMove = true;
-							m_moveDelay = 5;
-						}
-						else
-						{
-							m_repathOnQueenMove = false;
-						}
-					}
-				}
-				break;
-				}
-			}
+	m_turnScheduler.EndTurn();
+
+	//DebugDrawVisibleFood();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Splits the agents ready for an order into chunks and decides each chunk as a job on the server threads
+// They are gathered a type at a time, so a chunk mostly holds agents running the same decision code. The order is the
+// priority when the turn runs short: agents deferred last turn, then workers, soldiers and exploring scouts last
+//------------------------------------------------------------------------------------------------------------------------------
+void AIPlayerController::ProcessAgentsInParallel(int turnNumber, bool isSuddenDeath, int threadIdx)
+{
+	m_readyAgents.clear();
+	m_agentStore.GatherReadyAgents(AGENT_TYPE_WORKER, isSuddenDeath, m_readyAgents);
+	m_agentStore.GatherReadyAgents(AGENT_TYPE_SOLDIER, isSuddenDeath, m_readyAgents);
+	m_agentStore.GatherReadyAgents(AGENT_TYPE_SCOUT, isSuddenDeath, m_readyAgents);
+
+	std::stable_partition(m_readyAgents.begin(), m_readyAgents.end(), [this](int registryIndex)
+	{
+		return m_turnScheduler.WasDeferredLastTurn(m_agentRegistry.GetAgent(registryIndex).agentID);
+	});
+
+	int numAgents = (int)m_readyAgents.size();
+	int numChunks = (numAgents + AGENT_CHUNK_SIZE - 1) / AGENT_CHUNK_SIZE;
+	m_agentChunks.resize(numChunks);
+
+	for (int chunkIndex = 0; chunkIndex < numChunks; chunkIndex++)
+	{
+		AgentChunk_T& chunk = m_agentChunks[chunkIndex];
+		chunk.firstAgentIndex = chunkIndex * AGENT_CHUNK_SIZE;
+		chunk.numAgents = numAgents - chunk.firstAgentIndex < AGENT_CHUNK_SIZE ? numAgents - chunk.firstAgentIndex : AGENT_CHUNK_SIZE;
+
+		chunk.orders.clear();
+		chunk.foodClaims.clear();
+		chunk.assignedTargetIDs.clear();
+		chunk.pathRequests.clear();
+		chunk.agentsAwaitingPaths.clear();
+		chunk.deferredAgents.clear();
+
+		//Seeded from the turn and the chunk so a chunk rolls the same numbers whichever thread runs it
+		chunk.rng.Seed((unsigned int)(turnNumber * MAX_AGENTS_PER_PLAYER + chunkIndex));
+	}
+
+	m_jobSystem.ParallelFor(numChunks, [this, isSuddenDeath](int chunkIndex, int jobThreadIdx)
+	{
+		ProcessAgentChunk(m_agentChunks[chunkIndex], isSuddenDeath, jobThreadIdx);
+	}, threadIdx);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void AIPlayerController::ProcessAgentChunk(AgentChunk_T& chunk, bool isSuddenDeath, int threadIdx)
+{
+	//Orders, claims and paths made while this is set go to the chunk instead of the controller
+	g_currentAgentChunk = &chunk;
+
+	for (int readyIndex = chunk.firstAgentIndex; readyIndex < chunk.firstAgentIndex + chunk.numAgents; readyIndex++)
+	{
+		//Out of time, the agent keeps its default order
+		if (m_turnScheduler.IsPastDeadline())
+		{
+			chunk.deferredAgents.push_back(m_readyAgents[readyIndex]);
+			continue;
+		}
+
+		Agent& agent = m_agentRegistry.GetAgent(m_readyAgents[readyIndex]);
+
+		eTurnPhase decisionPhase = TURN_PHASE_WORKER_DECISION;
+		if (agent.type == AGENT_TYPE_SOLDIER)
+		{
+			decisionPhase = TURN_PHASE_SOLDIER_DECISION;
+		}
+		else if (agent.type == AGENT_TYPE_SCOUT)
+		{
+			decisionPhase = TURN_PHASE_SCOUT_DECISION;
 		}
+
+		ScopedPhaseTimer timer(m_profiler, decisionPhase, threadIdx);
+		ProcessAgent(agent, isSuddenDeath);
 	}
-	else
+
+	g_currentAgentChunk = nullptr;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Chunk order is ready list order, so the merged orders and queued paths come out the same on any thread count
+//------------------------------------------------------------------------------------------------------------------------------
+void AIPlayerController::MergeAgentChunks()
+{
+	for (int chunkIndex = 0; chunkIndex < (int)m_agentChunks.size(); chunkIndex++)
 	{
-		int workerCounter = 0;
+		AgentChunk_T& chunk = m_agentChunks[chunkIndex];
 
-		for (int i = 0; i < m_agentList.size(); ++i)
+		for (int orderIndex = 0; orderIndex < (int)chunk.orders.size(); orderIndex++)
 		{
-			Agent& report = m_agentList[i];
-			if (report.state != STATE_DEAD)
+			AddOrder(chunk.orders[orderIndex].agentID, chunk.orders[orderIndex].order);
+		}
+
+		for (int claimIndex = 0; claimIndex < (int)chunk.foodClaims.size(); claimIndex++)
+		{
+			ClaimFood(chunk.foodClaims[claimIndex].tileIndex, chunk.foodClaims[claimIndex].agentID);
+		}
+
+		m_assignedTargetIDs.insert(chunk.assignedTargetIDs.begin(), chunk.assignedTargetIDs.end());
+
+		for (int requestIndex = 0; requestIndex < (int)chunk.pathRequests.size(); requestIndex++)
+		{
+			m_pathingService.QueuePath(chunk.pathRequests[requestIndex]);
+			m_agentsAwaitingPaths.push_back(chunk.agentsAwaitingPaths[requestIndex]);
+		}
+
+		for (int deferredIndex = 0; deferredIndex < (int)chunk.deferredAgents.size(); deferredIndex++)
+		{
+			DeferAgent(m_agentRegistry.GetAgent(chunk.deferredAgents[deferredIndex]));
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void AIPlayerController::ProcessAgent(Agent& report, bool isSuddenDeath)
+{
+	// agent is alive and ready to get an order, so do something
+	switch (report.type)
+	{
+	case AGENT_TYPE_SCOUT:
+		if (report.result == AGENT_ORDER_ERROR_MOVE_BLOCKED_BY_TILE)
+		{
+			if (!RepairPathIncrementally(report))
 			{
-				switch (report.type)
-				{
-				case AGENT_TYPE_SOLDIER:
+				report.m_currentPath.Clear();
+				PathToFarthestVisible(report);
+			}
+		}
+		else
+		{
+			PathToFarthestVisible(report);
+		}
+
+		break;
+	case AGENT_TYPE_WORKER:
+	{
+		int tileIndex = GetTileIndex(report.tileX, report.tileY);
+		if (m_currentTurnInfo->observedTiles[tileIndex] == TILE_TYPE_DIRT)
+		{
+			AddOrder(report.agentID, ORDER_DIG_HERE);
+			return;
+		}
+
+		if (report.state == STATE_HOLDING_FOOD)
+		{
+			if (IsAgentOnQueen(report))
+			{
+				AddOrder(report.agentID, ORDER_DROP_CARRIED_OBJECT);
+			}
+			else
+			{
+				if (report.result == AGENT_ORDER_ERROR_MOVE_BLOCKED_BY_TILE)
 				{
-					if (report.result == AGENT_ORDER_ERROR_MOVE_BLOCKED_BY_TILE)
+					if (!RepairPathIncrementally(report))
 					{
-						MoveRandom(report);
+						//MoveRandom(report);
+						report.m_currentPath.Clear();
+						PathToQueen(report, m_repathOnQueenMove);
 					}
-					else
-					{
-						PathToClosestEnemy(report);
-					}
-					break;
 				}
-				case AGENT_TYPE_SCOUT:
+				else
 				{
-					if (report.result == AGENT_ORDER_ERROR_MOVE_BLOCKED_BY_TILE)
-					{
-						report.m_currentPath.clear();
-						PathToFarthestVisible(report);
-					}
-					else
-					{
-						PathToFarthestVisible(report);
-					}
-					break;
+					PathToQueen(report, m_repathOnQueenMove);
 				}
-				case AGENT_TYPE_WORKER:
-				{
-					//workerCounter++;
+			}
+		}
+		else
+		{
+			int tileIdx = GetTileIndex(report.tileX, report.tileY);
+			bool tileHasFood = m_currentTurnInfo->tilesThatHaveFood[tileIdx];
+			if (tileHasFood)
+			{
+				AddOrder(report.agentID, ORDER_PICK_UP_FOOD);
+			}
+			else
+			{
+				PathToClosestFood(report);
+			}
+		}
 
-					/*
-					if (workerCounter > MAX_WORKERS_POST_SUDDEN_DEATH)
-					{
-						AddOrder(report.agentID, ORDER_SUICIDE);
-						continue;
-					}
-					*/
+	}
+		break;
 
-					int tileIndex = GetTileIndex(report.tileX, report.tileY);
-					if (m_currentTurnInfo.observedTiles[tileIndex] == TILE_TYPE_DIRT)
-					{
-						AddOrder(report.agentID, ORDER_DIG_HERE);
-						continue;
-					}
+	case AGENT_TYPE_SOLDIER:
+	{
+		if (report.result == AGENT_ORDER_ERROR_MOVE_BLOCKED_BY_TILE)
+		{
+			if (isSuddenDeath)
+			{
+				MoveRandom(report);
+			}
+			else if (!RepairPathIncrementally(report))
+			{
+				MoveRandom(report);
+				report.m_currentPath.Clear();
+			}
+		}
+		else
+		{
+			PathToClosestEnemy(report);
+		}
+	}
+	break;
 
-					if (report.state == STATE_HOLDING_FOOD)
-					{
-						if (IsAgentOnQueen(report))
-						{
-							AddOrder(report.agentID, ORDER_DROP_CARRIED_OBJECT);
-						}
-						else
-						{
-							if (report.result == AGENT_ORDER_ERROR_MOVE_BLOCKED_BY_TILE)
-							{
-								//MoveRandom(report);
-								report.m_currentPath.clear();
-								PathToQueen(report, m_repathOnQueenMove);
-							}
-							else
-							{
-								PathToQueen(report, m_repathOnQueenMove);
-							}
-						}
-					}
-					else
-					{
-						int tileIdx = GetTileIndex(report.tileX, report.tileY);
-						bool tileHasFood = m_currentTurnInfo.tilesThatHaveFood[tileIdx];
-						if (tileHasFood)
-						{
-							AddOrder(report.agentID, ORDER_PICK_UP_FOOD);
-						}
-						else
-						{
-							PathToClosestFood(report);
-						}
-					}
+	case AGENT_TYPE_QUEEN:
+	default:
+		break;
+	}
+}
 
-				}
-					break;
-					
-					/*
-					if (report.state == STATE_HOLDING_DIRT)
-					{
-						int closestEnemy = FindClosestEnemy(report);
-						if (turnState.observedAgents[closestEnemy].tileX == report.tileX && turnState.observedAgents[closestEnemy].tileY == report.tileY)
-						{
-							eOrderCode order = (eOrderCode)(ORDER_DROP_CARRIED_OBJECT);
-							AddOrder(report.agentID, order);
-						}
-						else
-						{
-							if (report.result == AGENT_ORDER_ERROR_MOVE_BLOCKED_BY_TILE)
-							{
-								MoveRandom(report);
-							}
-							else
-							{
-								PathToClosestEnemy(report);
-							}
-						}
-					}
-					else
-					{
-						IntVec2 closestDirt = FindClosestTile(report, TILE_TYPE_DIRT);
-						eTileNeighborhood dirtNeighborhood = IsPositionInNeighborhood(report, closestDirt);
-						switch (dirtNeighborhood)
-						{
-						case DIRECTION_NORTH:
-						{
-							eOrderCode order = (eOrderCode)(ORDER_DIG_NORTH);
-							AddOrder(report.agentID, order);
-						}
-						break;
-						case DIRECTION_SOUTH:
-						{
-							eOrderCode order = (eOrderCode)(ORDER_DIG_SOUTH);
-							AddOrder(report.agentID, order);
-						}
-						break;
-						case DIRECTION_EAST:
-						{
-							eOrderCode order = (eOrderCode)(ORDER_DIG_EAST);
-							AddOrder(report.agentID, order);
-						}
-						break;
-						case DIRECTION_WEST:
-						{
-							eOrderCode order = (eOrderCode)(ORDER_DIG_WEST);
-							AddOrder(report.agentID, order);
-						}
-						break;
-						case DIRECTION_THIS_TILE:
-						{
-							eOrderCode order = (eOrderCode)(ORDER_DIG_HERE);
-							AddOrder(report.agentID, order);
-						}
-						case DIRECTION_NOT_NEIGHBOR:
-						{
-							if (report.result == AGENT_ORDER_ERROR_MOVE_BLOCKED_BY_TILE)
-							{
-								MoveRandom(report);
-							}
-							else
-							{
-								PathToClosestDirt(report);
-							}
-						}
-						break;
-						}
-					}
-				*/
+//------------------------------------------------------------------------------------------------------------------------------
+void AIPlayerController::ProcessQueen(Agent& report, bool isSuddenDeath)
+{
+	if (isSuddenDeath)
+	{
+		if (report.receivedCombatDamage > 0)
+		{
+			eOrderCode order = (eOrderCode)(ORDER_BIRTH_SOLDIER);
+			AddOrder(report.agentID, order);
+			m_numSoldiers++;
+		}
 
-				case AGENT_TYPE_QUEEN:
-				{
-					if (report.receivedCombatDamage > 0)
-					{
-						eOrderCode order = (eOrderCode)(ORDER_BIRTH_SOLDIER);
-						AddOrder(report.agentID, order);
-						m_numSoldiers++;
-					}
+		return;
+	}
 
-					/*
-					if (m_queenReports.size() > 1)
-					{
-						for (int i = 1; i < m_queenReports.size(); i++)
-						{
-							if (report.agentID == m_queenReports[i].agentID)
-							{
-								eOrderCode order = (eOrderCode)(ORDER_SUICIDE);
-								AddOrder(report.agentID, order);
-								m_numQueens--;
-								m_queenReports.erase(m_queenReports.begin() + i);
-							}
-						}
-
-						return;
-					}
-					*/
+	bool reportFound = false;
+	for (int i = 0; i < m_numQueens; i++)
+	{
+		if (m_queenReports[i].agentID == report.agentID)
+		{
+			reportFound = true;
+		}
+	}
 
-					break;
-				}
-				}
-			}
+	if (!reportFound)
+	{
+		m_queenReports.push_back(report);
+	}
+
+	if (report.receivedCombatDamage > 0)
+	{
+		eOrderCode order = (eOrderCode)(ORDER_BIRTH_SOLDIER);
+		AddOrder(report.agentID, order);
+		m_numSoldiers++;
+	}
+	else if (m_numSoldiers < MAX_SOLDIERS && m_numWorkers == MAX_WORKERS * m_numQueens&& m_currentTurnInfo->currentNutrients > MIN_NUTRIENTS_TO_SPAWN_SOLDIER)
+	{
+		eOrderCode order = (eOrderCode)(ORDER_BIRTH_SOLDIER);
+		AddOrder(report.agentID, order);
+		m_numSoldiers++;
+	}
+	else if (m_numScouts < MAX_SCOUTS && m_numSoldiers == MAX_SOLDIERS && m_numWorkers == MAX_WORKERS * m_numQueens && m_currentTurnInfo->currentNutrients > MIN_NUTRIENTS_TO_SPAWN_SCOUT)
+	{
+		eOrderCode order = (eOrderCode)(ORDER_BIRTH_SCOUT);
+		AddOrder(report.agentID, order);
+		m_numScouts++;
+	}
+	else if (m_numQueens < MAX_QUEENS && m_numScouts == MAX_SCOUTS && m_numSoldiers == MAX_SOLDIERS && m_numWorkers == MAX_WORKERS * m_numQueens && m_currentTurnInfo->currentNutrients > MIN_NUTRIENTS_TO_SPAWN_QUEEN * m_numQueens)
+	{
+		eOrderCode order = (eOrderCode)(ORDER_BIRTH_QUEEN);
+		AddOrder(report.agentID, order);
+		m_numQueens++;
+	}
+	else if (m_numWorkers < MAX_WORKERS * m_numQueens && report.exhaustion == 0 && m_currentTurnInfo->currentNutrients > MIN_NUTRIENTS_TO_SPAWN_WORKER)
+	{
+		eOrderCode order = (eOrderCode)(ORDER_BIRTH_WORKER);
+		AddOrder(report.agentID, order);
+		m_numWorkers++;
+	}
+	else
+	{
+		if (m_currentTurnInfo->currentNutrients > MIN_NUTRIENTS_TO_MOVE_QUEEN * m_numQueens && m_moveDelay <= 0)
+		{
+			MoveRandom(report);
+			m_repathOnQueenMove = true;
+			m_moveDelay = 5;
+		}
+		else
+		{
+			m_repathOnQueenMove = false;
 		}
 	}
-	
+}
 
-	//DebugDrawVisibleFood();
+//------------------------------------------------------------------------------------------------------------------------------
+// Every ready agent walking a path or a flow field gets its next step, the rest hold. The queens' orders are already in
+// These go to the server if the turn runs out before the agents are decided
+//------------------------------------------------------------------------------------------------------------------------------
+void AIPlayerController::CommitDefaultOrders(int turnNumber, bool isSuddenDeath)
+{
+	int numQueenOrders = m_turnOrders.numberOfOrders;
+
+	m_readyAgents.clear();
+	m_agentStore.GatherReadyAgents(AGENT_TYPE_WORKER, isSuddenDeath, m_readyAgents);
+	m_agentStore.GatherReadyAgents(AGENT_TYPE_SOLDIER, isSuddenDeath, m_readyAgents);
+	m_agentStore.GatherReadyAgents(AGENT_TYPE_SCOUT, isSuddenDeath, m_readyAgents);
+
+	for (int readyIndex = 0; readyIndex < (int)m_readyAgents.size(); readyIndex++)
+	{
+		Agent& agent = m_agentRegistry.GetAgent(m_readyAgents[readyIndex]);
+
+		eOrderCode order = ORDER_HOLD;
+		if (GetDefaultOrder(agent, order))
+		{
+			AddOrder(agent.agentID, order);
+		}
+	}
 
+	std::copy(m_turnOrders.orders, m_turnOrders.orders + m_turnOrders.numberOfOrders, m_fallbackOrders.orders);
+	m_fallbackOrders.numberOfOrders = m_turnOrders.numberOfOrders;
+	m_fallbackOrdersTurn = turnNumber;
 
+	//Decided agents add their own orders, deferred ones get the default back in DeferAgent
+	m_turnOrders.numberOfOrders = numQueenOrders;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-void AIPlayerController::DebugDrawVisibleFood()
+// The next step of the agent's path without taking it, or for a worker off a path the flow field it would follow
+//------------------------------------------------------------------------------------------------------------------------------
+bool AIPlayerController::GetDefaultOrder(Agent& agent, eOrderCode& outOrder)
+{
+	IntVec2 agentTile = IntVec2(agent.tileX, agent.tileY);
+
+	if (!agent.m_currentPath.IsEmpty())
+	{
+		IntVec2 nextTile = agent.m_currentPath.GetNextTile();
+		if (GetManhattanDistance(nextTile, agentTile) != 1)
+			return false;
+
+		outOrder = GetMoveOrderToTile(agent, (short)nextTile.x, (short)nextTile.y);
+		return true;
+	}
+
+	if (agent.type == AGENT_TYPE_WORKER)
+	{
+		const PathSolver& flowField = agent.state == STATE_HOLDING_FOOD ? m_queenFlowField : m_foodFlowField;
+		eFlowDirection direction = flowField.GetDirection(agentTile);
+		if (direction != FLOW_DIRECTION_NONE)
+		{
+			outOrder = (eOrderCode)direction;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void AIPlayerController::IssueDefaultOrder(Agent& agent)
+{
+	eOrderCode order = ORDER_HOLD;
+	if (!GetDefaultOrder(agent, order))
+		return;
+
+	AddOrder(agent.agentID, order);
+
+	if (!agent.m_currentPath.IsEmpty())
+	{
+		m_pathArena.PopStep(agent.m_currentPath);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// The turn ran out before the agent was decided or its path was searched. It gets the default order and goes first
+// next turn
+//------------------------------------------------------------------------------------------------------------------------------
+void AIPlayerController::DeferAgent(Agent& agent)
 {
-	for (int i = 0; i < m_foodVisionHeatMap.size(); i++)
+	IssueDefaultOrder(agent);
+	m_turnScheduler.DeferAgent(agent.agentID);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Default orders don't step the path, so an agent that followed one stands on its next tile. An agent decided last turn
+// stepped its path but may not have moved, its next tile is then two away and the path is dropped
+//------------------------------------------------------------------------------------------------------------------------------
+void AIPlayerController::ReconcilePathsWithPositions()
+{
+	for (int agentIndex = 0; agentIndex < m_agentRegistry.GetNumAgents(); agentIndex++)
 	{
-		if(!m_foodVisionHeatMap[i])
+		Agent& agent = m_agentRegistry.GetAgent(agentIndex);
+		if (agent.m_currentPath.IsEmpty())
 			continue;
 
+		IntVec2 agentTile = IntVec2(agent.tileX, agent.tileY);
+		IntVec2 nextTile = agent.m_currentPath.GetNextTile();
+
+		if (nextTile == agentTile)
+		{
+			m_pathArena.PopStep(agent.m_currentPath);
+		}
+		else if (GetManhattanDistance(nextTile, agentTile) != 1)
+		{
+			agent.m_currentPath.Clear();
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void AIPlayerController::DebugDrawVisibleFood()
+{
+	const std::vector<int>& foodTiles = m_foodIndex.GetFoodTiles();
+	for (int i = 0; i < (int)foodTiles.size(); i++)
+	{
 		VertexPC vert[4];
 
 		for (int j = 0; j < 4; j++)
@@ -541,7 +798,7 @@ void AIPlayerController::DebugDrawVisibleFood()
 			vert[j].rgba.b = 0.0f;
 		}
 
-		IntVec2 coords = GetTileCoordinatesFromIndex(i);
+		IntVec2 coords = GetTileCoordinatesFromIndex(foodTiles[i]);
 
 		vert[0].x = coords.x - 0.5f;
 		vert[0].y = coords.y - 0.5f;
@@ -563,20 +820,70 @@ void AIPlayerController::DebugDrawVisibleFood()
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-short AIPlayerController::GetTileIndex(short x, short y) const
+// Rebuilds the multi-queen flow field only if a queen moved or the worker costs changed since the last build
+//------------------------------------------------------------------------------------------------------------------------------
+void AIPlayerController::UpdateQueenFlowField()
+{
+	std::vector<int> queenTiles;
+	for (int i = 0; i < (int)m_queenReports.size(); i++)
+	{
+		queenTiles.push_back(GetTileIndex(m_queenReports[i].tileX, m_queenReports[i].tileY));
+	}
+
+	if (!m_workerCostMapChanged && !m_repathOnQueenMove && queenTiles == m_queenFlowFieldSeeds)
+		return;
+
+	m_workerFlowPather.SetCostsFromCostMap(m_costMapWorkers);
+
+	m_queenFlowField.ClearEndsAndStart();
+	for (int i = 0; i < (int)queenTiles.size(); i++)
+	{
+		m_queenFlowField.AddEnd(GetTileCoordinatesFromIndex(queenTiles[i]));
+	}
+	m_queenFlowField.StartDistanceField(&m_workerFlowPather, nullptr);
+
+	m_queenFlowFieldSeeds = queenTiles;
+	m_workerCostMapChanged = false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Seeds one field from every known food tile so each idle worker can look up its closest reachable food
+// Relies on UpdateQueenFlowField having refreshed the worker costs first
+//------------------------------------------------------------------------------------------------------------------------------
+void AIPlayerController::UpdateFoodFlowField()
+{
+	m_foodFlowField.ClearEndsAndStart();
+
+	const std::vector<int>& foodTiles = m_foodIndex.GetFoodTiles();
+	for (int foodIndex = 0; foodIndex < (int)foodTiles.size(); foodIndex++)
+	{
+		m_foodFlowField.AddEnd(GetTileCoordinatesFromIndex(foodTiles[foodIndex]));
+	}
+
+	m_foodFlowField.StartDistanceField(&m_workerFlowPather, nullptr);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int AIPlayerController::GetTileIndex(short x, short y) const
 {
 	return y * m_matchInfo.mapWidth + x;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-void AIPlayerController::GetTileXYFromIndex(const short tileIndex, short &x, short&y)
+const PathArena& AIPlayerController::GetPathArena() const
+{
+	return m_pathArena;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void AIPlayerController::GetTileXYFromIndex(const int tileIndex, short &x, short&y)
 {
 	y = tileIndex / m_matchInfo.mapWidth;
 	x = tileIndex % m_matchInfo.mapWidth;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-IntVec2 AIPlayerController::GetTileCoordinatesFromIndex(const short tileIndex)
+IntVec2 AIPlayerController::GetTileCoordinatesFromIndex(const int tileIndex)
 {
 	IntVec2 tileCoords;
 	tileCoords.x = tileIndex % m_matchInfo.mapWidth;
@@ -587,7 +894,7 @@ IntVec2 AIPlayerController::GetTileCoordinatesFromIndex(const short tileIndex)
 //------------------------------------------------------------------------------------------------------------------------------
 void AIPlayerController::MoveRandom(Agent& currentAgent, int recursiveCount)
 {
-	int offset = rand() % 4;
+	int offset = GetRandomIntLessThan(4);
 
 	//eOrderCode randomDirection = PickRandomDirection();
 
@@ -612,6 +919,19 @@ void AIPlayerController::MoveRandom(Agent& currentAgent, int recursiveCount)
 	}
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+// Chunks roll their own numbers so the turn plays out the same whichever thread decided each chunk
+//------------------------------------------------------------------------------------------------------------------------------
+int AIPlayerController::GetRandomIntLessThan(int maxInt)
+{
+	if (g_currentAgentChunk != nullptr)
+	{
+		return g_currentAgentChunk->rng.GetRandomIntLessThan(maxInt);
+	}
+
+	return rand() % maxInt;
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 void AIPlayerController::AddOrder(AgentID agent, eOrderCode order)
 {
@@ -620,6 +940,16 @@ void AIPlayerController::AddOrder(AgentID agent, eOrderCode order)
 	// issued for any bad order
 	// Ants not given ordres are assumed to idle
 
+	//Agents deciding in parallel write to their chunk, MergeAgentChunks copies the orders over
+	if (g_currentAgentChunk != nullptr)
+	{
+		AgentOrder agentOrder;
+		agentOrder.agentID = agent;
+		agentOrder.order = order;
+		g_currentAgentChunk->orders.push_back(agentOrder);
+		return;
+	}
+
 	// TODO: Make sure I'm not adding too many orders
 	int agentIdx = m_turnOrders.numberOfOrders;
 
@@ -629,6 +959,92 @@ void AIPlayerController::AddOrder(AgentID agent, eOrderCode order)
 	m_turnOrders.numberOfOrders++;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+// Food stays claimed by a chunk until the merge, so workers in other chunks can still pick it this turn
+//------------------------------------------------------------------------------------------------------------------------------
+bool AIPlayerController::IsFoodAvailableTo(int tileIndex, AgentID agentID) const
+{
+	if (!m_foodIndex.HasFood(tileIndex))
+		return false;
+
+	if (m_foodClaims.IsClaimedByOther(tileIndex, agentID))
+		return false;
+
+	if (g_currentAgentChunk != nullptr)
+	{
+		std::vector<FoodClaim_T>& chunkClaims = g_currentAgentChunk->foodClaims;
+		for (int claimIndex = 0; claimIndex < (int)chunkClaims.size(); claimIndex++)
+		{
+			if (chunkClaims[claimIndex].tileIndex == tileIndex && chunkClaims[claimIndex].agentID != agentID)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void AIPlayerController::ClaimFood(int tileIndex, AgentID agentID)
+{
+	if (g_currentAgentChunk != nullptr)
+	{
+		FoodClaim_T claim;
+		claim.tileIndex = tileIndex;
+		claim.agentID = agentID;
+
+		g_currentAgentChunk->foodClaims.push_back(claim);
+		return;
+	}
+
+	m_foodClaims.Claim(tileIndex, agentID);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Every ready worker without food in its mandibles bids for food in one auction, their old claims go back in the pot
+// Claims held by workers that aren't bidding, because they are exhausted, are left alone
+//------------------------------------------------------------------------------------------------------------------------------
+void AIPlayerController::AssignFoodToIdleWorkers(bool isSuddenDeath)
+{
+	m_readyAgents.clear();
+	m_agentStore.GatherReadyAgents(AGENT_TYPE_WORKER, isSuddenDeath, m_readyAgents);
+
+	m_foodBidders.clear();
+	for (int readyIndex = 0; readyIndex < (int)m_readyAgents.size(); readyIndex++)
+	{
+		const Agent& worker = m_agentRegistry.GetAgent(m_readyAgents[readyIndex]);
+		if (worker.state == STATE_HOLDING_FOOD)
+			continue;
+
+		FoodBidder_T bidder;
+		bidder.agentID = worker.agentID;
+		bidder.tile = IntVec2(worker.tileX, worker.tileY);
+
+		IntVec2 nearestFood = m_foodFlowField.GetClosestEnd(bidder.tile);
+		if (nearestFood != IntVec2(-1, -1))
+		{
+			bidder.nearestFoodTile = GetTileIndex(nearestFood.x, nearestFood.y);
+			bidder.nearestFoodCost = m_foodFlowField.GetDistance(bidder.tile);
+		}
+
+		m_foodClaims.ReleaseAgent(worker.agentID);
+		m_foodBidders.push_back(bidder);
+	}
+
+	m_foodAuction.Solve(m_foodBidders, m_foodIndex, m_minWorkerStepCost, [this](int tileIndex)
+	{
+		return !m_foodClaims.IsClaimed(tileIndex);
+	}, m_foodAssignments);
+
+	for (int bidderIndex = 0; bidderIndex < (int)m_foodBidders.size(); bidderIndex++)
+	{
+		if (m_foodAssignments[bidderIndex] != -1)
+		{
+			m_foodClaims.Claim(m_foodAssignments[bidderIndex], m_foodBidders[bidderIndex].agentID);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
 void AIPlayerController::ReturnClosestAmong(Agent& currentAgent, short &returnX, short &returnY, short tile1X, short tile1Y, short tile2X, short tile2Y)
 {
 	//Find the closest manhattan distance among the 2 tiles
@@ -666,7 +1082,7 @@ bool AIPlayerController::CheckTileSafetyForMove(Agent& currentAgent, eOrderCode
 
 	case ORDER_MOVE_EAST:
 		index = GetTileIndex(currentAgent.tileX + 1, currentAgent.tileY);
-		if (m_currentTurnInfo.observedTiles[index] == TILE_TYPE_UNSEEN || m_currentTurnInfo.observedTiles[index] == TILE_TYPE_WATER || m_currentTurnInfo.observedTiles[index] == TILE_TYPE_STONE)
+		if (m_currentTurnInfo->observedTiles[index] == TILE_TYPE_UNSEEN || m_currentTurnInfo->observedTiles[index] == TILE_TYPE_WATER || m_currentTurnInfo->observedTiles[index] == TILE_TYPE_STONE)
 		{
 			return false;
 		}
@@ -677,7 +1093,7 @@ bool AIPlayerController::CheckTileSafetyForMove(Agent& currentAgent, eOrderCode
 		
 	case ORDER_MOVE_NORTH:
 		index = GetTileIndex(currentAgent.tileX, currentAgent.tileY + 1);
-		if (m_currentTurnInfo.observedTiles[index] == TILE_TYPE_UNSEEN || m_currentTurnInfo.observedTiles[index] == TILE_TYPE_WATER || m_currentTurnInfo.observedTiles[index] == TILE_TYPE_STONE)
+		if (m_currentTurnInfo->observedTiles[index] == TILE_TYPE_UNSEEN || m_currentTurnInfo->observedTiles[index] == TILE_TYPE_WATER || m_currentTurnInfo->observedTiles[index] == TILE_TYPE_STONE)
 		{
 			return false;
 		}
@@ -688,7 +1104,7 @@ bool AIPlayerController::CheckTileSafetyForMove(Agent& currentAgent, eOrderCode
 		
 	case ORDER_MOVE_WEST:
 		index = GetTileIndex(currentAgent.tileX - 1, currentAgent.tileY);
-		if (m_currentTurnInfo.observedTiles[index] == TILE_TYPE_UNSEEN || m_currentTurnInfo.observedTiles[index] == TILE_TYPE_WATER || m_currentTurnInfo.observedTiles[index] == TILE_TYPE_STONE)
+		if (m_currentTurnInfo->observedTiles[index] == TILE_TYPE_UNSEEN || m_currentTurnInfo->observedTiles[index] == TILE_TYPE_WATER || m_currentTurnInfo->observedTiles[index] == TILE_TYPE_STONE)
 		{
 			return false;
 		}
@@ -699,7 +1115,7 @@ bool AIPlayerController::CheckTileSafetyForMove(Agent& currentAgent, eOrderCode
 		
 	case ORDER_MOVE_SOUTH:
 		index = GetTileIndex(currentAgent.tileX, currentAgent.tileY - 1);
-		if (m_currentTurnInfo.observedTiles[index] == TILE_TYPE_UNSEEN || m_currentTurnInfo.observedTiles[index] == TILE_TYPE_WATER || m_currentTurnInfo.observedTiles[index] == TILE_TYPE_STONE)
+		if (m_currentTurnInfo->observedTiles[index] == TILE_TYPE_UNSEEN || m_currentTurnInfo->observedTiles[index] == TILE_TYPE_WATER || m_currentTurnInfo->observedTiles[index] == TILE_TYPE_STONE)
 		{
 			return false;
 		}
@@ -745,30 +1161,18 @@ void AIPlayerController::MoveToClosestFood(Agent& currentAgent, int recursiveCou
 {
 	short destX = 100;
 	short destY = 100;
-	int closestIndex = 0;
 
 	//Look for visible food
-	for (int hasFoodTileIndex = 0; hasFoodTileIndex < MAX_ARENA_TILES; hasFoodTileIndex++)
+	int closestIndex = m_foodIndex.FindNearest(IntVec2(currentAgent.tileX, currentAgent.tileY), [this, &currentAgent](int tileIndex)
 	{
-		if (m_currentTurnInfo.tilesThatHaveFood[hasFoodTileIndex])
-		{
-			short foodFoundX = 0;
-			short foodFoundY = 0;
-
-			GetTileXYFromIndex(hasFoodTileIndex, foodFoundX, foodFoundY);
+		return IsFoodAvailableTo(tileIndex, currentAgent.agentID);
+	});
 
-			short closestX = 0;
-			short closestY = 0;
-
-			ReturnClosestAmong(currentAgent, closestX, closestY, destX, destY, foodFoundX, foodFoundY);
-			if (closestX == destX && closestY == destY)
-			{
-				closestIndex = hasFoodTileIndex;
-			}
-
-			destX = closestX;
-			destY = closestY;
-		}
+	if (closestIndex != -1)
+	{
+		IntVec2 closestFood = GetTileCoordinatesFromIndex(closestIndex);
+		destX = (short)closestFood.x;
+		destY = (short)closestFood.y;
 	}
 
 	//Move towards the closest visible food
@@ -786,7 +1190,10 @@ void AIPlayerController::MoveToClosestFood(Agent& currentAgent, int recursiveCou
 			if (recursiveCount < MAX_RECURSION_ALLOWED)
 			{
 				recursiveCount++;
-				m_currentTurnInfo.tilesThatHaveFood[closestIndex] = false;
+				if (closestIndex != -1)
+				{
+					ClaimFood(closestIndex, currentAgent.agentID);
+				}
 				MoveToClosestFood(currentAgent, recursiveCount);
 			}
 			else
@@ -809,46 +1216,67 @@ void AIPlayerController::PathToClosestFood(Agent& currentAgent)
 	if (result)
 		return;
 
-	short destX = 9999;
-	short destY = 9999;
-	int closestIndex = 0;
+	//The food flow field gives the closest reachable food and the step towards it
+	IntVec2 agentTile = IntVec2(currentAgent.tileX, currentAgent.tileY);
+	IntVec2 closestFood = m_foodFlowField.GetClosestEnd(agentTile);
 
-	//Look for visible food
-	for (int hasFoodTileIndex = 0; hasFoodTileIndex < m_matchInfo.mapWidth * m_matchInfo.mapWidth; hasFoodTileIndex++)
+	//Workers that were idle at the start of the turn already won their food in the auction
+	int assignedFood = m_foodClaims.GetClaimedTile(currentAgent.agentID);
+	if (assignedFood != -1 && assignedFood != GetTileIndex(agentTile.x, agentTile.y) && IsFoodAvailableTo(assignedFood, currentAgent.agentID))
 	{
-		if (m_foodVisionHeatMap[hasFoodTileIndex])
+		if (GetTileCoordinatesFromIndex(assignedFood) == closestFood)
 		{
-			short foodFoundX = 0;
-			short foodFoundY = 0;
-
-			GetTileXYFromIndex(hasFoodTileIndex, foodFoundX, foodFoundY);
+			AddOrder(currentAgent.agentID, (eOrderCode)m_foodFlowField.GetDirection(agentTile));
+		}
+		else
+		{
+			QueuePathForAgent(currentAgent, AGENT_TYPE_WORKER, GetTileIndex(agentTile.x, agentTile.y), assignedFood);
+		}
 
-			short closestX = 0;
-			short closestY = 0;
+		return;
+	}
 
-			ReturnClosestAmong(currentAgent, closestX, closestY, destX, destY, foodFoundX, foodFoundY);
-			if (closestX == destX && closestY == destY)
-			{
-				closestIndex = hasFoodTileIndex;
-			}
+	if (closestFood != IntVec2(-1, -1))
+	{
+		int foodIndex = GetTileIndex(closestFood.x, closestFood.y);
 
-			destX = closestX;
-			destY = closestY;
+		if (closestFood == agentTile)
+		{
+			//The food we remembered here is gone
+			ClaimFood(foodIndex, currentAgent.agentID);
+		}
+		else if (IsFoodAvailableTo(foodIndex, currentAgent.agentID))
+		{
+			ClaimFood(foodIndex, currentAgent.agentID);
+			AddOrder(currentAgent.agentID, (eOrderCode)m_foodFlowField.GetDirection(agentTile));
+			return;
 		}
 	}
 
+	//Closest food is already claimed this turn, pick another one and path to it
+	short destX = 9999;
+	short destY = 9999;
+
+	int closestIndex = m_foodIndex.FindNearest(agentTile, [this, &currentAgent](int tileIndex)
+	{
+		return IsFoodAvailableTo(tileIndex, currentAgent.agentID);
+	});
+
+	if (closestIndex != -1)
+	{
+		IntVec2 closestFood = GetTileCoordinatesFromIndex(closestIndex);
+		destX = (short)closestFood.x;
+		destY = (short)closestFood.y;
+	}
+
 	int startIndex = GetTileIndex(currentAgent.tileX, currentAgent.tileY);
 	int endIndex = GetTileIndex(destX, destY);
 
 	if (destX != 9999 && endIndex >= 0)
 	{
-		m_foodVisionHeatMap[endIndex] = false;
-		
-		currentAgent.m_currentPath = m_pather.CreatePathAStar(startIndex, endIndex, IntVec2(m_matchInfo.mapWidth, m_matchInfo.mapWidth), m_costMapWorkers);
+		ClaimFood(endIndex, currentAgent.agentID);
 
-		eOrderCode order = GetMoveOrderToTile(currentAgent, currentAgent.m_currentPath.back().x, currentAgent.m_currentPath.back().y);
-		currentAgent.m_currentPath.pop_back();
-		AddOrder(currentAgent.agentID, order);
+		QueuePathForAgent(currentAgent, AGENT_TYPE_WORKER, startIndex, endIndex);
 	}
 	else
 	{
@@ -868,32 +1296,20 @@ void AIPlayerController::PathToClosestEnemy(Agent& currentAgent)
 
 	if (observedAgentID != -1)
 	{
-		ObservedAgent target = m_currentTurnInfo.observedAgents[observedAgentID];
+		ObservedAgent target = m_currentTurnInfo->observedAgents[observedAgentID];
 
-		m_assignedTargets.push_back(target);
+		AssignTarget(target);
 
 		int startIndex = GetTileIndex(currentAgent.tileX, currentAgent.tileY);
 		int endIndex = GetTileIndex(target.tileX, target.tileY);
 
-		if (currentAgent.type == AGENT_TYPE_SOLDIER)
-		{
-			currentAgent.m_currentPath = m_pather.CreatePathAStar(startIndex, endIndex, IntVec2(m_matchInfo.mapWidth, m_matchInfo.mapWidth), m_costMapSoldiers, 128);
-		}
-		else if (currentAgent.type == AGENT_TYPE_WORKER)
-		{
-			currentAgent.m_currentPath = m_pather.CreatePathAStar(startIndex, endIndex, IntVec2(m_matchInfo.mapWidth, m_matchInfo.mapWidth), m_costMapWorkers, 128);
-		}
-		
-		if (currentAgent.m_currentPath.size() != 0)
-		{
-			eOrderCode order = GetMoveOrderToTile(currentAgent, currentAgent.m_currentPath.back().x, currentAgent.m_currentPath.back().y);
-			currentAgent.m_currentPath.pop_back();
-
-			AddOrder(currentAgent.agentID, order);
+		if (currentAgent.type == AGENT_TYPE_SOLDIER)
+		{
+			QueuePathForAgent(currentAgent, AGENT_TYPE_SOLDIER, startIndex, endIndex, 128);
 		}
-		else
+		else if (currentAgent.type == AGENT_TYPE_WORKER)
 		{
-			MoveRandom(currentAgent);
+			QueuePathForAgent(currentAgent, AGENT_TYPE_WORKER, startIndex, endIndex, 128);
 		}
 	}
 	else
@@ -905,23 +1321,20 @@ void AIPlayerController::PathToClosestEnemy(Agent& currentAgent)
 //------------------------------------------------------------------------------------------------------------------------------
 void AIPlayerController::PathToFarthestVisible(Agent& currentAgent)
 {
-	bool result = currentAgent.ContinuePathIfValid();
-
 	//Find the farthest observable tile
 	IntVec2 farthestTile = GetFarthestObservedTile(currentAgent);
 
-	if (result && currentAgent.m_currentPath.size() > 0)
+	//Decided before continuing the path, continuing already issues this turn's order
+	if (!currentAgent.m_currentPath.IsEmpty() && farthestTile == currentAgent.m_currentPath.GetDestination())
 	{
-		if (farthestTile == currentAgent.m_currentPath.front())
-		{
-			//We ended up getting the same place, so just pick a random spot to path
-			farthestTile.x = (rand() % (m_matchInfo.mapWidth));
-			farthestTile.y = (rand() % (m_matchInfo.mapWidth));
-		}
-		else
-		{
-			return;
-		}
+		//We ended up getting the same place, so just pick a random spot to path
+		currentAgent.m_currentPath.Clear();
+		farthestTile.x = GetRandomIntLessThan(m_matchInfo.mapWidth);
+		farthestTile.y = GetRandomIntLessThan(m_matchInfo.mapWidth);
+	}
+	else if (currentAgent.ContinuePathIfValid())
+	{
+		return;
 	}
 
 	int startIndex = GetTileIndex(currentAgent.tileX, currentAgent.tileY);
@@ -929,12 +1342,7 @@ void AIPlayerController::PathToFarthestVisible(Agent& currentAgent)
 
 	if (endIndex >= 0)
 	{
-		currentAgent.m_currentPath = m_pather.CreatePathAStar(startIndex, endIndex, IntVec2(m_matchInfo.mapWidth, m_matchInfo.mapWidth), m_costMapScouts, 100);
-
-		eOrderCode order = GetMoveOrderToTile(currentAgent, currentAgent.m_currentPath.back().x, currentAgent.m_currentPath.back().y);
-		currentAgent.m_currentPath.pop_back();
-
-		AddOrder(currentAgent.agentID, order);
+		QueuePathForAgent(currentAgent, AGENT_TYPE_SCOUT, startIndex, endIndex, 100);
 	}
 	else
 	{
@@ -945,13 +1353,25 @@ void AIPlayerController::PathToFarthestVisible(Agent& currentAgent)
 //------------------------------------------------------------------------------------------------------------------------------
 void AIPlayerController::PathToQueen(Agent& currentAgent, bool shouldResetPath)
 {
+	//Workers just read their next step off the shared queen flow field
+	if (currentAgent.type == AGENT_TYPE_WORKER)
+	{
+		eFlowDirection direction = m_queenFlowField.GetDirection(IntVec2(currentAgent.tileX, currentAgent.tileY));
+		if (direction != FLOW_DIRECTION_NONE)
+		{
+			currentAgent.m_currentPath.Clear();
+			AddOrder(currentAgent.agentID, (eOrderCode)direction);
+			return;
+		}
+	}
+
 	bool result = currentAgent.ContinuePathIfValid();
 
 	if (shouldResetPath)
 	{
-		if (currentAgent.m_currentPath.size() > 0)
+		if (!currentAgent.m_currentPath.IsEmpty())
 		{
-			currentAgent.m_currentPath.clear();
+			currentAgent.m_currentPath.Clear();
 			result = false;
 		}
 	}
@@ -965,22 +1385,11 @@ void AIPlayerController::PathToQueen(Agent& currentAgent, bool shouldResetPath)
 
 	if (currentAgent.type == AGENT_TYPE_WORKER)
 	{
-		currentAgent.m_currentPath = m_pather.CreatePathAStar(startIndex, endIndex, IntVec2(m_matchInfo.mapWidth, m_matchInfo.mapWidth), m_costMapWorkers);
+		QueuePathForAgent(currentAgent, AGENT_TYPE_WORKER, startIndex, endIndex);
 	}
 	else if (currentAgent.type == AGENT_TYPE_SOLDIER)
 	{
-		currentAgent.m_currentPath = m_pather.CreatePathAStar(startIndex, endIndex, IntVec2(m_matchInfo.mapWidth, m_matchInfo.mapWidth), m_costMapSoldiers);
-	}
-
-	if (currentAgent.m_currentPath.size() != 0)
-	{
-		eOrderCode order = GetMoveOrderToTile(currentAgent, currentAgent.m_currentPath.back().x, currentAgent.m_currentPath.back().y);
-		currentAgent.m_currentPath.pop_back();
-		AddOrder(currentAgent.agentID, order);
-	}
-	else
-	{
-		MoveRandom(currentAgent);
+		QueuePathForAgent(currentAgent, AGENT_TYPE_SOLDIER, startIndex, endIndex);
 	}
 }
 
@@ -992,9 +1401,9 @@ void AIPlayerController::PathToClosestDirt(Agent& currentAgent)
 	int closestIndex = 0;
 
 	//Look for visible tiles
-	for (int dirtIndex = 0; dirtIndex < MAX_ARENA_TILES; dirtIndex++)
+	for (int dirtIndex = 0; dirtIndex < m_currentTurnInfo->GetNumTiles(); dirtIndex++)
 	{
-		if (m_currentTurnInfo.observedTiles[dirtIndex])
+		if (m_currentTurnInfo->observedTiles[dirtIndex])
 		{
 			short dirtFoundX = 0;
 			short dirtFoundY = 0;
@@ -1024,10 +1433,7 @@ void AIPlayerController::PathToClosestDirt(Agent& currentAgent)
 
 	if (destX != 9999)
 	{
-		currentAgent.m_currentPath = m_pather.CreatePathAStar(startIndex, endIndex, IntVec2(m_matchInfo.mapWidth, m_matchInfo.mapWidth), m_costMapWorkers);
-		eOrderCode order = GetMoveOrderToTile(currentAgent, currentAgent.m_currentPath.back().x, currentAgent.m_currentPath.back().y);
-		currentAgent.m_currentPath.pop_back();
-		AddOrder(currentAgent.agentID, order);
+		QueuePathForAgent(currentAgent, AGENT_TYPE_WORKER, startIndex, endIndex);
 	}
 	else
 	{
@@ -1042,7 +1448,7 @@ IntVec2 AIPlayerController::GetFarthestObservedTile(const Agent& currentAgent)
 	int farthestIndex = -1;
 	for (int tileIndex = 0; tileIndex < m_matchInfo.mapWidth * m_matchInfo.mapWidth; tileIndex++)
 	{
-		if (m_currentTurnInfo.observedTiles[tileIndex] != TILE_TYPE_UNSEEN && m_currentTurnInfo.observedTiles[tileIndex] != TILE_TYPE_WATER && m_currentTurnInfo.observedTiles[tileIndex] != TILE_TYPE_STONE)
+		if (m_currentTurnInfo->observedTiles[tileIndex] != TILE_TYPE_UNSEEN && m_currentTurnInfo->observedTiles[tileIndex] != TILE_TYPE_WATER && m_currentTurnInfo->observedTiles[tileIndex] != TILE_TYPE_STONE)
 		{
 			int distance = GetManhattanDistance(IntVec2(currentAgent.tileX, currentAgent.tileY), GetTileCoordinatesFromIndex(tileIndex));
 			if (distance > maxDistance)
@@ -1063,7 +1469,7 @@ IntVec2 AIPlayerController::GetFarthestUnObservedTile(const Agent& currentAgent)
 	int farthestIndex = -1;
 	for (int tileIndex = 0; tileIndex < m_matchInfo.mapWidth * m_matchInfo.mapWidth; tileIndex++)
 	{
-		if (m_currentTurnInfo.observedTiles[tileIndex] == TILE_TYPE_UNSEEN)
+		if (m_currentTurnInfo->observedTiles[tileIndex] == TILE_TYPE_UNSEEN)
 		{
 			int distance = GetManhattanDistance(IntVec2(currentAgent.tileX, currentAgent.tileY), GetTileCoordinatesFromIndex(tileIndex));
 			if (distance > maxDistance)
@@ -1080,14 +1486,14 @@ IntVec2 AIPlayerController::GetFarthestUnObservedTile(const Agent& currentAgent)
 AgentReport* AIPlayerController::FindFirstAgentOfType(eAgentType type)
 {
 	//Loop through agents and return the first agent of eAgentType type
-	int agentCount = m_currentTurnInfo.numReports;
+	int agentCount = m_currentTurnInfo->numReports;
 	AgentReport* report = nullptr;
 
 	for (int agentIndex = 0; agentIndex < agentCount; agentIndex++)
 	{
-		if (m_currentTurnInfo.agentReports[agentIndex].type == type)
+		if (m_currentTurnInfo->agentReports[agentIndex].type == type)
 		{
-			report = &m_currentTurnInfo.agentReports[agentIndex];
+			report = &m_currentTurnInfo->agentReports[agentIndex];
 			break;
 		}
 	}
@@ -1095,27 +1501,15 @@ AgentReport* AIPlayerController::FindFirstAgentOfType(eAgentType type)
 	return report;
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+// Searches the grid outward from the agent, ties still go to the lowest observed index like the full scan did
 //------------------------------------------------------------------------------------------------------------------------------
 int AIPlayerController::FindClosestEnemy(Agent& currentAgent)
 {
-	int closestDistance = 999999;
-	int closestIndex = -1;
-
-	for (int observeIndex = 0; observeIndex < m_currentTurnInfo.numObservedAgents; observeIndex++)
+	return m_observedAgentGrid.FindClosest(IntVec2(currentAgent.tileX, currentAgent.tileY), [this](int observeIndex)
 	{
-		if(IsObservedAgentInAssignedTargets(m_currentTurnInfo.observedAgents[observeIndex]))
-			continue;
-
-		//Find the closest among these guys
-		int distance = GetManhattanDistance(IntVec2(currentAgent.tileX, currentAgent.tileY), IntVec2(m_currentTurnInfo.observedAgents[observeIndex].tileX, m_currentTurnInfo.observedAgents[observeIndex].tileY));
-		if (distance < closestDistance)
-		{
-			closestIndex = observeIndex;
-			closestDistance = distance;
-		}
-	}
-
-	return closestIndex;
+		return !IsObservedAgentInAssignedTargets(m_currentTurnInfo->observedAgents[observeIndex]);
+	});
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -1126,9 +1520,9 @@ IntVec2 AIPlayerController::FindClosestTile(Agent& currentAgent, eTileType tileT
 	int closestIndex = 0;
 
 	//Look for visible tiles
-	for (int dirtIndex = 0; dirtIndex < MAX_ARENA_TILES; dirtIndex++)
+	for (int dirtIndex = 0; dirtIndex < m_currentTurnInfo->GetNumTiles(); dirtIndex++)
 	{
-		if (m_currentTurnInfo.observedTiles[dirtIndex] == tileType)
+		if (m_currentTurnInfo->observedTiles[dirtIndex] == tileType)
 		{
 			short dirtFoundX = 0;
 			short dirtFoundY = 0;
@@ -1214,43 +1608,388 @@ eTileNeighborhood AIPlayerController::IsPositionInNeighborhood(Agent& currentAge
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-void AIPlayerController::SetMapCostBasedOnAntVision(eAgentType agentType, std::vector<int>& costMap)
+// One row per agent type indexed straight by the tile type byte, TILE_TYPE_UNSEEN included, so costing a tile is a load
+//------------------------------------------------------------------------------------------------------------------------------
+void AIPlayerController::BuildTileCostTables()
 {
-	//Check what is visible in the map and set costs accordingly
-	int mapSize = m_matchInfo.mapWidth * m_matchInfo.mapWidth;
-	if (costMap.size() != mapSize)
+	for (int agentType = 0; agentType < NUM_AGENT_TYPES; agentType++)
 	{
-		costMap.resize(mapSize);
+		for (int tileType = 0; tileType < TILE_COST_TABLE_SIZE; tileType++)
+		{
+			bool isKnownTile = tileType < NUM_TILE_TYPES || tileType == TILE_TYPE_UNSEEN;
+			bool isPathingAgent = agentType == AGENT_TYPE_WORKER || agentType == AGENT_TYPE_SCOUT || agentType == AGENT_TYPE_SOLDIER;
+
+			if (isKnownTile && isPathingAgent)
+			{
+				m_tileCostTable[agentType][tileType] = GetTileCostForAgentType((eAgentType)agentType, (eTileType)tileType);
+			}
+			else
+			{
+				m_tileCostTable[agentType][tileType] = 999999;
+			}
+		}
 	}
 
-	for (int observedTileIndex = 0; observedTileIndex < mapSize; observedTileIndex++)
+	//Lower bound on a worker's cost per tile walked, the food auction estimates path costs with it
+	m_minWorkerStepCost = (float)ASTAR_IMPASSABLE_COST;
+	for (int tileType = 0; tileType < TILE_COST_TABLE_SIZE; tileType++)
 	{
-		int cost = GetTileCostForAgentType(agentType, m_currentTurnInfo.observedTiles[observedTileIndex]);
-		costMap[observedTileIndex] = cost;
+		float tileCost = (float)m_tileCostTable[AGENT_TYPE_WORKER][tileType];
+		if (tileCost < m_minWorkerStepCost)
+		{
+			m_minWorkerStepCost = tileCost;
+		}
 	}
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-void AIPlayerController::SetVisionHeatMapForFood(std::vector<bool>& visionMap)
+// Costs all three maps in one walk over the world model's tile types
+//------------------------------------------------------------------------------------------------------------------------------
+void AIPlayerController::BuildCostMapsFromWorldModel()
 {
-	//If any observed tile is food, mark it on the heatmap
+	const int* workerCosts = m_tileCostTable[AGENT_TYPE_WORKER];
+	const int* scoutCosts = m_tileCostTable[AGENT_TYPE_SCOUT];
+	const int* soldierCosts = m_tileCostTable[AGENT_TYPE_SOLDIER];
+	const eTileType* tileTypes = m_worldModel.GetTileTypes().data();
+
 	int mapSize = m_matchInfo.mapWidth * m_matchInfo.mapWidth;
-	if (visionMap.size() != mapSize)
+	m_costMapWorkers.resize(mapSize);
+	m_costMapScouts.resize(mapSize);
+	m_costMapSoldiers.resize(mapSize);
+
+	FillCostMaps(workerCosts, scoutCosts, soldierCosts, tileTypes, mapSize, m_costMapWorkers.data(), m_costMapScouts.data(), m_costMapSoldiers.data());
+
+	m_workerCostMapChanged = true;
+	m_uniformCostWorkers = AStarPather::GetUniformTileCost(m_costMapWorkers);
+	m_uniformCostScouts = AStarPather::GetUniformTileCost(m_costMapScouts);
+	m_uniformCostSoldiers = AStarPather::GetUniformTileCost(m_costMapSoldiers);
+
+	m_hierarchicalPatherScouts.UpdateCosts(m_costMapScouts);
+	m_hierarchicalPatherSoldiers.UpdateCosts(m_costMapSoldiers);
+
+	IntVec2 mapDimensions = IntVec2(m_matchInfo.mapWidth, m_matchInfo.mapWidth);
+	m_jumpPointsScouts.Build(mapDimensions, m_costMapScouts);
+	m_jumpPointsSoldiers.Build(mapDimensions, m_costMapSoldiers);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// The tables, tile types and maps never overlap. Saying so with __restrict is what lets the compiler vectorize the loop:
+// without it every store might change a table entry and the loads can't be batched. With AVX2 it becomes gathers, the
+// project's SSE2 baseline has no gather and keeps it scalar
+//------------------------------------------------------------------------------------------------------------------------------
+void AIPlayerController::FillCostMaps(const int* __restrict workerCosts, const int* __restrict scoutCosts, const int* __restrict soldierCosts,
+	const eTileType* __restrict tileTypes, int numTiles, int* __restrict workerMap, int* __restrict scoutMap, int* __restrict soldierMap)
+{
+	for (int tileIndex = 0; tileIndex < numTiles; tileIndex++)
+	{
+		unsigned char tileType = tileTypes[tileIndex];
+		workerMap[tileIndex] = workerCosts[tileType];
+		scoutMap[tileIndex] = scoutCosts[tileType];
+		soldierMap[tileIndex] = soldierCosts[tileType];
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// World model subscriber: costs only the tiles the last merge changed, in all three maps at once
+// The stores land wherever the changed tiles are, a scatter no x64 target short of AVX-512 vectorizes, so this stays a
+// scalar loop. The __restrict locals still keep the table loads from being reloaded after every store
+//------------------------------------------------------------------------------------------------------------------------------
+void AIPlayerController::UpdateCostMapsForChangedTiles(const WorldModel& worldModel)
+{
+	const int* __restrict workerCosts = m_tileCostTable[AGENT_TYPE_WORKER];
+	const int* __restrict scoutCosts = m_tileCostTable[AGENT_TYPE_SCOUT];
+	const int* __restrict soldierCosts = m_tileCostTable[AGENT_TYPE_SOLDIER];
+	const eTileType* __restrict tileTypes = worldModel.GetTileTypes().data();
+	int* __restrict workerMap = m_costMapWorkers.data();
+	int* __restrict scoutMap = m_costMapScouts.data();
+	int* __restrict soldierMap = m_costMapSoldiers.data();
+
+	bool workerCostsChanged = false;
+	bool scoutCostsChanged = false;
+	bool soldierCostsChanged = false;
+
+	const std::vector<int>& changedTiles = worldModel.GetChangedTiles();
+	for (int changeIndex = 0; changeIndex < (int)changedTiles.size(); changeIndex++)
+	{
+		int tileIndex = changedTiles[changeIndex];
+		unsigned char tileType = tileTypes[tileIndex];
+
+		workerCostsChanged |= workerMap[tileIndex] != workerCosts[tileType];
+		scoutCostsChanged |= scoutMap[tileIndex] != scoutCosts[tileType];
+		soldierCostsChanged |= soldierMap[tileIndex] != soldierCosts[tileType];
+
+		workerMap[tileIndex] = workerCosts[tileType];
+		scoutMap[tileIndex] = scoutCosts[tileType];
+		soldierMap[tileIndex] = soldierCosts[tileType];
+	}
+
+	if (workerCostsChanged)
+	{
+		m_workerCostMapChanged = true;
+		m_uniformCostWorkers = AStarPather::GetUniformTileCost(m_costMapWorkers);
+	}
+	if (scoutCostsChanged)
+	{
+		m_uniformCostScouts = AStarPather::GetUniformTileCost(m_costMapScouts);
+		m_hierarchicalPatherScouts.UpdateCosts(m_costMapScouts, changedTiles);
+		m_jumpPointsScouts.UpdateChangedTiles(m_costMapScouts, changedTiles);
+	}
+	if (soldierCostsChanged)
+	{
+		m_uniformCostSoldiers = AStarPather::GetUniformTileCost(m_costMapSoldiers);
+		m_hierarchicalPatherSoldiers.UpdateCosts(m_costMapSoldiers, changedTiles);
+		m_jumpPointsSoldiers.UpdateChangedTiles(m_costMapSoldiers, changedTiles);
+	}
+
+	if (workerCostsChanged || scoutCostsChanged || soldierCostsChanged)
+	{
+		for (int patherIndex = 0; patherIndex < (int)m_incrementalPathers.size(); patherIndex++)
+		{
+			m_incrementalPathers[patherIndex].AddChangedTiles(changedTiles);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// World model subscriber: marks any path that now steps onto a tile its agent can't cross as blocked. The path keeps its
+// destination so the agent repairs it with D* Lite when it next walks it. Only the steps in rows the merge dirtied are looked at
+//------------------------------------------------------------------------------------------------------------------------------
+void AIPlayerController::InvalidatePathsThroughChangedTiles(const WorldModel& worldModel)
+{
+	for (int agentIndex = 0; agentIndex < m_agentRegistry.GetNumAgents(); agentIndex++)
+	{
+		Agent& agent = m_agentRegistry.GetAgent(agentIndex);
+		const int* tileCosts = m_tileCostTable[agent.type];
+
+		IntVec2 step = agent.m_currentPath.GetNextTile();
+		for (int stepIndex = 0; stepIndex < agent.m_currentPath.GetNumTiles(); stepIndex++)
+		{
+			if (stepIndex > 0)
+			{
+				step += m_pathArena.GetStepOffset(agent.m_currentPath, stepIndex - 1);
+			}
+
+			if (!worldModel.IsRowDirty(step.y))
+				continue;
+
+			if (tileCosts[worldModel.GetTileType(GetTileIndex(step.x, step.y))] >= ASTAR_IMPASSABLE_COST)
+			{
+				agent.m_currentPath.isBlocked = true;
+				m_pathsInvalidated++;
+				break;
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Only the tiles the world model saw change are looked at, food out of sight stays known until we see its tile again
+// Claims on food that turned out to be gone are dropped with it
+//------------------------------------------------------------------------------------------------------------------------------
+void AIPlayerController::UpdateFoodIndex()
+{
+	const std::vector<int>& changedTiles = m_worldModel.GetChangedTiles();
+	for (int changeIndex = 0; changeIndex < (int)changedTiles.size(); changeIndex++)
+	{
+		int tileIndex = changedTiles[changeIndex];
+		if (m_worldModel.HasFood(tileIndex))
+		{
+			m_foodIndex.Add(tileIndex);
+		}
+		else
+		{
+			m_foodIndex.Remove(tileIndex);
+			m_foodClaims.ReleaseTile(tileIndex);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Scouts and soldiers also hand over their cluster graph so long trips are not cut short by the A* limit
+//------------------------------------------------------------------------------------------------------------------------------
+PathRequest_T AIPlayerController::MakePathRequest(eAgentType agentType, int startIndex, int endIndex, int limit) const
+{
+	PathRequest_T request;
+	request.startTileIndex = startIndex;
+	request.endTileIndex = endIndex;
+	request.limit = limit;
+	request.tileCosts = &GetCostMapForAgentType(agentType);
+
+	switch (agentType)
+	{
+	case AGENT_TYPE_SCOUT:
+		request.uniformTileCost = m_uniformCostScouts;
+		request.hierarchicalPather = &m_hierarchicalPatherScouts;
+		request.jumpPointTable = &m_jumpPointsScouts;
+		break;
+	case AGENT_TYPE_SOLDIER:
+		request.uniformTileCost = m_uniformCostSoldiers;
+		request.hierarchicalPather = &m_hierarchicalPatherSoldiers;
+		request.jumpPointTable = &m_jumpPointsSoldiers;
+		break;
+	default:
+		request.uniformTileCost = m_uniformCostWorkers;
+		break;
+	}
+
+	return request;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// The path is solved with the rest of the turn's paths in ResolveQueuedPaths, which also issues the agent's move
+//------------------------------------------------------------------------------------------------------------------------------
+void AIPlayerController::QueuePathForAgent(Agent& currentAgent, eAgentType agentType, int startIndex, int endIndex, int limit)
+{
+	if (g_currentAgentChunk != nullptr)
+	{
+		g_currentAgentChunk->pathRequests.push_back(MakePathRequest(agentType, startIndex, endIndex, limit));
+		g_currentAgentChunk->agentsAwaitingPaths.push_back(&currentAgent);
+		return;
+	}
+
+	m_pathingService.QueuePath(MakePathRequest(agentType, startIndex, endIndex, limit));
+	m_agentsAwaitingPaths.push_back(&currentAgent);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Solves every queued path on all the server threads, then walks the results in queue order so orders stay deterministic
+//------------------------------------------------------------------------------------------------------------------------------
+void AIPlayerController::ResolveQueuedPaths(int threadIdx)
+{
+	m_pathingService.ProcessRequests(m_jobSystem, threadIdx, &m_turnScheduler);
+
+	for (int requestIndex = 0; requestIndex < (int)m_agentsAwaitingPaths.size(); requestIndex++)
+	{
+		Agent& currentAgent = *m_agentsAwaitingPaths[requestIndex];
+
+		if (!m_pathingService.IsSolved(requestIndex))
+		{
+			DeferAgent(currentAgent);
+			continue;
+		}
+
+		currentAgent.m_currentPath = m_pathArena.WritePath(m_pathingService.GetResult(requestIndex));
+
+		if (!currentAgent.m_currentPath.IsEmpty())
+		{
+			eOrderCode order = GetMoveOrderToTile(currentAgent, currentAgent.m_currentPath.nextX, currentAgent.m_currentPath.nextY);
+			m_pathArena.PopStep(currentAgent.m_currentPath);
+			AddOrder(currentAgent.agentID, order);
+		}
+		else
+		{
+			MoveRandom(currentAgent);
+		}
+	}
+
+	m_pathingService.ClearRequests();
+	m_agentsAwaitingPaths.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const std::vector<int>& AIPlayerController::GetCostMapForAgentType(eAgentType agentType) const
+{
+	switch (agentType)
 	{
-		visionMap.resize(mapSize);
+	case AGENT_TYPE_SCOUT:
+		return m_costMapScouts;
+	case AGENT_TYPE_SOLDIER:
+		return m_costMapSoldiers;
+	default:
+		return m_costMapWorkers;
 	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Hands out the pather this agent used last, or the least recently used free one if it has none
+// Returns nullptr when every pather is being searched with by another chunk
+//------------------------------------------------------------------------------------------------------------------------------
+DStarLitePather* AIPlayerController::AcquireIncrementalPather(int agentID)
+{
+	std::unique_lock lk(m_incrementalPatherLock);
 
-	for (int observedTileIndex = 0; observedTileIndex < mapSize; observedTileIndex++)
+	int leastRecentIndex = -1;
+	for (int patherIndex = 0; patherIndex < (int)m_incrementalPathers.size(); patherIndex++)
 	{
-		if (m_currentTurnInfo.tilesThatHaveFood[observedTileIndex] == true)
+		DStarLitePather& pather = m_incrementalPathers[patherIndex];
+		if (pather.m_isInUse)
+			continue;
+
+		if (pather.m_ownerID == agentID)
+		{
+			pather.m_isInUse = true;
+			return &pather;
+		}
+
+		if (leastRecentIndex == -1 || pather.m_lastUsedTurn < m_incrementalPathers[leastRecentIndex].m_lastUsedTurn)
 		{
-			visionMap[observedTileIndex] = true;
+			leastRecentIndex = patherIndex;
 		}
 	}
+
+	if (leastRecentIndex == -1)
+		return nullptr;
+
+	DStarLitePather& pather = m_incrementalPathers[leastRecentIndex];
+	if (!pather.IsInitialized())
+	{
+		pather.Init(IntVec2(m_matchInfo.mapWidth, m_matchInfo.mapWidth));
+	}
+	else
+	{
+		pather.Reset();
+	}
+
+	pather.m_ownerID = agentID;
+	pather.m_isInUse = true;
+	return &pather;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void AIPlayerController::ReleaseIncrementalPather(DStarLitePather& pather)
+{
+	std::unique_lock lk(m_incrementalPatherLock);
+	pather.m_isInUse = false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Repairs the agent's path to its current destination with D* Lite instead of searching from scratch
+// Returns false if the agent has no destination or it can't be reached, callers then fall back to a fresh path
+// The pool lock is only held to pick a pather, so repairs in different chunks search at the same time
+//------------------------------------------------------------------------------------------------------------------------------
+bool AIPlayerController::RepairPathIncrementally(Agent& currentAgent)
+{
+	if (currentAgent.m_currentPath.IsEmpty())
+		return false;
+
+	IntVec2 destination = currentAgent.m_currentPath.GetDestination();
+	int startIndex = GetTileIndex(currentAgent.tileX, currentAgent.tileY);
+	int endIndex = GetTileIndex(destination.x, destination.y);
+
+	DStarLitePather* pather = AcquireIncrementalPather(currentAgent.agentID);
+	if (pather == nullptr)
+		return false;
+
+	pather->m_lastUsedTurn = m_currentTurnInfo->turnNumber;
+	Path path = pather->CreatePath(startIndex, endIndex, GetCostMapForAgentType(currentAgent.type));
+	ReleaseIncrementalPather(*pather);
+
+	if (path.size() == 0)
+		return false;
+
+	currentAgent.m_currentPath = m_pathArena.WritePath(path);
+	if (currentAgent.m_currentPath.IsEmpty())
+		return false;
+
+	eOrderCode order = GetMoveOrderToTile(currentAgent, currentAgent.m_currentPath.nextX, currentAgent.m_currentPath.nextY);
+	m_pathArena.PopStep(currentAgent.m_currentPath);
+
+	AddOrder(currentAgent.agentID, order);
+	return true;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-int AIPlayerController::GetTileCostForAgentType(eAgentType agentType, eTileType tileType)
+STATIC int AIPlayerController::GetTileCostForAgentType(eAgentType agentType, eTileType tileType)
 {
 	switch (agentType)
 	{
@@ -1438,6 +2177,13 @@ bool AIPlayerController::IsThisAgentQueen(Agent& report)
 //------------------------------------------------------------------------------------------------------------------------------
 int AIPlayerController::GetClosestQueenTileIndex(Agent& agentReport)
 {
+	//The queen flow field already knows which queen every reachable tile drains to
+	IntVec2 closestQueenTile = m_queenFlowField.GetClosestEnd(IntVec2(agentReport.tileX, agentReport.tileY));
+	if (closestQueenTile != IntVec2(-1, -1))
+	{
+		return GetTileIndex(closestQueenTile.x, closestQueenTile.y);
+	}
+
 	int closestDistance = 99999;
 	int closestIndex = 0;
 	for (int i = 0; i < m_queenReports.size(); i++)
@@ -1488,21 +2234,33 @@ int AIPlayerController::IsEnemyInNeighborhood(int closestEnemy, Agent& report)
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-bool AIPlayerController::IsObservedAgentInAssignedTargets(ObservedAgent observedAgents)
+bool AIPlayerController::IsObservedAgentInAssignedTargets(const ObservedAgent& observedAgent)
 {
-	std::vector<ObservedAgent>::iterator itr = m_assignedTargets.begin();
-
-	while (itr != m_assignedTargets.end())
+	//A chunk only sees its own targets until the merge
+	if (g_currentAgentChunk != nullptr)
 	{
-		if (observedAgents.agentID == itr->agentID)
+		for (int targetIndex = 0; targetIndex < (int)g_currentAgentChunk->assignedTargetIDs.size(); targetIndex++)
 		{
-			return true;
+			if (observedAgent.agentID == g_currentAgentChunk->assignedTargetIDs[targetIndex])
+			{
+				return true;
+			}
 		}
+	}
+
+	return m_assignedTargetIDs.find(observedAgent.agentID) != m_assignedTargetIDs.end();
+}
 
-		itr++;
+//------------------------------------------------------------------------------------------------------------------------------
+void AIPlayerController::AssignTarget(const ObservedAgent& target)
+{
+	if (g_currentAgentChunk != nullptr)
+	{
+		g_currentAgentChunk->assignedTargetIDs.push_back(target.agentID);
+		return;
 	}
 
-	return false;
+	m_assignedTargetIDs.insert(target.agentID);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -1523,11 +2281,13 @@ bool AIPlayerController::IsAgentOnQueen(Agent& report)
 void AIPlayerController::RemoveAnyDeadAgentsFromList()
 {
 	//Check if there are any dead agents in the list and get rid of them
-	for (int i = 0; i < m_agentList.size(); i++)
+	//Walks backwards so the agent swapped into a removed one's place has already been checked
+	for (int i = m_agentRegistry.GetNumAgents() - 1; i >= 0; i--)
 	{
-		if (m_agentList[i].state == STATE_DEAD)
+		Agent& agent = m_agentRegistry.GetAgent(i);
+		if (agent.state == STATE_DEAD)
 		{
-			switch (m_agentList[i].type)
+			switch (agent.type)
 			{
 			case AGENT_TYPE_WORKER:
 				m_numWorkers--;
@@ -1543,8 +2303,7 @@ void AIPlayerController::RemoveAnyDeadAgentsFromList()
 				break;
 			}
 
-			m_agentList.erase(m_agentList.begin() + i);
-			i--;
+			m_agentRegistry.Remove(agent.agentID);
 		}
 	}
 }
@@ -1553,50 +2312,42 @@ void AIPlayerController::RemoveAnyDeadAgentsFromList()
 void AIPlayerController::CheckAndAddAgentsToList(const AgentReport& agentReport)
 {
 	//Check if the agent is in list, if not create new agent and add to the list
-	std::vector<Agent>::iterator agentIter = m_agentList.begin();
+	Agent* agent = m_agentRegistry.Find(agentReport.agentID);
 
-	while (agentIter != m_agentList.end())
+	if (agent == nullptr)
 	{
-		if (agentIter->agentID == agentReport.agentID)
-		{
-			//Agent is in the list
-
-			if (agentIter->state == STATE_DEAD) 
-			{
-				switch (agentIter->type)
-				{
-				case AGENT_TYPE_SOLDIER:
-					m_numSoldiers--;
-					break;
-				case AGENT_TYPE_SCOUT:
-					m_numScouts--;
-					break;
-				case AGENT_TYPE_QUEEN:
-					m_numQueens--;
-					break;
-				case AGENT_TYPE_WORKER:
-					m_numWorkers--;
-					break;
-				}
+		CreateAgentFromReport(agentReport);
+		return;
+	}
 
-				m_agentList.erase(agentIter);
-				return;
-			}
-			else
-			{
-				agentIter->UpdateAgentData(agentReport);
-				return;
-			}
+	if (agent->state == STATE_DEAD) 
+	{
+		switch (agent->type)
+		{
+		case AGENT_TYPE_SOLDIER:
+			m_numSoldiers--;
+			break;
+		case AGENT_TYPE_SCOUT:
+			m_numScouts--;
+			break;
+		case AGENT_TYPE_QUEEN:
+			m_numQueens--;
+			break;
+		case AGENT_TYPE_WORKER:
+			m_numWorkers--;
+			break;
 		}
-		agentIter++;
+
+		m_agentRegistry.Remove(agentReport.agentID);
+		return;
 	}
 
-	CreateAgentFromReport(agentReport);
+	agent->UpdateAgentData(agentReport);
 }
 
 
 //------------------------------------------------------------------------------------------------------------------------------
-void AIPlayerController::UpdateAllAgentsFromTurnState(ArenaTurnStateForPlayer& turnState)
+void AIPlayerController::UpdateAllAgentsFromTurnState(TurnSnapshot& turnState)
 {
 	m_queenReports.clear();
 	m_numWorkers = 0;
@@ -1627,14 +2378,11 @@ void AIPlayerController::UpdateAllAgentsFromTurnState(ArenaTurnStateForPlayer& t
 			break;
 		}
 	}
-
-	int numInList = m_agentList.size();
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
 void AIPlayerController::CreateAgentFromReport(const AgentReport& agentReport)
 {
-	//Make a new agent and add it to the report
-	Agent agent = Agent(agentReport);
-	m_agentList.push_back(agent);
+	//Make a new agent and add it to the registry
+	m_agentRegistry.Add(agentReport);
 }
\ No newline at end of file
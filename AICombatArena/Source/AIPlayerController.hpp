@@ -1,10 +1,30 @@
 #pragma once
 #include "ArenaPlayerInterface.hpp"
 #include "AStarPathing.hpp"
+#include "Pathing.hpp"
+#include "HierarchicalPathing.hpp"
+#include "IncrementalPathing.hpp"
+#include "PathingService.hpp"
+#include "JobSystem.hpp"
+#include "TurnScheduler.hpp"
+#include "TurnProfiler.hpp"
+#include "RandomNumberGenerator.hpp"
+#include "TripleBuffer.hpp"
+#include "TurnSnapshot.hpp"
+#include "WorldModel.hpp"
+#include "ObservedAgentGrid.hpp"
+#include "FoodIndex.hpp"
+#include "FoodClaimTable.hpp"
+#include "FoodAuction.hpp"
 #include "Agent.hpp"
+#include "AgentRegistry.hpp"
+#include "AgentStore.hpp"
 #include <mutex>
 #include <atomic>
 #include <map>
+#include <unordered_set>
+
+constexpr int TILE_COST_TABLE_SIZE = 256;	//Every value an eTileType byte can hold, TILE_TYPE_UNSEEN is 0xff
 
 enum eTileNeighborhood
 {
@@ -16,6 +36,24 @@ enum eTileNeighborhood
 	DIRECTION_THIS_TILE
 };
 
+//------------------------------------------------------------------------------------------------------------------------------
+// Everything a run of agents writes while deciding in parallel. Merged into the controller in chunk order once every
+// chunk is done, so the turn's orders don't depend on which thread ran which chunk
+struct AgentChunk_T
+{
+	int							firstAgentIndex = 0;
+	int							numAgents = 0;
+
+	std::vector<AgentOrder>		orders;
+	std::vector<FoodClaim_T>	foodClaims;
+	std::vector<AgentID>		assignedTargetIDs;
+	std::vector<PathRequest_T>	pathRequests;
+	std::vector<Agent*>			agentsAwaitingPaths;	//Same order as pathRequests
+	std::vector<int>			deferredAgents;			//Registry indices of the agents the turn had no time for
+
+	RandomNumberGenerator		rng;
+};
+
 //------------------------------------------------------------------------------------------------------------------------------
 class AIPlayerController
 {
@@ -31,36 +69,59 @@ public:
 
 	void				MainThreadEntry(int threadIdx);
 	void				WorkerThreadEntry(int threadIdx);
+	void				JobThreadEntry(int threadIdx);
 
 	void				ReceiveTurnState(const ArenaTurnStateForPlayer& state);
 	bool				TurnOrderRequest(PlayerTurnOrders* orders);
 
-	void				SetMapCostBasedOnAntVision(eAgentType agentType, std::vector<int>& costMap);
 
-	void				SetVisionHeatMapForFood(std::vector<bool>& visionMap);
+	void				UpdateFoodIndex();
 	void				AddOrder(AgentID agent, eOrderCode order);
+	bool				IsFoodAvailableTo(int tileIndex, AgentID agentID) const;	//Known food nobody else has claimed
+	void				ClaimFood(int tileIndex, AgentID agentID);
 	void				ReturnClosestAmong(Agent& currentAgent, short &returnX, short &returnY, short tile1X, short tile1Y, short tile2X, short tile2Y);
 	bool				CheckTileSafetyForMove(Agent& currentAgent, eOrderCode order);
 	eOrderCode			GetMoveOrderToTile(Agent& currentAgent, short destPosX, short destPosY);
 
-	short				GetTileIndex(short x, short y) const;
-	void				GetTileXYFromIndex(const short tileIndex, short &x, short&y);
-	IntVec2				GetTileCoordinatesFromIndex(const short tileIndex);
+	int					GetTileIndex(short x, short y) const;
+	const PathArena&	GetPathArena() const;
+	void				GetTileXYFromIndex(const int tileIndex, short &x, short&y);
+	IntVec2				GetTileCoordinatesFromIndex(const int tileIndex);
 
 	bool				IsAgentOnQueen(Agent& report);
+	bool				RepairPathIncrementally(Agent& currentAgent);
 
-private:
-	void				ProcessTurn(ArenaTurnStateForPlayer& turnState);
+	static int			GetTileCostForAgentType(eAgentType agentType, eTileType tileType);	//Also costs the pathing benchmark's maps
+	static void			FillCostMaps(const int* __restrict workerCosts, const int* __restrict scoutCosts, const int* __restrict soldierCosts,
+							const eTileType* __restrict tileTypes, int numTiles,
+							int* __restrict workerMap, int* __restrict scoutMap, int* __restrict soldierMap);	//Also timed by the pathing benchmark
 
+private:
+	void				ProcessTurn(TurnSnapshot& turnState, int threadIdx);
+	void				ProcessAgentsInParallel(int turnNumber, bool isSuddenDeath, int threadIdx);
+	void				ProcessAgentChunk(AgentChunk_T& chunk, bool isSuddenDeath, int threadIdx);
+	void				MergeAgentChunks();
+	void				ProcessAgent(Agent& report, bool isSuddenDeath);
+	void				ProcessQueen(Agent& report, bool isSuddenDeath);
+
+	void				CommitDefaultOrders(int turnNumber, bool isSuddenDeath);
+	bool				GetDefaultOrder(Agent& agent, eOrderCode& outOrder);
+	void				IssueDefaultOrder(Agent& agent);
+	void				DeferAgent(Agent& agent);
+	void				ReconcilePathsWithPositions();
 
 	void				DebugDrawVisibleFood();
-	void				UpdateAllAgentsFromTurnState(ArenaTurnStateForPlayer& turnState);
+	void				UpdateQueenFlowField();
+	void				UpdateFoodFlowField();
+	void				AssignFoodToIdleWorkers(bool isSuddenDeath);
+	void				UpdateAllAgentsFromTurnState(TurnSnapshot& turnState);
 	void				CreateAgentFromReport(const AgentReport& agentReport);
 	void				CheckAndAddAgentsToList(const AgentReport& agentReports);
 	void				RemoveAnyDeadAgentsFromList();
 
 	// Helpers
 	void				MoveRandom(Agent& currentAgent, int recursiveCount = 0);
+	int					GetRandomIntLessThan(int maxInt);
 	
 
 	void				MoveToQueen(Agent& currentAgent, int recursiveCount = 0);
@@ -80,7 +141,16 @@ private:
 	eTileNeighborhood	IsPositionInNeighborhood(Agent& currentAgent, IntVec2 position);
 
 	//Pathing
-	int					GetTileCostForAgentType(eAgentType agentType, eTileType tileType);
+	PathRequest_T		MakePathRequest(eAgentType agentType, int startIndex, int endIndex, int limit = 256) const;
+	void				QueuePathForAgent(Agent& currentAgent, eAgentType agentType, int startIndex, int endIndex, int limit = 256);
+	void				ResolveQueuedPaths(int threadIdx);
+	const std::vector<int>&	GetCostMapForAgentType(eAgentType agentType) const;
+	DStarLitePather*	AcquireIncrementalPather(int agentID);
+	void				ReleaseIncrementalPather(DStarLitePather& pather);
+	void				BuildTileCostTables();
+	void				BuildCostMapsFromWorldModel();
+	void				UpdateCostMapsForChangedTiles(const WorldModel& worldModel);
+	void				InvalidatePathsThroughChangedTiles(const WorldModel& worldModel);
 	bool				IsTileSafeForAgentType(eTileType tileType, eAgentType agentType);
 	bool				IsTileSafeForQueen(eTileType tileType);
 	bool				IsTileSafeForScout(eTileType tileType);
@@ -91,26 +161,72 @@ private:
 	int					GetClosestQueenTileIndex(Agent& report);
 	int					IsEnemyInNeighborhood(int closestEnemy, Agent& report);
 
-	bool				IsObservedAgentInAssignedTargets(ObservedAgent observedAgents);
+	bool				IsObservedAgentInAssignedTargets(const ObservedAgent& observedAgent);
+	void				AssignTarget(const ObservedAgent& target);
 private:
 	MatchInfo m_matchInfo;
 	DebugInterface* m_debugInterface;
 
-	int m_lastTurnProcessed;
+	std::atomic<int> m_lastTurnProcessed = -1;
+	std::atomic<int> m_lastTurnReceived = -1;
 	volatile bool m_running;
 
 	std::mutex m_turnLock;
 	std::condition_variable m_turnCV;
 
-	ArenaTurnStateForPlayer m_currentTurnInfo;
+	// Each turn commits cheap default orders first and spends what is left of its budget refining them
+	// The server thread hands over the default orders if the turn runs out before the full ones are ready
+	TurnScheduler				m_turnScheduler;
+	PlayerTurnOrders			m_fallbackOrders;
+	std::atomic<int>			m_fallbackOrdersTurn = -1;		//Turn m_fallbackOrders were made for
+	std::atomic<int>			m_fallbackSentTurn = -1;
+	std::atomic<int>			m_fullOrdersSentTurn = -1;
+	std::atomic<double>			m_lastTurnReceivedSeconds = 0.0;
+	int							m_fallbacksSent = 0;
+
+	// Every phase of the turn is timed into a histogram per thread
+	TurnProfiler				m_profiler;
+
+	// Turn states handed over by the server thread without a lock, m_currentTurnInfo is the one being processed
+	TripleBuffer<TurnSnapshot>	m_turnStateBuffer;
+	TurnSnapshot*				m_currentTurnInfo = nullptr;
+
+	// Every tile we have seen, the cost maps and food heatmap are built from this rather than this turn's vision
+	WorldModel					m_worldModel;
+	int							m_pathsInvalidated = 0;
 	PlayerTurnOrders m_turnOrders;
 
 	std::vector<AgentReport> m_queenReports;
 
-	AStarPather m_pather;
-
-	std::vector<Agent>	m_agentList;
-	std::vector<ObservedAgent> m_assignedTargets;
+	// Per-agent decisions and the turn's paths run as jobs on every server thread
+	JobSystem					m_jobSystem;
+	std::vector<AgentChunk_T>	m_agentChunks;
+
+	// Paths queued while processing the turn, solved on every server thread with a pather per thread
+	PathingService		m_pathingService;
+	std::vector<Agent*>	m_agentsAwaitingPaths;	//Same order as the requests in m_pathingService
+	PathArena			m_pathArena;			//Every agent's m_currentPath points in here
+
+	// Cluster graphs for the scout and soldier cost maps, used for queries longer than a cluster
+	HierarchicalPather	m_hierarchicalPatherScouts;
+	HierarchicalPather	m_hierarchicalPatherSoldiers;
+
+	// D* Lite state kept between turns so blocked agents repair their path instead of replanning from scratch
+	std::vector<DStarLitePather>	m_incrementalPathers;
+	std::mutex						m_incrementalPatherLock;	//Guards handing pathers out of the pool, not the searches
+
+	// Shared fields every worker follows, to its closest queen when carrying food and to its closest food otherwise
+	Pather				m_workerFlowPather;
+	PathSolver			m_queenFlowField;
+	PathSolver			m_foodFlowField;
+	std::vector<int>	m_queenFlowFieldSeeds;	//Queen tile indices the field was last built from
+	bool				m_workerCostMapChanged = true;
+
+	AgentRegistry		m_agentRegistry;		//Our agents by AgentID, iterate with GetNumAgents and GetAgent
+	AgentStore			m_agentStore;			//This turn's agents by type, rebuilt after the registry is synced
+	std::vector<int>	m_readyAgents;			//Registry indices of the agents being decided this turn
+	std::unordered_set<AgentID> m_assignedTargetIDs;
+	ObservedAgentGrid	m_observedAgentGrid;		//This turn's observed agents bucketed by map cell
 	int lastAgent = 6;
 
 	std::vector<int>	m_scoutDestinations;
@@ -130,9 +246,28 @@ public:
 	std::vector<int>	m_costMapSoldiers;
 	std::vector<int>	m_costMapScouts;
 
-	std::vector<bool>	m_foodVisionHeatMap;
+	// GetTileCostForAgentType flattened into a lookup per agent type, indexed by the tile type byte
+	int		m_tileCostTable[NUM_AGENT_TYPES][TILE_COST_TABLE_SIZE];
+
+	// Cost shared by every passable tile in each cost map, -1 when not uniform (Jump Point Search needs it)
+	int		m_uniformCostWorkers = -1;
+	int		m_uniformCostSoldiers = -1;
+	int		m_uniformCostScouts = -1;
+
+	// JPS+ jump distances for the maps that are uniform, kept up to date with the cost maps
+	JumpPointTable		m_jumpPointsScouts;
+	JumpPointTable		m_jumpPointsSoldiers;
+
+	FoodIndex			m_foodIndex;			//Every food tile we know of
+	FoodClaimTable		m_foodClaims;
+
+	// Idle workers are matched to food once per turn before anyone decides
+	FoodAuction					m_foodAuction;
+	std::vector<FoodBidder_T>	m_foodBidders;
+	std::vector<int>			m_foodAssignments;		//Food tile won by each bidder, -1 if none
+	float						m_minWorkerStepCost = 1.f;
 
-	std::map<int, Agent*> m_scoutPositionMap;
+	std::map<int, AgentHandle_T> m_scoutPositionMap;
 
 	int			m_numWorkers = 0;
 	int			m_numSoldiers = 0;
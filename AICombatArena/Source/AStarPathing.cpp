@@ -1,22 +1,99 @@
 #include "AStarPathing.hpp"
 #include "MathUtils.hpp"
 #include "ErrorWarningAssert.hpp"
+#include "AICommons.hpp"
+#include <cstdlib>
 
-Path AStarPather::CreatePathAStar(int startTileIndex, int endTileIndex, IntVec2 mapDimensions, const std::vector<int>& tileCosts, int limit)
+//------------------------------------------------------------------------------------------------------------------------------
+bool AStarPriority_T::operator<(const AStarPriority_T& compare) const
 {
-	// m_pathInfo lives on Pather. It is the current std::vector<PathInfo>
+	if (fCost != compare.fCost)
+	{
+		return fCost < compare.fCost;
+	}
+
+	return hCost < compare.hCost;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Sizes the search buffers once for the match, searches reuse them through the generation stamp
+//------------------------------------------------------------------------------------------------------------------------------
+void AStarPather::Init(const IntVec2& mapDimensions)
+{
+	int mapSize = mapDimensions.x * mapDimensions.y;
 
 	m_pathInfo.clear();
-	m_pathInfo.resize(mapDimensions.x * mapDimensions.y);
+	m_pathInfo.resize(mapSize);
+	m_searchGeneration = 0;
+
+	m_openList.Init(mapSize);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void AStarPather::StartNewSearch()
+{
+	m_searchGeneration++;
 
-	CalculateCostsForTileIndex(startTileIndex, endTileIndex, mapDimensions, tileCosts, true);
+	if (m_searchGeneration == 0)
+	{
+		//The stamp wrapped around, so old entries could look current. Wipe them once and start over
+		for (int tileIndex = 0; tileIndex < (int)m_pathInfo.size(); tileIndex++)
+		{
+			m_pathInfo[tileIndex].searchGeneration = 0;
+		}
+
+		m_searchGeneration = 1;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+AStarPathInfo_T& AStarPather::GetPathInfo(const int tileIndex)
+{
+	AStarPathInfo_T& tileInfo = m_pathInfo[tileIndex];
+
+	if (tileInfo.searchGeneration != m_searchGeneration)
+	{
+		tileInfo = AStarPathInfo_T();
+		tileInfo.searchGeneration = m_searchGeneration;
+	}
+
+	return tileInfo;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Picks Jump Point Search when every passable tile costs the same, plain A* otherwise
+// The jump point table is optional, it has to have been built from tileCosts' walls
+//------------------------------------------------------------------------------------------------------------------------------
+Path AStarPather::CreatePath(int startTileIndex, int endTileIndex, IntVec2 mapDimensions, const std::vector<int>& tileCosts, int uniformTileCost, int limit, const JumpPointTable* jumpPointTable)
+{
+	if (uniformTileCost > 0)
+	{
+		if (jumpPointTable != nullptr && !jumpPointTable->IsBuiltFor(mapDimensions))
+		{
+			jumpPointTable = nullptr;
+		}
+
+		return CreatePathJPS(startTileIndex, endTileIndex, mapDimensions, tileCosts, uniformTileCost, limit, jumpPointTable);
+	}
+	else
+	{
+		return CreatePathAStar(startTileIndex, endTileIndex, mapDimensions, tileCosts, limit);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+Path AStarPather::CreatePathAStar(int startTileIndex, int endTileIndex, IntVec2 mapDimensions, const std::vector<int>& tileCosts, int limit)
+{
+	SeedStartTile(startTileIndex, endTileIndex, mapDimensions, 1);
 
 	// Begin the AStar!
 	int iterations = 0;
-	while (m_openTileIndexList.size() > 0 && iterations < limit)
+	while (!m_openList.IsEmpty() && iterations < limit)
 	{
-		int currentIndex = SelectFromAndUpdateOpenIndexList();
-		m_pathInfo[currentIndex].pathState = PATH_STATE_FINISHED;
+		int currentIndex = m_openList.Pop();
+		m_heapOperations++;
+		m_nodesExpanded++;
+		GetPathInfo(currentIndex).pathState = PATH_STATE_FINISHED;
 
 		// If we have our Termination Index, we know we have the shortest path set already;
 		if (currentIndex == endTileIndex)
@@ -29,88 +106,188 @@ Path AStarPather::CreatePathAStar(int startTileIndex, int endTileIndex, IntVec2
 
 		for (int i = 0; i < validNeighbors; i++)
 		{
-			bool canPath = CalculateCostsForTileIndex(neighbors[i], endTileIndex, mapDimensions, tileCosts);
-			if (canPath)
-			{
-				m_pathInfo[neighbors[i]].parentIndex = currentIndex;
-
-				if (m_pathInfo[neighbors[i]].pathState == PATH_STATE_UNVISITED)
-				{
-					m_pathInfo[neighbors[i]].pathState = PATH_STATE_VISITED;
-					m_openTileIndexList.push_back(neighbors[i]);
-				}
-			}
+			CalculateCostsForTileIndex(neighbors[i], currentIndex, endTileIndex, mapDimensions, tileCosts);
 		}
 
 		iterations++;
 	}
 
-	//DebuggerPrintf("\n %d", m_openTileIndexList.size());
-	if (m_openTileIndexList.size() > m_largestOpenList)
+	return FinishSearch(startTileIndex, endTileIndex, mapDimensions);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Jump Point Search for 4-connected grids. Only valid when every passable tile costs uniformTileCost
+// With a jump point table the jumps are looked up (JPS+) instead of walked, the jump points and the path are the same
+//------------------------------------------------------------------------------------------------------------------------------
+Path AStarPather::CreatePathJPS(int startTileIndex, int endTileIndex, IntVec2 mapDimensions, const std::vector<int>& tileCosts, int uniformTileCost, int limit, const JumpPointTable* jumpPointTable)
+{
+	SeedStartTile(startTileIndex, endTileIndex, mapDimensions, uniformTileCost);
+
+	int iterations = 0;
+	while (!m_openList.IsEmpty() && iterations < limit)
 	{
-		m_largestOpenList = m_openTileIndexList.size();
-	}
+		int currentIndex = m_openList.Pop();
+		m_heapOperations++;
+		m_nodesExpanded++;
 
-	// Work backwards from our Termination Point to the Starting Point;
-	Path path;
-	IntVec2 pathCoord = GetTileCoordinatesFromIndex(endTileIndex, mapDimensions);
-	path.push_back(pathCoord);
+		AStarPathInfo_T& currentInfo = GetPathInfo(currentIndex);
+		currentInfo.pathState = PATH_STATE_FINISHED;
+
+		if (currentIndex == endTileIndex)
+		{
+			break;
+		}
 
-	int nextIndex = m_pathInfo[endTileIndex].parentIndex;
+		IntVec2 currentTile = GetTileCoordinatesFromIndex(currentIndex, mapDimensions);
 
-	bool workingBackwards = true;
-	while (workingBackwards)
-	{
-		//pathCoord = GetCoordFromIndex(nextIndex, mapDimensions);
-		//path->push_back(pathCoord);
+		// Work out which way we came in so we only search the directions that are not pruned
+		int dirX = 0;
+		int dirY = 0;
+		if (currentInfo.parentIndex != -1)
+		{
+			IntVec2 parentTile = GetTileCoordinatesFromIndex(currentInfo.parentIndex, mapDimensions);
+			dirX = (currentTile.x > parentTile.x) - (currentTile.x < parentTile.x);
+			dirY = (currentTile.y > parentTile.y) - (currentTile.y < parentTile.y);
+		}
 
-		if (nextIndex == -1 || nextIndex == startTileIndex)
+		int jumpPoints[4] = { -1, -1, -1, -1 };
+		if (dirX == 0 && dirY == 0)
+		{
+			jumpPoints[0] = Jump(currentTile, JUMP_EAST, endTileIndex, mapDimensions, tileCosts, jumpPointTable);
+			jumpPoints[1] = Jump(currentTile, JUMP_WEST, endTileIndex, mapDimensions, tileCosts, jumpPointTable);
+			jumpPoints[2] = Jump(currentTile, JUMP_NORTH, endTileIndex, mapDimensions, tileCosts, jumpPointTable);
+			jumpPoints[3] = Jump(currentTile, JUMP_SOUTH, endTileIndex, mapDimensions, tileCosts, jumpPointTable);
+		}
+		else if (dirX != 0)
 		{
-			//pathCoord = GetCoordFromIndex(nextIndex, mapDimensions);
-			workingBackwards = false;
+			// Moving horizontally we may always keep going or turn north or south
+			jumpPoints[0] = Jump(currentTile, dirX > 0 ? JUMP_EAST : JUMP_WEST, endTileIndex, mapDimensions, tileCosts, jumpPointTable);
+			jumpPoints[1] = Jump(currentTile, JUMP_NORTH, endTileIndex, mapDimensions, tileCosts, jumpPointTable);
+			jumpPoints[2] = Jump(currentTile, JUMP_SOUTH, endTileIndex, mapDimensions, tileCosts, jumpPointTable);
 		}
 		else
 		{
-			pathCoord = GetTileCoordinatesFromIndex(nextIndex, mapDimensions);
-			path.push_back(pathCoord);
-			nextIndex = m_pathInfo[nextIndex].parentIndex;
+			// Moving vertically we keep going, and turn only towards forced neighbors
+			jumpPoints[0] = Jump(currentTile, dirY > 0 ? JUMP_NORTH : JUMP_SOUTH, endTileIndex, mapDimensions, tileCosts, jumpPointTable);
+
+			if (IsTileBlocked(currentTile.x + 1, currentTile.y - dirY, mapDimensions, tileCosts))
+			{
+				jumpPoints[1] = Jump(currentTile, JUMP_EAST, endTileIndex, mapDimensions, tileCosts, jumpPointTable);
+			}
+			if (IsTileBlocked(currentTile.x - 1, currentTile.y - dirY, mapDimensions, tileCosts))
+			{
+				jumpPoints[2] = Jump(currentTile, JUMP_WEST, endTileIndex, mapDimensions, tileCosts, jumpPointTable);
+			}
 		}
-	}
 
-	m_openTileIndexList.clear();
+		for (int i = 0; i < 4; i++)
+		{
+			if (jumpPoints[i] == -1 || GetPathInfo(jumpPoints[i]).pathState == PATH_STATE_FINISHED)
+				continue;
 
-	return path;
+			int distance = GetManhattanDistance(currentTile, GetTileCoordinatesFromIndex(jumpPoints[i], mapDimensions));
+			OpenOrDecreaseTile(jumpPoints[i], currentIndex, currentInfo.gCost + distance * uniformTileCost, uniformTileCost, endTileIndex, mapDimensions);
+		}
+
+		iterations++;
+	}
+
+	return FinishSearch(startTileIndex, endTileIndex, mapDimensions);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-int AStarPather::SelectFromAndUpdateOpenIndexList()
+// Returns the cost shared by every passable tile, or -1 if the passable tiles do not all cost the same
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC int AStarPather::GetUniformTileCost(const std::vector<int>& tileCosts)
 {
-	// Get my Best Index from the Open List and then remove it from the Open List;
-	int counter = 0;
-	int eraseSlot = 0;
-	int smallestCostIndex = m_openTileIndexList.front();
-	int smallestCost = m_pathInfo[smallestCostIndex].fCost;
+	int uniformTileCost = -1;
 
-	for (int tileIndex : m_openTileIndexList)
+	for (int tileIndex = 0; tileIndex < (int)tileCosts.size(); tileIndex++)
 	{
-		if(tileIndex < 0)
+		int tileCost = tileCosts[tileIndex];
+		if (tileCost >= ASTAR_IMPASSABLE_COST)
 			continue;
 
-		if (m_pathInfo[tileIndex].fCost < smallestCost)
+		if (uniformTileCost == -1)
+		{
+			uniformTileCost = tileCost;
+		}
+		else if (tileCost != uniformTileCost)
 		{
-			smallestCostIndex = tileIndex;
-			smallestCost = m_pathInfo[tileIndex].fCost;
-			eraseSlot = counter;
+			return -1;
 		}
-		counter++;
 	}
 
-	m_openTileIndexList.erase(m_openTileIndexList.begin() + eraseSlot);
+	return uniformTileCost;
+}
 
-	// Set the state of this index to be finished, we are going to process it now;
-	m_pathInfo[smallestCostIndex].pathState = PATH_STATE_FINISHED;
+//------------------------------------------------------------------------------------------------------------------------------
+void AStarPather::SeedStartTile(int startTileIndex, int endTileIndex, const IntVec2& mapDimensions, int hCostScale)
+{
+	// m_pathInfo lives on Pather and is sized once in Init. Bumping the generation invalidates the last search
+	if ((int)m_pathInfo.size() != mapDimensions.x * mapDimensions.y)
+	{
+		Init(mapDimensions);
+	}
 
-	return smallestCostIndex;
+	StartNewSearch();
+
+	// Seed the open list with the start tile
+	AStarPathInfo_T& startInfo = GetPathInfo(startTileIndex);
+	startInfo.gCost = 0;
+	startInfo.hCost = hCostScale * GetManhattanDistance(GetTileCoordinatesFromIndex(startTileIndex, mapDimensions), GetTileCoordinatesFromIndex(endTileIndex, mapDimensions));
+	startInfo.fCost = startInfo.hCost;
+	startInfo.pathState = PATH_STATE_VISITED;
+
+	AStarPriority_T startPriority;
+	startPriority.fCost = startInfo.fCost;
+	startPriority.hCost = startInfo.hCost;
+	m_openList.Push(startTileIndex, startPriority);
+	m_heapOperations++;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Builds the path back from the end tile and resets the open list. Parents may be several tiles apart (jump points)
+// so every tile in between is filled in. Path is ordered end first, the start tile is not included
+//------------------------------------------------------------------------------------------------------------------------------
+Path AStarPather::FinishSearch(int startTileIndex, int endTileIndex, const IntVec2& mapDimensions)
+{
+	//DebuggerPrintf("\n %d", m_openList.GetSize());
+	if (m_openList.GetSize() > m_largestOpenList)
+	{
+		m_largestOpenList = m_openList.GetSize();
+	}
+
+	// Work backwards from our Termination Point to the Starting Point;
+	Path path;
+	IntVec2 pathCoord = GetTileCoordinatesFromIndex(endTileIndex, mapDimensions);
+	path.push_back(pathCoord);
+
+	int currentIndex = endTileIndex;
+	int nextIndex = GetPathInfo(endTileIndex).parentIndex;
+
+	while (nextIndex != -1)
+	{
+		IntVec2 nextCoord = GetTileCoordinatesFromIndex(nextIndex, mapDimensions);
+		IntVec2 step = IntVec2((nextCoord.x > pathCoord.x) - (nextCoord.x < pathCoord.x), (nextCoord.y > pathCoord.y) - (nextCoord.y < pathCoord.y));
+
+		//Fill in the tiles between this jump point and its parent, the parent itself is pushed below
+		for (pathCoord += step; pathCoord != nextCoord; pathCoord += step)
+		{
+			path.push_back(pathCoord);
+		}
+
+		if (nextIndex == startTileIndex)
+			break;
+
+		path.push_back(pathCoord);
+		currentIndex = nextIndex;
+		nextIndex = GetPathInfo(currentIndex).parentIndex;
+	}
+
+	m_openList.Clear();
+
+	return path;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -142,22 +319,22 @@ int AStarPather::PopulateBoundedNeighbors(const int currentTileIdex, const IntVe
 	int west = currentTileIdex - 1;
 
 	int i = 0;
-	if (IsContained(northTile, tileDimensions) && m_pathInfo[north].pathState == PATH_STATE_UNVISITED)
+	if (IsContained(northTile, tileDimensions) && GetPathInfo(north).pathState != PATH_STATE_FINISHED)
 	{
 		outNeighbors[i] = north;
 		i++;
 	}
-	if (IsContained(southTile, tileDimensions) && m_pathInfo[south].pathState == PATH_STATE_UNVISITED)
+	if (IsContained(southTile, tileDimensions) && GetPathInfo(south).pathState != PATH_STATE_FINISHED)
 	{
 		outNeighbors[i] = south;
 		i++;
 	}
-	if (IsContained(eastTile, tileDimensions) && m_pathInfo[east].pathState == PATH_STATE_UNVISITED)
+	if (IsContained(eastTile, tileDimensions) && GetPathInfo(east).pathState != PATH_STATE_FINISHED)
 	{
 		outNeighbors[i] = east;
 		i++;
 	}
-	if (IsContained(westTile, tileDimensions) && m_pathInfo[west].pathState == PATH_STATE_UNVISITED)
+	if (IsContained(westTile, tileDimensions) && GetPathInfo(west).pathState != PATH_STATE_FINISHED)
 	{
 		outNeighbors[i] = west;
 		i++;
@@ -167,7 +344,7 @@ int AStarPather::PopulateBoundedNeighbors(const int currentTileIdex, const IntVe
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-IntVec2 AStarPather::GetTileCoordinatesFromIndex(const short tileIndex, const IntVec2 mapDims)
+IntVec2 AStarPather::GetTileCoordinatesFromIndex(const int tileIndex, const IntVec2 mapDims)
 {
 	IntVec2 tileCoords;
 	tileCoords.x = tileIndex % mapDims.x;
@@ -176,45 +353,186 @@ IntVec2 AStarPather::GetTileCoordinatesFromIndex(const short tileIndex, const In
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-bool AStarPather::CalculateCostsForTileIndex(const int currentTileIndex, const int terminationPointIndex, const IntVec2& mapDimensions, const std::vector<int>& tileCosts_, bool isStart /*= false*/)
+// Relaxes currentTileIndex through parentTileIndex; pushes it on the open list or decreases its key if the route is cheaper
+//------------------------------------------------------------------------------------------------------------------------------
+bool AStarPather::CalculateCostsForTileIndex(const int currentTileIndex, const int parentTileIndex, const int terminationPointIndex, const IntVec2& mapDimensions, const std::vector<int>& tileCosts_)
 {
-	if (!isStart)
+	int tileCost = tileCosts_[currentTileIndex];
+	if (tileCost >= ASTAR_IMPASSABLE_COST)
 	{
-		m_pathInfo[currentTileIndex].gCost = tileCosts_[currentTileIndex];
-		m_pathInfo[currentTileIndex].hCost = GetManhattanDistance(GetTileCoordinatesFromIndex(currentTileIndex, mapDimensions), GetTileCoordinatesFromIndex(terminationPointIndex, mapDimensions));
-		m_pathInfo[currentTileIndex].fCost = m_pathInfo[currentTileIndex].gCost + m_pathInfo[currentTileIndex].hCost;
+		return false;
+	}
+
+	int gCost = GetPathInfo(parentTileIndex).gCost + tileCost;
+	return OpenOrDecreaseTile(currentTileIndex, parentTileIndex, gCost, 1, terminationPointIndex, mapDimensions);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool AStarPather::OpenOrDecreaseTile(const int tileIndex, const int parentTileIndex, const int gCost, const int hCostScale, const int terminationPointIndex, const IntVec2& mapDimensions)
+{
+	AStarPathInfo_T& tileInfo = GetPathInfo(tileIndex);
 
-		if (m_pathInfo[currentTileIndex].fCost < 99999)
+	if (tileInfo.pathState == PATH_STATE_UNVISITED)
+	{
+		tileInfo.hCost = hCostScale * GetManhattanDistance(GetTileCoordinatesFromIndex(tileIndex, mapDimensions), GetTileCoordinatesFromIndex(terminationPointIndex, mapDimensions));
+	}
+	else if (gCost >= tileInfo.gCost)
+	{
+		return false;
+	}
+
+	tileInfo.gCost = gCost;
+	tileInfo.fCost = tileInfo.gCost + tileInfo.hCost;
+	tileInfo.parentIndex = parentTileIndex;
+
+	AStarPriority_T priority;
+	priority.fCost = tileInfo.fCost;
+	priority.hCost = tileInfo.hCost;
+
+	if (tileInfo.pathState == PATH_STATE_UNVISITED)
+	{
+		tileInfo.pathState = PATH_STATE_VISITED;
+		m_openList.Push(tileIndex, priority);
+	}
+	else
+	{
+		m_openList.DecreasePriority(tileIndex, priority);
+	}
+
+	m_heapOperations++;
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool AStarPather::IsTileBlocked(int tileX, int tileY, const IntVec2& mapDimensions, const std::vector<int>& tileCosts) const
+{
+	if (tileX < 0 || tileY < 0 || tileX >= mapDimensions.x || tileY >= mapDimensions.y)
+	{
+		return true;
+	}
+
+	return tileCosts[tileY * mapDimensions.x + tileX] >= ASTAR_IMPASSABLE_COST;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Steps east or west until we hit the goal, a wall, or a tile where turning north or south leads to a jump point
+//------------------------------------------------------------------------------------------------------------------------------
+int AStarPather::JumpHorizontal(int tileX, int tileY, int dirX, const int terminationPointIndex, const IntVec2& mapDimensions, const std::vector<int>& tileCosts)
+{
+	while (true)
+	{
+		tileX += dirX;
+		if (IsTileBlocked(tileX, tileY, mapDimensions, tileCosts))
 		{
-			return true;
+			return -1;
 		}
-		else
+
+		int tileIndex = tileY * mapDimensions.x + tileX;
+		if (tileIndex == terminationPointIndex)
+		{
+			return tileIndex;
+		}
+
+		if (JumpVertical(tileX, tileY, 1, terminationPointIndex, mapDimensions, tileCosts) != -1
+			|| JumpVertical(tileX, tileY, -1, terminationPointIndex, mapDimensions, tileCosts) != -1)
 		{
-			return false;
+			return tileIndex;
 		}
 	}
-	else
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Steps north or south until we hit the goal, a wall, or a tile with a forced east or west neighbor
+//------------------------------------------------------------------------------------------------------------------------------
+int AStarPather::JumpVertical(int tileX, int tileY, int dirY, const int terminationPointIndex, const IntVec2& mapDimensions, const std::vector<int>& tileCosts)
+{
+	while (true)
 	{
-		m_pathInfo[currentTileIndex].gCost = tileCosts_[currentTileIndex];
-		m_pathInfo[currentTileIndex].hCost = GetManhattanDistance(GetTileCoordinatesFromIndex(currentTileIndex, mapDimensions), GetTileCoordinatesFromIndex(terminationPointIndex, mapDimensions));
-		m_pathInfo[currentTileIndex].fCost = 0;
-		m_pathInfo[currentTileIndex].pathState = PATH_STATE_FINISHED;
+		tileY += dirY;
+		if (IsTileBlocked(tileX, tileY, mapDimensions, tileCosts))
+		{
+			return -1;
+		}
 
-		int neighbors[4] = { 0, 0, 0, 0 };
-		int validNeighbors = PopulateBoundedNeighbors(currentTileIndex, mapDimensions, neighbors);
+		int tileIndex = tileY * mapDimensions.x + tileX;
+		if (tileIndex == terminationPointIndex)
+		{
+			return tileIndex;
+		}
 
-		for (int i = 0; i < validNeighbors; i++)
+		bool forcedEast = IsTileBlocked(tileX + 1, tileY - dirY, mapDimensions, tileCosts) && !IsTileBlocked(tileX + 1, tileY, mapDimensions, tileCosts);
+		bool forcedWest = IsTileBlocked(tileX - 1, tileY - dirY, mapDimensions, tileCosts) && !IsTileBlocked(tileX - 1, tileY, mapDimensions, tileCosts);
+		if (forcedEast || forcedWest)
 		{
-			CalculateCostsForTileIndex(neighbors[i], terminationPointIndex, mapDimensions, tileCosts_);
-			m_pathInfo[neighbors[i]].parentIndex = currentTileIndex;
+			return tileIndex;
+		}
+	}
+}
 
-			if (m_pathInfo[neighbors[i]].pathState == PATH_STATE_UNVISITED)
-			{
-				m_pathInfo[neighbors[i]].pathState = PATH_STATE_VISITED;
-				m_openTileIndexList.push_back(neighbors[i]);
-			}
+//------------------------------------------------------------------------------------------------------------------------------
+int AStarPather::Jump(const IntVec2& tile, eJumpDirection direction, const int terminationPointIndex, const IntVec2& mapDimensions, const std::vector<int>& tileCosts, const JumpPointTable* jumpPointTable)
+{
+	if (jumpPointTable != nullptr)
+	{
+		return LookUpJump(tile, direction, terminationPointIndex, mapDimensions, *jumpPointTable);
+	}
+
+	switch (direction)
+	{
+	case JUMP_EAST:
+		return JumpHorizontal(tile.x, tile.y, 1, terminationPointIndex, mapDimensions, tileCosts);
+	case JUMP_WEST:
+		return JumpHorizontal(tile.x, tile.y, -1, terminationPointIndex, mapDimensions, tileCosts);
+	case JUMP_NORTH:
+		return JumpVertical(tile.x, tile.y, 1, terminationPointIndex, mapDimensions, tileCosts);
+	case JUMP_SOUTH:
+		return JumpVertical(tile.x, tile.y, -1, terminationPointIndex, mapDimensions, tileCosts);
+	default:
+		return -1;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// The table has the jump point or the free run up to a wall. All that's left is the goal, if it lies on that run before
+// the jump point. Going east or west that means its column, when the vertical jump from there would reach it
+// A goal column holding a jump point of its own is already the table's stop, so that vertical jump has no jump point
+//------------------------------------------------------------------------------------------------------------------------------
+int AStarPather::LookUpJump(const IntVec2& tile, eJumpDirection direction, const int terminationPointIndex, const IntVec2& mapDimensions, const JumpPointTable& jumpPointTable)
+{
+	int tileIndex = tile.y * mapDimensions.x + tile.x;
+	int jumpDistance = jumpPointTable.GetJumpDistance(tileIndex, direction);
+	int freeTiles = jumpDistance > 0 ? jumpDistance : -jumpDistance;
+	IntVec2 goalTile = GetTileCoordinatesFromIndex(terminationPointIndex, mapDimensions);
+
+	if (direction == JUMP_NORTH || direction == JUMP_SOUTH)
+	{
+		int dirY = direction == JUMP_NORTH ? 1 : -1;
+		int stepsToGoal = (goalTile.y - tile.y) * dirY;
+		if (goalTile.x == tile.x && stepsToGoal > 0 && stepsToGoal <= freeTiles)
+		{
+			return terminationPointIndex;
 		}
 
-		return true;
+		return jumpDistance > 0 ? tileIndex + jumpDistance * dirY * mapDimensions.x : -1;
+	}
+
+	int dirX = direction == JUMP_EAST ? 1 : -1;
+	int stepsToGoalColumn = (goalTile.x - tile.x) * dirX;
+	if (stepsToGoalColumn > 0 && stepsToGoalColumn <= freeTiles && (jumpDistance <= 0 || stepsToGoalColumn < jumpDistance))
+	{
+		int columnTileIndex = tileIndex + stepsToGoalColumn * dirX;
+		int rowsToGoal = abs(goalTile.y - tile.y);
+		if (rowsToGoal == 0)
+		{
+			return columnTileIndex;
+		}
+
+		int verticalDistance = jumpPointTable.GetJumpDistance(columnTileIndex, goalTile.y > tile.y ? JUMP_NORTH : JUMP_SOUTH);
+		if (rowsToGoal <= -verticalDistance)
+		{
+			return columnTileIndex;
+		}
 	}
-}
\ No newline at end of file
+
+	return jumpDistance > 0 ? tileIndex + jumpDistance * dirX : -1;
+}
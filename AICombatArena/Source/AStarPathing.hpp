@@ -1,6 +1,9 @@
 #pragma once
 #include <vector>
+#include <climits>
 #include "IntVec2.hpp"
+#include "IndexedPriorityQueue.hpp"
+#include "JumpPointTable.hpp"
 
 enum ePathState
 {
@@ -9,15 +12,29 @@ enum ePathState
 	PATH_STATE_FINISHED,
 };
 
+constexpr int ASTAR_IMPASSABLE_COST = 99999;	//Any tile costing this much or more is never expanded
+
 struct AStarPathInfo_T
 {
 	int fCost = INT_MAX;	//Actual tile cost
 
-	int gCost = 0;	//Cost from tileCosts argument
+	int gCost = 0;	//Accumulated cost from the start using the tileCosts argument
 	int hCost = 0;	//Heuristic cost
 
 	int parentIndex = -1;
 	ePathState pathState = PATH_STATE_UNVISITED;
+
+	unsigned int searchGeneration = 0;	//Entries stamped with an older generation are treated as unvisited
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Open list ordering: lowest fCost first, ties go to the tile closest to the goal
+struct AStarPriority_T
+{
+	int fCost = 0;
+	int hCost = 0;
+
+	bool	operator<(const AStarPriority_T& compare) const;
 };
 
 typedef std::vector<IntVec2> Path;
@@ -26,16 +43,38 @@ typedef std::vector<AStarPathInfo_T> PathInfo;
 class AStarPather
 {
 public:
+	void			Init(const IntVec2& mapDimensions);
+
+	Path			CreatePath(int startTileIndex, int endTileIndex, IntVec2 mapDimensions, const std::vector<int>& tileCosts, int uniformTileCost, int limit = 256, const JumpPointTable* jumpPointTable = nullptr);
 	Path			CreatePathAStar(int startTileIndex, int endTileIndex, IntVec2 mapDimensions, const std::vector<int>& tileCosts, int limit = 256);
-	bool			CalculateCostsForTileIndex(const int currentTileIndex, const int terminationPointIndex, const IntVec2& tileDimensions, const std::vector<int>& tileCosts_, bool isStart = false);
-	int				SelectFromAndUpdateOpenIndexList();
+	Path			CreatePathJPS(int startTileIndex, int endTileIndex, IntVec2 mapDimensions, const std::vector<int>& tileCosts, int uniformTileCost, int limit = 256, const JumpPointTable* jumpPointTable = nullptr);
+	static int		GetUniformTileCost(const std::vector<int>& tileCosts);
+
+	bool			CalculateCostsForTileIndex(const int currentTileIndex, const int parentTileIndex, const int terminationPointIndex, const IntVec2& tileDimensions, const std::vector<int>& tileCosts_);
 	int				PopulateBoundedNeighbors(const int currentTileIdex, const IntVec2& tileDimensions, int* outNeighbors);
 
-	IntVec2			GetTileCoordinatesFromIndex(const short tileIndex, const IntVec2 mapDims);
+	IntVec2			GetTileCoordinatesFromIndex(const int tileIndex, const IntVec2 mapDims);
 	
-	int		m_largestOpenList = 0;
+	int					m_largestOpenList = 0;
+	unsigned long long	m_heapOperations = 0;	//Push, pop and decrease-key calls on the open list
+	unsigned long long	m_nodesExpanded = 0;	//Tiles (or jump points) popped off the open list
+private:
+	void				StartNewSearch();
+	AStarPathInfo_T&	GetPathInfo(const int tileIndex);
+
+	void				SeedStartTile(int startTileIndex, int endTileIndex, const IntVec2& mapDimensions, int hCostScale);
+	bool				OpenOrDecreaseTile(const int tileIndex, const int parentTileIndex, const int gCost, const int hCostScale, const int terminationPointIndex, const IntVec2& mapDimensions);
+	Path				FinishSearch(int startTileIndex, int endTileIndex, const IntVec2& mapDimensions);
+
+	bool				IsTileBlocked(int tileX, int tileY, const IntVec2& mapDimensions, const std::vector<int>& tileCosts) const;
+	int					JumpHorizontal(int tileX, int tileY, int dirX, const int terminationPointIndex, const IntVec2& mapDimensions, const std::vector<int>& tileCosts);
+	int					JumpVertical(int tileX, int tileY, int dirY, const int terminationPointIndex, const IntVec2& mapDimensions, const std::vector<int>& tileCosts);
+	int					Jump(const IntVec2& tile, eJumpDirection direction, const int terminationPointIndex, const IntVec2& mapDimensions, const std::vector<int>& tileCosts, const JumpPointTable* jumpPointTable);
+	int					LookUpJump(const IntVec2& tile, eJumpDirection direction, const int terminationPointIndex, const IntVec2& mapDimensions, const JumpPointTable& jumpPointTable);
+
 private:
-	std::vector<int> m_openTileIndexList;
+	IndexedPriorityQueue<AStarPriority_T>	m_openList;
 	PathInfo m_pathInfo;
+	unsigned int m_searchGeneration = 0;
 
 };
\ No newline at end of file
@@ -7,7 +7,7 @@ Agent::Agent(const AgentReport& base)
 	UpdateAgentData(base);
 	
 	agentID = base.agentID;
-	m_currentPath.clear();
+	m_currentPath.Clear();
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -30,34 +30,44 @@ void Agent::UpdateAgentData(const AgentReport& agentReport)
 //------------------------------------------------------------------------------------------------------------------------------
 bool Agent::ContinuePathIfValid()
 {
-	if (m_currentPath.size() > 0)
+	if (!m_currentPath.IsEmpty())
 	{
-		IntVec2 destination = m_currentPath.front();
+		IntVec2 destination = m_currentPath.GetDestination();
 		AIPlayerController* playerController = AIPlayerController::GetInstance();
 
 		int destIndex = playerController->GetTileIndex(destination.x, destination.y);
 
-		if (playerController->m_foodVisionHeatMap[destIndex] && type == AGENT_TYPE_WORKER)
+		if (m_currentPath.isBlocked && (type != AGENT_TYPE_WORKER || playerController->IsFoodAvailableTo(destIndex, agentID)))
 		{
-			eOrderCode order = playerController->GetMoveOrderToTile(*this, m_currentPath.back().x, m_currentPath.back().y);
+			//The world model kept the destination when it blocked the path, so D* Lite repairs it instead of a full replan
+			if (playerController->RepairPathIncrementally(*this))
+				return true;
+
+			m_currentPath.Clear();
+			return false;
+		}
+
+		if (playerController->IsFoodAvailableTo(destIndex, agentID) && type == AGENT_TYPE_WORKER)
+		{
+			eOrderCode order = playerController->GetMoveOrderToTile(*this, m_currentPath.nextX, m_currentPath.nextY);
 			playerController->AddOrder(agentID, order);
 
-			m_currentPath.pop_back();
+			playerController->GetPathArena().PopStep(m_currentPath);
 
 			return true;
 		}
 		else if (type != AGENT_TYPE_WORKER)
 		{
-			eOrderCode order = playerController->GetMoveOrderToTile(*this, m_currentPath.back().x, m_currentPath.back().y);
+			eOrderCode order = playerController->GetMoveOrderToTile(*this, m_currentPath.nextX, m_currentPath.nextY);
 			playerController->AddOrder(agentID, order);
 
-			m_currentPath.pop_back();
+			playerController->GetPathArena().PopStep(m_currentPath);
 
 			return true;
 		}
 		else
 		{
-			m_currentPath.clear();
+			m_currentPath.Clear();
 			return false;
 		}
 	}
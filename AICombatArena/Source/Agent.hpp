@@ -2,8 +2,7 @@
 #include "ArenaPlayerInterface.hpp"
 #include <vector>
 #include "IntVec2.hpp"
-
-typedef std::vector<IntVec2> Path;
+#include "PathArena.hpp"
 
 //------------------------------------------------------------------------------------------------------------------------------
 class Agent : public AgentReport
@@ -15,6 +14,6 @@ public:
 	bool ContinuePathIfValid();
 
 public:
-	Path		m_currentPath;
-	int			m_assignedTileIndex = -1;	//Assigned tile index
+	PackedPath_T	m_currentPath;			//Steps live in the controller's PathArena
+	int				m_assignedTileIndex = -1;	//Assigned tile index
 };
\ No newline at end of file
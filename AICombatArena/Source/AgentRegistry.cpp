@@ -0,0 +1,165 @@
+#include "AgentRegistry.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Reserving up front keeps Agent references stable while agents are only being updated
+//------------------------------------------------------------------------------------------------------------------------------
+void AgentRegistry::Init(int maxAgents)
+{
+	Clear();
+
+	m_agents.reserve(maxAgents);
+	m_agentSlots.reserve(maxAgents);
+	m_slots.reserve(maxAgents);
+	m_freeSlots.reserve(maxAgents);
+	m_slotsByID.reserve(maxAgents);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Handles from before the clear stay stale, the slots keep their generations
+//------------------------------------------------------------------------------------------------------------------------------
+void AgentRegistry::Clear()
+{
+	m_agents.clear();
+	m_agentSlots.clear();
+	m_freeSlots.clear();
+	m_slotsByID.clear();
+
+	for (int slotIndex = (int)m_slots.size() - 1; slotIndex >= 0; slotIndex--)
+	{
+		if (m_slots[slotIndex].denseIndex != -1)
+		{
+			m_slots[slotIndex].denseIndex = -1;
+			m_slots[slotIndex].generation++;
+		}
+
+		m_freeSlots.push_back(slotIndex);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Updates the agent instead if the ID is already registered
+//------------------------------------------------------------------------------------------------------------------------------
+Agent& AgentRegistry::Add(const AgentReport& report)
+{
+	Agent* existingAgent = Find(report.agentID);
+	if (existingAgent != nullptr)
+	{
+		existingAgent->UpdateAgentData(report);
+		return *existingAgent;
+	}
+
+	int slotIndex = AllocateSlot();
+	m_slots[slotIndex].denseIndex = (int)m_agents.size();
+	m_slotsByID[report.agentID] = slotIndex;
+
+	m_agents.push_back(Agent(report));
+	m_agentSlots.push_back(slotIndex);
+
+	return m_agents.back();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Swaps the last agent into the removed one's place so nothing else in the dense array moves
+//------------------------------------------------------------------------------------------------------------------------------
+bool AgentRegistry::Remove(AgentID agentID)
+{
+	std::unordered_map<AgentID, int>::iterator slotItr = m_slotsByID.find(agentID);
+	if (slotItr == m_slotsByID.end())
+		return false;
+
+	int slotIndex = slotItr->second;
+	int denseIndex = m_slots[slotIndex].denseIndex;
+	int lastIndex = (int)m_agents.size() - 1;
+
+	if (denseIndex != lastIndex)
+	{
+		m_agents[denseIndex] = std::move(m_agents[lastIndex]);
+		m_agentSlots[denseIndex] = m_agentSlots[lastIndex];
+		m_slots[m_agentSlots[denseIndex]].denseIndex = denseIndex;
+	}
+
+	m_agents.pop_back();
+	m_agentSlots.pop_back();
+
+	m_slots[slotIndex].denseIndex = -1;
+	m_slots[slotIndex].generation++;
+	m_freeSlots.push_back(slotIndex);
+
+	m_slotsByID.erase(slotItr);
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+Agent* AgentRegistry::Find(AgentID agentID)
+{
+	std::unordered_map<AgentID, int>::const_iterator slotItr = m_slotsByID.find(agentID);
+	if (slotItr == m_slotsByID.end())
+		return nullptr;
+
+	return &m_agents[m_slots[slotItr->second].denseIndex];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+Agent* AgentRegistry::Get(const AgentHandle_T& handle)
+{
+	if (!IsValid(handle))
+		return nullptr;
+
+	return &m_agents[m_slots[handle.slotIndex].denseIndex];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+AgentHandle_T AgentRegistry::GetHandle(AgentID agentID) const
+{
+	AgentHandle_T handle;
+
+	std::unordered_map<AgentID, int>::const_iterator slotItr = m_slotsByID.find(agentID);
+	if (slotItr == m_slotsByID.end())
+		return handle;
+
+	handle.slotIndex = slotItr->second;
+	handle.generation = m_slots[slotItr->second].generation;
+	return handle;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool AgentRegistry::IsValid(const AgentHandle_T& handle) const
+{
+	if (handle.slotIndex < 0 || handle.slotIndex >= (int)m_slots.size())
+		return false;
+
+	const AgentSlot_T& slot = m_slots[handle.slotIndex];
+	return slot.denseIndex != -1 && slot.generation == handle.generation;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int AgentRegistry::GetNumAgents() const
+{
+	return (int)m_agents.size();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+Agent& AgentRegistry::GetAgent(int denseIndex)
+{
+	return m_agents[denseIndex];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const Agent& AgentRegistry::GetAgent(int denseIndex) const
+{
+	return m_agents[denseIndex];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int AgentRegistry::AllocateSlot()
+{
+	if (!m_freeSlots.empty())
+	{
+		int slotIndex = m_freeSlots.back();
+		m_freeSlots.pop_back();
+		return slotIndex;
+	}
+
+	m_slots.push_back(AgentSlot_T());
+	return (int)m_slots.size() - 1;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include "Agent.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Refers to an agent across turns. Goes stale once the agent is removed, even if its slot is reused later
+struct AgentHandle_T
+{
+	int				slotIndex = -1;
+	unsigned int	generation = 0;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct AgentSlot_T
+{
+	int				denseIndex = -1;	//-1 while the slot is free
+	unsigned int	generation = 0;		//Bumped every time the slot is freed
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Slot map of our agents. The agents themselves are packed in a dense array for iteration; removing one moves the last
+// agent into its place, so dense indices and Agent references only hold until the next Add or Remove
+// Anything kept across turns should hold an AgentHandle_T or an AgentID instead
+//------------------------------------------------------------------------------------------------------------------------------
+class AgentRegistry
+{
+public:
+	void				Init(int maxAgents);
+	void				Clear();
+
+	Agent&				Add(const AgentReport& report);
+	bool				Remove(AgentID agentID);
+
+	Agent*				Find(AgentID agentID);
+	Agent*				Get(const AgentHandle_T& handle);
+	AgentHandle_T		GetHandle(AgentID agentID) const;
+	bool				IsValid(const AgentHandle_T& handle) const;
+
+	int					GetNumAgents() const;
+	Agent&				GetAgent(int denseIndex);
+	const Agent&		GetAgent(int denseIndex) const;
+
+private:
+	int					AllocateSlot();
+
+private:
+	std::vector<Agent>					m_agents;			//Dense, in no particular order
+	std::vector<int>					m_agentSlots;		//Slot of each dense agent
+
+	std::vector<AgentSlot_T>			m_slots;
+	std::vector<int>					m_freeSlots;
+
+	std::unordered_map<AgentID, int>	m_slotsByID;
+};
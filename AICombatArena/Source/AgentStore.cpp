@@ -0,0 +1,113 @@
+#include "AgentStore.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+void AgentStore::Init(int maxAgents)
+{
+	agentIDs.resize(maxAgents);
+	tileX.resize(maxAgents);
+	tileY.resize(maxAgents);
+	exhaustion.resize(maxAgents);
+	states.resize(maxAgents);
+	results.resize(maxAgents);
+	registryIndices.resize(maxAgents);
+
+	m_numAgents = 0;
+	for (int typeIndex = 0; typeIndex <= NUM_AGENT_TYPES; typeIndex++)
+	{
+		m_typeStarts[typeIndex] = 0;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Counting sort on the agent type, the registry is walked in order so each partition keeps registry order
+//------------------------------------------------------------------------------------------------------------------------------
+void AgentStore::Build(const AgentRegistry& registry)
+{
+	int numAgents = registry.GetNumAgents();
+	if (numAgents > (int)agentIDs.size())
+	{
+		Init(numAgents);
+	}
+	m_numAgents = numAgents;
+
+	int typeCursors[NUM_AGENT_TYPES + 1] = {};
+	for (int agentIndex = 0; agentIndex < m_numAgents; agentIndex++)
+	{
+		typeCursors[registry.GetAgent(agentIndex).type + 1]++;
+	}
+
+	for (int typeIndex = 0; typeIndex < NUM_AGENT_TYPES; typeIndex++)
+	{
+		typeCursors[typeIndex + 1] += typeCursors[typeIndex];
+	}
+
+	for (int typeIndex = 0; typeIndex <= NUM_AGENT_TYPES; typeIndex++)
+	{
+		m_typeStarts[typeIndex] = typeCursors[typeIndex];
+	}
+
+	for (int agentIndex = 0; agentIndex < m_numAgents; agentIndex++)
+	{
+		const Agent& agent = registry.GetAgent(agentIndex);
+		int storeIndex = typeCursors[agent.type]++;
+
+		agentIDs[storeIndex] = agent.agentID;
+		tileX[storeIndex] = agent.tileX;
+		tileY[storeIndex] = agent.tileY;
+		exhaustion[storeIndex] = agent.exhaustion;
+		states[storeIndex] = agent.state;
+		results[storeIndex] = agent.result;
+		registryIndices[storeIndex] = agentIndex;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int AgentStore::GetNumAgents() const
+{
+	return m_numAgents;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int AgentStore::GetTypeBegin(eAgentType type) const
+{
+	return m_typeStarts[type];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int AgentStore::GetTypeEnd(eAgentType type) const
+{
+	return m_typeStarts[type + 1];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int AgentStore::GetNumAgentsOfType(eAgentType type) const
+{
+	return m_typeStarts[type + 1] - m_typeStarts[type];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Everyone gets orders before sudden death only once they are rested, after it they keep moving regardless
+// The loop has no branches, every agent is written and only the ready ones advance the count
+//------------------------------------------------------------------------------------------------------------------------------
+int AgentStore::GatherReadyAgents(eAgentType type, bool isSuddenDeath, std::vector<int>& outRegistryIndices) const
+{
+	int begin = m_typeStarts[type];
+	int end = m_typeStarts[type + 1];
+
+	int firstOut = (int)outRegistryIndices.size();
+	outRegistryIndices.resize(firstOut + end - begin);
+
+	int* out = outRegistryIndices.data() + firstOut;
+	int numReady = 0;
+
+	for (int storeIndex = begin; storeIndex < end; storeIndex++)
+	{
+		int isReady = (states[storeIndex] != STATE_DEAD) & (isSuddenDeath | (exhaustion[storeIndex] == 0));
+
+		out[numReady] = registryIndices[storeIndex];
+		numReady += isReady;
+	}
+
+	outRegistryIndices.resize(firstOut + numReady);
+	return numReady;
+}
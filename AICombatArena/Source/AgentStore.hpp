@@ -0,0 +1,37 @@
+#pragma once
+#include <vector>
+#include "ArenaPlayerInterface.hpp"
+#include "AgentRegistry.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Structure of arrays copy of the fields the per-turn passes filter on, rebuilt from the registry every turn
+// Agents of each type sit in one contiguous partition, in registry order within it, so a pass like "every ready
+// worker" walks a few dense arrays instead of every Agent and its path
+//------------------------------------------------------------------------------------------------------------------------------
+class AgentStore
+{
+public:
+	void				Init(int maxAgents);
+	void				Build(const AgentRegistry& registry);
+
+	int					GetNumAgents() const;
+	int					GetTypeBegin(eAgentType type) const;
+	int					GetTypeEnd(eAgentType type) const;
+	int					GetNumAgentsOfType(eAgentType type) const;
+
+	//Appends the registry index of every agent of the type that can take an order this turn, returns how many
+	int					GatherReadyAgents(eAgentType type, bool isSuddenDeath, std::vector<int>& outRegistryIndices) const;
+
+public:
+	std::vector<AgentID>				agentIDs;
+	std::vector<short>					tileX;
+	std::vector<short>					tileY;
+	std::vector<short>					exhaustion;
+	std::vector<eAgentState>			states;
+	std::vector<eAgentOrderResult>		results;
+	std::vector<int>					registryIndices;	//Where the full Agent, and with it the path, lives in the registry
+
+private:
+	int					m_numAgents = 0;
+	int					m_typeStarts[NUM_AGENT_TYPES + 1] = {};
+};
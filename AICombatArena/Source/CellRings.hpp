@@ -0,0 +1,36 @@
+#pragma once
+
+//------------------------------------------------------------------------------------------------------------------------------
+// The ring walk behind the nearest queries of grids bucketed into square cells of cellSize tiles. Visits square rings of
+// cells outward from the center cell, calling visitCell(cellX, cellY) for each cell of the ring on the grid
+// Every tile in ring r is at least (r - 1) cells worth of tiles away from the center cell, so before each ring after
+// the first isDone(ringLowerBound) says whether what was found so far already beats that, and the walk stops if it does
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename DoneFunction, typename VisitFunction>
+void VisitCellRings(int centerX, int centerY, int cellsPerRow, int cellSize, DoneFunction isDone, VisitFunction visitCell)
+{
+	for (int ring = 0; ring < cellsPerRow; ring++)
+	{
+		int ringLowerBound = (ring - 1) * cellSize + 1;
+		if (ring > 0 && isDone(ringLowerBound))
+			break;
+
+		for (int cellY = centerY - ring; cellY <= centerY + ring; cellY++)
+		{
+			if (cellY < 0 || cellY >= cellsPerRow)
+				continue;
+
+			//Rows in the middle of the ring only have their two end cells on it
+			bool isEdgeRow = cellY == centerY - ring || cellY == centerY + ring;
+			int cellStep = (isEdgeRow || ring == 0) ? 1 : ring * 2;
+
+			for (int cellX = centerX - ring; cellX <= centerX + ring; cellX += cellStep)
+			{
+				if (cellX < 0 || cellX >= cellsPerRow)
+					continue;
+
+				visitCell(cellX, cellY);
+			}
+		}
+	}
+}
@@ -7,12 +7,18 @@
 #define PLATFORM_WINDOWS
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
+#define DEBUG_BREAK()	__debugbreak()
+#define SHOW_CURSOR()	ShowCursor( TRUE )
+#else
+#define DEBUG_BREAK()	__builtin_trap()
+#define SHOW_CURSOR()
 #endif
 
 //------------------------------------------------------------------------------------------------------------------------------
 #include "ErrorWarningAssert.hpp"
 #include "StringUtils.hpp"
 #include <stdarg.h>
+#include <string.h>
 #include <iostream>
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -46,7 +52,11 @@ void DebuggerPrintf( const char* messageFormat, ... )
 	char messageLiteral[ MESSAGE_MAX_LENGTH ];
 	va_list variableArgumentList;
 	va_start( variableArgumentList, messageFormat );
+#if defined( PLATFORM_WINDOWS )
 	vsnprintf_s( messageLiteral, MESSAGE_MAX_LENGTH, _TRUNCATE, messageFormat, variableArgumentList );
+#else
+	vsnprintf( messageLiteral, MESSAGE_MAX_LENGTH, messageFormat, variableArgumentList );
+#endif
 	va_end( variableArgumentList );
 	messageLiteral[ MESSAGE_MAX_LENGTH - 1 ] = '\0'; // In case vsnprintf overran (doesn't auto-terminate)
 
@@ -104,7 +114,7 @@ void SystemDialogue_Okay( const std::string& messageTitle, const std::string& me
 {
 	#if defined( PLATFORM_WINDOWS )
 	{
-		ShowCursor( TRUE );
+		SHOW_CURSOR();
 		UINT dialogueIconTypeFlag = GetWindowsMessageBoxIconFlagForSeverityLevel( severity );
 		MessageBoxA( NULL, messageText.c_str(), messageTitle.c_str(), MB_OK | dialogueIconTypeFlag | MB_TOPMOST );
 		ShowCursor( FALSE );
@@ -121,7 +131,7 @@ bool SystemDialogue_OkayCancel( const std::string& messageTitle, const std::stri
 
 	#if defined( PLATFORM_WINDOWS )
 	{
-		ShowCursor( TRUE );
+		SHOW_CURSOR();
 		UINT dialogueIconTypeFlag = GetWindowsMessageBoxIconFlagForSeverityLevel( severity );
 		int buttonClicked = MessageBoxA( NULL, messageText.c_str(), messageTitle.c_str(), MB_OKCANCEL | dialogueIconTypeFlag | MB_TOPMOST );
 		isAnswerOkay = (buttonClicked == IDOK);
@@ -141,7 +151,7 @@ bool SystemDialogue_YesNo( const std::string& messageTitle, const std::string& m
 
 	#if defined( PLATFORM_WINDOWS )
 	{
-		ShowCursor( TRUE );
+		SHOW_CURSOR();
 		UINT dialogueIconTypeFlag = GetWindowsMessageBoxIconFlagForSeverityLevel( severity );
 		int buttonClicked = MessageBoxA( NULL, messageText.c_str(), messageTitle.c_str(), MB_YESNO | dialogueIconTypeFlag | MB_TOPMOST );
 		isAnswerYes = (buttonClicked == IDYES);
@@ -161,7 +171,7 @@ int SystemDialogue_YesNoCancel( const std::string& messageTitle, const std::stri
 
 	#if defined( PLATFORM_WINDOWS )
 	{
-		ShowCursor( TRUE );
+		SHOW_CURSOR();
 		UINT dialogueIconTypeFlag = GetWindowsMessageBoxIconFlagForSeverityLevel( severity );
 		int buttonClicked = MessageBoxA( NULL, messageText.c_str(), messageTitle.c_str(), MB_YESNOCANCEL | dialogueIconTypeFlag | MB_TOPMOST );
 		answerCode = (buttonClicked == IDYES ? 1 : (buttonClicked == IDNO ? 0 : -1) );
@@ -173,7 +183,7 @@ int SystemDialogue_YesNoCancel( const std::string& messageTitle, const std::stri
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-__declspec( noreturn ) void FatalError( const char* filePath, const char* functionName, int lineNum, const std::string& reasonForError, const char* conditionText )
+[[noreturn]] void FatalError( const char* filePath, const char* functionName, int lineNum, const std::string& reasonForError, const char* conditionText )
 {
 	std::string errorMessage = reasonForError;
 	if( reasonForError.empty() )
@@ -190,7 +200,7 @@ __declspec( noreturn ) void FatalError( const char* filePath, const char* functi
 	std::string fullMessageTitle = appName + " :: Error";
 	std::string fullMessageText = errorMessage;
 	fullMessageText += "\n\nThe application will now close.\n";
-	bool isDebuggerPresent = (IsDebuggerPresent() == TRUE);
+	bool isDebuggerPresent = IsDebuggerAvailable();
 	if( isDebuggerPresent )
 	{
 		fullMessageText += "\nDEBUGGER DETECTED!\nWould you like to break and debug?\n  (Yes=debug, No=quit)\n";
@@ -216,16 +226,16 @@ __declspec( noreturn ) void FatalError( const char* filePath, const char* functi
 	if( isDebuggerPresent )
 	{
 		bool isAnswerYes = SystemDialogue_YesNo( fullMessageTitle, fullMessageText, SEVERITY_FATAL );
-		ShowCursor( TRUE );
+		SHOW_CURSOR();
 		if( isAnswerYes )
 		{
-			__debugbreak();
+			DEBUG_BREAK();
 		}
 	}
 	else
 	{
 		SystemDialogue_Okay( fullMessageTitle, fullMessageText, SEVERITY_FATAL );
-		ShowCursor( TRUE );
+		SHOW_CURSOR();
 	}
 
 	exit( 0 );
@@ -249,7 +259,7 @@ void RecoverableWarning( const char* filePath, const char* functionName, int lin
 	std::string fullMessageTitle = appName + " :: Warning";
 	std::string fullMessageText = errorMessage;
 
-	bool isDebuggerPresent = (IsDebuggerPresent() == TRUE);
+	bool isDebuggerPresent = IsDebuggerAvailable();
 	if( isDebuggerPresent )
 	{
 		fullMessageText += "\n\nDEBUGGER DETECTED!\nWould you like to continue running?\n  (Yes=continue, No=quit, Cancel=debug)\n";
@@ -279,20 +289,20 @@ void RecoverableWarning( const char* filePath, const char* functionName, int lin
 	if( isDebuggerPresent )
 	{
 		int answerCode = SystemDialogue_YesNoCancel( fullMessageTitle, fullMessageText, SEVERITY_WARNING );
-		ShowCursor( TRUE );
+		SHOW_CURSOR();
 		if( answerCode == 0 ) // "NO"
 		{
 			exit( 0 );
 		}
 		else if( answerCode == -1 ) // "CANCEL"
 		{
-			__debugbreak();
+			DEBUG_BREAK();
 		}
 	}
 	else
 	{
 		bool isAnswerYes = SystemDialogue_YesNo( fullMessageTitle, fullMessageText, SEVERITY_WARNING );
-		ShowCursor( TRUE );
+		SHOW_CURSOR();
 		if( !isAnswerYes )
 		{
 			exit( 0 );
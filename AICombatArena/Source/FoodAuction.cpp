@@ -0,0 +1,269 @@
+#include "FoodAuction.hpp"
+#include "AICommons.hpp"
+#include "AStarPathing.hpp"
+#include "MathUtils.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+void FoodAuction::Init(int mapWidth)
+{
+	m_mapWidth = mapWidth;
+
+	m_prices.assign(mapWidth * mapWidth, 0.f);
+	m_owners.assign(mapWidth * mapWidth, -1);
+	m_isCandidate.assign(mapWidth * mapWidth, false);
+	m_pricedTiles.clear();
+	m_lastPricedTiles.clear();
+
+	m_bidsPlaced = 0;
+	m_auctionsCutShort = 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// A worker bids on the candidate worth the most to it at current prices, raising the price by how much it prefers that
+// tile over its next best option plus epsilon, and takes the tile from whoever held it. The next best option might be
+// to stay without food, which is worth 0 to a worker
+// This is not guaranteed to be the cheapest assignment, the auction gives that up for fewer bids. From zero prices with
+// an epsilon under 1 / bidders it would be, but workers outbidding each other for the same few tiles then raise prices a
+// sliver at a time and run into the bid limit. FOOD_AUCTION_EPSILON is most of a step instead, and carried prices are
+// only dropped once the bidding settles, so a worker that won a tile is not checked again against a cheaper one
+//------------------------------------------------------------------------------------------------------------------------------
+int FoodAuction::Solve(const std::vector<FoodBidder_T>& bidders, const FoodIndex& foodIndex, float minStepCost,
+	const std::function<bool(int tileIndex)>& isFoodAvailable, std::vector<int>& outFoodTiles)
+{
+	int numBidders = (int)bidders.size();
+	outFoodTiles.assign(numBidders, -1);
+
+	CarryOverPrices();
+	GatherCandidates(bidders, foodIndex, minStepCost, isFoodAvailable);
+	DropNonCandidatePrices();
+
+	//Every candidate is worth more than having no food
+	float highestCost = 0.f;
+	for (int candidateIndex = 0; candidateIndex < (int)m_candidates.size(); candidateIndex++)
+	{
+		if (m_candidates[candidateIndex].tileIndex != -1 && m_candidates[candidateIndex].cost > highestCost)
+		{
+			highestCost = m_candidates[candidateIndex].cost;
+		}
+	}
+	float worthOfFood = highestCost + 1.f;
+
+	m_biddingQueue.clear();
+	for (int bidderIndex = 0; bidderIndex < numBidders; bidderIndex++)
+	{
+		if (m_numCandidates[bidderIndex] > 0)
+		{
+			m_biddingQueue.push_back(bidderIndex);
+		}
+	}
+
+	int maxBids = numBidders * FOOD_AUCTION_MAX_BIDS_PER_WORKER;
+	int numBids = 0;
+	int queueHead = 0;
+
+	while (numBids < maxBids)
+	{
+		//A carried candidate price can still be more than the tile is worth now. Once the bidding settles, drop the
+		//prices of carried tiles nobody holds and let the workers left without food bid again. Workers holding food
+		//keep it: letting them give it up for the cheaper tiles is exact, but the auction then cycles into the bid limit
+		if (queueHead == (int)m_biddingQueue.size())
+		{
+			if (!ClearUnwonPrices())
+				break;
+
+			for (int bidderIndex = 0; bidderIndex < numBidders; bidderIndex++)
+			{
+				if (outFoodTiles[bidderIndex] == -1 && m_numCandidates[bidderIndex] > 0)
+				{
+					m_biddingQueue.push_back(bidderIndex);
+				}
+			}
+
+			if (queueHead == (int)m_biddingQueue.size())
+				break;
+		}
+
+		int bidderIndex = m_biddingQueue[queueHead++];
+		const FoodCandidate_T* candidates = &m_candidates[bidderIndex * (FOOD_AUCTION_CANDIDATES + 1)];
+
+		int bestTile = -1;
+		float bestValue = 0.f;
+		float secondValue = 0.f;
+
+		for (int candidateIndex = 0; candidateIndex < m_numCandidates[bidderIndex]; candidateIndex++)
+		{
+			int tileIndex = candidates[candidateIndex].tileIndex;
+			float value = worthOfFood - candidates[candidateIndex].cost - m_prices[tileIndex];
+
+			if (value > bestValue)
+			{
+				secondValue = bestValue;
+				bestValue = value;
+				bestTile = tileIndex;
+			}
+			else if (value > secondValue)
+			{
+				secondValue = value;
+			}
+		}
+
+		//Every tile costs more than it is worth to this worker now, it sits this turn out
+		if (bestTile == -1)
+			continue;
+
+		m_prices[bestTile] += bestValue - secondValue + FOOD_AUCTION_EPSILON;
+
+		int outbidIndex = m_owners[bestTile];
+		if (outbidIndex != -1)
+		{
+			outFoodTiles[outbidIndex] = -1;
+			m_biddingQueue.push_back(outbidIndex);
+		}
+		else
+		{
+			m_pricedTiles.push_back(bestTile);
+		}
+
+		m_owners[bestTile] = bidderIndex;
+		outFoodTiles[bidderIndex] = bestTile;
+		numBids++;
+	}
+
+	ClearUnwonPrices();
+	m_lastPricedTiles.clear();
+
+	m_bidsPlaced += numBids;
+	if (queueHead < (int)m_biddingQueue.size())
+	{
+		m_auctionsCutShort++;
+	}
+
+	int numAssigned = 0;
+	for (int bidderIndex = 0; bidderIndex < numBidders; bidderIndex++)
+	{
+		if (outFoodTiles[bidderIndex] != -1)
+		{
+			numAssigned++;
+		}
+	}
+
+	return numAssigned;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void FoodAuction::GatherCandidates(const std::vector<FoodBidder_T>& bidders, const FoodIndex& foodIndex, float minStepCost,
+	const std::function<bool(int tileIndex)>& isFoodAvailable)
+{
+	int numBidders = (int)bidders.size();
+	m_candidates.assign(numBidders * (FOOD_AUCTION_CANDIDATES + 1), FoodCandidate_T());
+	m_numCandidates.assign(numBidders, 0);
+
+	for (int bidderIndex = 0; bidderIndex < numBidders; bidderIndex++)
+	{
+		const FoodBidder_T& bidder = bidders[bidderIndex];
+
+		//The nearest food is the cheapest there is, if it can't be reached none can
+		if (bidder.nearestFoodTile == -1 || bidder.nearestFoodCost >= (float)ASTAR_IMPASSABLE_COST)
+			continue;
+
+		FoodCandidate_T* candidates = &m_candidates[bidderIndex * (FOOD_AUCTION_CANDIDATES + 1)];
+		int numCandidates = 0;
+		bool hasNearestFood = false;
+
+		foodIndex.FindNearestK(bidder.tile, FOOD_AUCTION_CANDIDATES, m_nearestTiles, isFoodAvailable);
+		for (int nearIndex = 0; nearIndex < (int)m_nearestTiles.size(); nearIndex++)
+		{
+			int tileIndex = m_nearestTiles[nearIndex];
+			float cost = bidder.nearestFoodCost;
+
+			if (tileIndex == bidder.nearestFoodTile)
+			{
+				hasNearestFood = true;
+			}
+			else
+			{
+				IntVec2 foodTile = IntVec2(tileIndex % m_mapWidth, tileIndex / m_mapWidth);
+				float stepBound = (float)GetManhattanDistance(bidder.tile, foodTile) * minStepCost;
+				cost = stepBound > cost ? stepBound : cost;
+			}
+
+			candidates[numCandidates].tileIndex = tileIndex;
+			candidates[numCandidates].cost = cost;
+			numCandidates++;
+		}
+
+		//The flow field's nearest food can be further by Manhattan distance than every tile found above
+		if (!hasNearestFood && isFoodAvailable(bidder.nearestFoodTile))
+		{
+			candidates[numCandidates].tileIndex = bidder.nearestFoodTile;
+			candidates[numCandidates].cost = bidder.nearestFoodCost;
+			numCandidates++;
+		}
+
+		m_numCandidates[bidderIndex] = numCandidates;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void FoodAuction::CarryOverPrices()
+{
+	m_lastPricedTiles.swap(m_pricedTiles);
+	m_pricedTiles.clear();
+
+	for (int pricedIndex = 0; pricedIndex < (int)m_lastPricedTiles.size(); pricedIndex++)
+	{
+		int tileIndex = m_lastPricedTiles[pricedIndex];
+		m_prices[tileIndex] *= FOOD_AUCTION_PRICE_CARRYOVER;
+		m_owners[tileIndex] = -1;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// A carried price on a tile no worker can bid on this turn would only be dropped once the bidding settles
+//------------------------------------------------------------------------------------------------------------------------------
+void FoodAuction::DropNonCandidatePrices()
+{
+	for (int candidateIndex = 0; candidateIndex < (int)m_candidates.size(); candidateIndex++)
+	{
+		if (m_candidates[candidateIndex].tileIndex != -1)
+		{
+			m_isCandidate[m_candidates[candidateIndex].tileIndex] = true;
+		}
+	}
+
+	for (int pricedIndex = 0; pricedIndex < (int)m_lastPricedTiles.size(); pricedIndex++)
+	{
+		int tileIndex = m_lastPricedTiles[pricedIndex];
+		if (!m_isCandidate[tileIndex])
+		{
+			m_prices[tileIndex] = 0.f;
+		}
+	}
+
+	for (int candidateIndex = 0; candidateIndex < (int)m_candidates.size(); candidateIndex++)
+	{
+		if (m_candidates[candidateIndex].tileIndex != -1)
+		{
+			m_isCandidate[m_candidates[candidateIndex].tileIndex] = false;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Only tiles someone won keep a price, a tile nobody holds has to be the cheapest for the auction to be fair to it
+//------------------------------------------------------------------------------------------------------------------------------
+bool FoodAuction::ClearUnwonPrices()
+{
+	bool anyCleared = false;
+	for (int pricedIndex = 0; pricedIndex < (int)m_lastPricedTiles.size(); pricedIndex++)
+	{
+		int tileIndex = m_lastPricedTiles[pricedIndex];
+		if (m_owners[tileIndex] == -1 && m_prices[tileIndex] > 0.f)
+		{
+			m_prices[tileIndex] = 0.f;
+			anyCleared = true;
+		}
+	}
+
+	return anyCleared;
+}
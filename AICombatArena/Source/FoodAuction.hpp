@@ -0,0 +1,65 @@
+#pragma once
+#include <vector>
+#include <functional>
+#include "IntVec2.hpp"
+#include "ArenaPlayerInterface.hpp"
+#include "FoodIndex.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+// An idle worker taking part in the food auction. The nearest food and its path cost come from the food flow field
+struct FoodBidder_T
+{
+	AgentID		agentID = 0;
+	IntVec2		tile = IntVec2(-1, -1);
+	int			nearestFoodTile = -1;
+	float		nearestFoodCost = 0.f;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct FoodCandidate_T
+{
+	int			tileIndex = -1;
+	float		cost = 0.f;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Matches idle workers to food tiles with a forward auction, so the turn's assignment has close to the lowest total path
+// cost instead of depending on which worker happened to look first. Close to, not the lowest: see Solve
+// Each worker bids on its FOOD_AUCTION_CANDIDATES closest food tiles. The cost of its nearest food is the exact flow
+// field distance, the others get a lower bound: no food is cheaper than the nearest one, and no step cheaper than
+// minStepCost. Prices of the tiles won last turn carry over in part, so a turn like the last settles in a few bids.
+// Carried prices on tiles nobody can bid on this turn are dropped before the bidding starts
+//------------------------------------------------------------------------------------------------------------------------------
+class FoodAuction
+{
+public:
+	void			Init(int mapWidth);
+
+	//outFoodTiles gets one entry per bidder, -1 for bidders left without food. Returns how many got food
+	int				Solve(const std::vector<FoodBidder_T>& bidders, const FoodIndex& foodIndex, float minStepCost,
+						const std::function<bool(int tileIndex)>& isFoodAvailable, std::vector<int>& outFoodTiles);
+
+	unsigned long long	m_bidsPlaced = 0;
+	int				m_auctionsCutShort = 0;		//Hit the bid limit before every worker settled
+
+private:
+	void			GatherCandidates(const std::vector<FoodBidder_T>& bidders, const FoodIndex& foodIndex, float minStepCost,
+						const std::function<bool(int tileIndex)>& isFoodAvailable);
+	void			CarryOverPrices();
+	void			DropNonCandidatePrices();
+	bool			ClearUnwonPrices();		//Returns true if any price was dropped
+
+private:
+	int								m_mapWidth = 0;
+
+	std::vector<float>				m_prices;			//Per tile
+	std::vector<int>				m_owners;			//Per tile, bidder index or -1
+	std::vector<bool>				m_isCandidate;		//Per tile, only set between GatherCandidates and DropNonCandidatePrices
+	std::vector<int>				m_pricedTiles;		//Tiles won in this auction, the only ones with a price after it
+	std::vector<int>				m_lastPricedTiles;	//Tiles won in the last auction
+
+	std::vector<FoodCandidate_T>	m_candidates;		//FOOD_AUCTION_CANDIDATES + 1 slots per bidder
+	std::vector<int>				m_numCandidates;	//Per bidder
+	std::vector<int>				m_biddingQueue;
+	std::vector<int>				m_nearestTiles;
+};
@@ -0,0 +1,98 @@
+#include "FoodClaimTable.hpp"
+#include "AICommons.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+void FoodClaimTable::Init(int mapWidth)
+{
+	m_currentTurn = 0;
+	m_claimsExpired = 0;
+
+	m_expiryTurns.assign(mapWidth * mapWidth, -1);
+	m_claimants.assign(mapWidth * mapWidth, 0);
+
+	m_tilesByAgent.clear();
+	m_tilesByAgent.reserve(MAX_AGENTS_PER_PLAYER);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Walks the claims rather than the tiles, there are never more than we have workers
+//------------------------------------------------------------------------------------------------------------------------------
+void FoodClaimTable::BeginTurn(int turnNumber)
+{
+	m_currentTurn = turnNumber;
+
+	std::unordered_map<AgentID, int>::iterator itr = m_tilesByAgent.begin();
+	while (itr != m_tilesByAgent.end())
+	{
+		int tileIndex = itr->second;
+		if (m_expiryTurns[tileIndex] > m_currentTurn)
+		{
+			itr++;
+			continue;
+		}
+
+		m_expiryTurns[tileIndex] = -1;
+		m_claimsExpired++;
+		itr = m_tilesByAgent.erase(itr);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void FoodClaimTable::Claim(int tileIndex, AgentID agentID)
+{
+	ReleaseAgent(agentID);
+	ReleaseTile(tileIndex);
+
+	m_expiryTurns[tileIndex] = m_currentTurn + FOOD_CLAIM_TURNS;
+	m_claimants[tileIndex] = agentID;
+	m_tilesByAgent[agentID] = tileIndex;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void FoodClaimTable::ReleaseTile(int tileIndex)
+{
+	if (m_expiryTurns[tileIndex] == -1)
+		return;
+
+	m_tilesByAgent.erase(m_claimants[tileIndex]);
+	m_expiryTurns[tileIndex] = -1;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void FoodClaimTable::ReleaseAgent(AgentID agentID)
+{
+	std::unordered_map<AgentID, int>::iterator itr = m_tilesByAgent.find(agentID);
+	if (itr == m_tilesByAgent.end())
+		return;
+
+	m_expiryTurns[itr->second] = -1;
+	m_tilesByAgent.erase(itr);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool FoodClaimTable::IsClaimed(int tileIndex) const
+{
+	return m_expiryTurns[tileIndex] > m_currentTurn;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool FoodClaimTable::IsClaimedByOther(int tileIndex, AgentID agentID) const
+{
+	return IsClaimed(tileIndex) && m_claimants[tileIndex] != agentID;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int FoodClaimTable::GetClaimedTile(AgentID agentID) const
+{
+	std::unordered_map<AgentID, int>::const_iterator itr = m_tilesByAgent.find(agentID);
+	if (itr == m_tilesByAgent.end() || !IsClaimed(itr->second))
+		return -1;
+
+	return itr->second;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int FoodClaimTable::GetNumClaims() const
+{
+	return (int)m_tilesByAgent.size();
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include "ArenaPlayerInterface.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct FoodClaim_T
+{
+	int			tileIndex = -1;
+	AgentID		agentID = 0;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Which worker is heading for which food tile. A worker holds at most one claim and a tile at most one claimant
+// Claims run out FOOD_CLAIM_TURNS after they were last made, so food whose worker died or wandered off comes back
+//------------------------------------------------------------------------------------------------------------------------------
+class FoodClaimTable
+{
+public:
+	void			Init(int mapWidth);
+	void			BeginTurn(int turnNumber);					//Drops the claims that ran out
+
+	void			Claim(int tileIndex, AgentID agentID);		//Replaces the agent's old claim and the tile's old claimant
+	void			ReleaseTile(int tileIndex);
+	void			ReleaseAgent(AgentID agentID);
+
+	bool			IsClaimed(int tileIndex) const;
+	bool			IsClaimedByOther(int tileIndex, AgentID agentID) const;
+	int				GetClaimedTile(AgentID agentID) const;		//-1 if the agent holds no claim
+	int				GetNumClaims() const;
+
+	int				m_claimsExpired = 0;
+
+private:
+	int									m_currentTurn = 0;
+
+	std::vector<int>					m_expiryTurns;		//Per tile, the first turn the claim no longer holds, -1 if unclaimed
+	std::vector<AgentID>				m_claimants;		//Per tile, only meaningful while claimed
+	std::unordered_map<AgentID, int>	m_tilesByAgent;
+};
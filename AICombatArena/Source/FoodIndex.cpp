@@ -0,0 +1,175 @@
+#include "FoodIndex.hpp"
+#include "MathUtils.hpp"
+#include "CellRings.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Ranks candidates for the nearest queries: closer first, then the higher tile index
+static bool IsBetterFood(int distance, int tileIndex, int otherDistance, int otherTileIndex)
+{
+	return distance < otherDistance || (distance == otherDistance && tileIndex > otherTileIndex);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void FoodIndex::Init(int mapWidth)
+{
+	m_mapWidth = mapWidth;
+	m_cellsPerRow = (mapWidth + FOOD_INDEX_CELL_SIZE - 1) / FOOD_INDEX_CELL_SIZE;
+
+	m_foodTiles.clear();
+	m_foodTiles.reserve(mapWidth * mapWidth / 4);
+	m_slotInFoodTiles.assign(mapWidth * mapWidth, -1);
+	m_slotInCell.assign(mapWidth * mapWidth, -1);
+
+	m_cellFood.clear();
+	m_cellFood.resize(m_cellsPerRow * m_cellsPerRow);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void FoodIndex::Clear()
+{
+	for (int foodIndex = 0; foodIndex < (int)m_foodTiles.size(); foodIndex++)
+	{
+		m_slotInFoodTiles[m_foodTiles[foodIndex]] = -1;
+		m_slotInCell[m_foodTiles[foodIndex]] = -1;
+	}
+
+	m_foodTiles.clear();
+
+	for (int cellIndex = 0; cellIndex < (int)m_cellFood.size(); cellIndex++)
+	{
+		m_cellFood[cellIndex].clear();
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool FoodIndex::Add(int tileIndex)
+{
+	if (m_slotInFoodTiles[tileIndex] != -1)
+		return false;
+
+	m_slotInFoodTiles[tileIndex] = (int)m_foodTiles.size();
+	m_foodTiles.push_back(tileIndex);
+
+	std::vector<int>& cell = m_cellFood[GetCellIndex(tileIndex)];
+	m_slotInCell[tileIndex] = (int)cell.size();
+	cell.push_back(tileIndex);
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Swaps the last entry into the removed one's place, both in the dense list and in the cell
+//------------------------------------------------------------------------------------------------------------------------------
+bool FoodIndex::Remove(int tileIndex)
+{
+	int slot = m_slotInFoodTiles[tileIndex];
+	if (slot == -1)
+		return false;
+
+	int lastTile = m_foodTiles.back();
+	m_foodTiles[slot] = lastTile;
+	m_slotInFoodTiles[lastTile] = slot;
+	m_foodTiles.pop_back();
+	m_slotInFoodTiles[tileIndex] = -1;
+
+	std::vector<int>& cell = m_cellFood[GetCellIndex(tileIndex)];
+	int cellSlot = m_slotInCell[tileIndex];
+	int lastCellTile = cell.back();
+	cell[cellSlot] = lastCellTile;
+	m_slotInCell[lastCellTile] = cellSlot;
+	cell.pop_back();
+	m_slotInCell[tileIndex] = -1;
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool FoodIndex::HasFood(int tileIndex) const
+{
+	return m_slotInFoodTiles[tileIndex] != -1;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int FoodIndex::GetNumFood() const
+{
+	return (int)m_foodTiles.size();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const std::vector<int>& FoodIndex::GetFoodTiles() const
+{
+	return m_foodTiles;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int FoodIndex::FindNearest(const IntVec2& tile, const std::function<bool(int tileIndex)>& isCandidate) const
+{
+	//Chunks query from several threads at once
+	static thread_local std::vector<int> nearestTiles;
+	FindNearestK(tile, 1, nearestTiles, isCandidate);
+
+	return nearestTiles.size() > 0 ? nearestTiles[0] : -1;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Keeps the k best in a small sorted list while walking the cell rings out from the tile's cell. Once the list is full
+// and its worst entry beats everything further out, the walk stops
+//------------------------------------------------------------------------------------------------------------------------------
+int FoodIndex::FindNearestK(const IntVec2& tile, int k, std::vector<int>& outTileIndices, const std::function<bool(int tileIndex)>& isCandidate) const
+{
+	outTileIndices.clear();
+	if (k <= 0 || m_foodTiles.empty())
+		return 0;
+
+	static thread_local std::vector<int> bestDistances;
+	bestDistances.clear();
+
+	VisitCellRings(tile.x / FOOD_INDEX_CELL_SIZE, tile.y / FOOD_INDEX_CELL_SIZE, m_cellsPerRow, FOOD_INDEX_CELL_SIZE,
+		[&](int ringLowerBound) { return (int)outTileIndices.size() == k && bestDistances.back() < ringLowerBound; },
+		[&](int cellX, int cellY) { SearchCell(cellY * m_cellsPerRow + cellX, tile, k, outTileIndices, bestDistances, isCandidate); });
+
+	return (int)outTileIndices.size();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void FoodIndex::SearchCell(int cellIndex, const IntVec2& tile, int k, std::vector<int>& bestTileIndices, std::vector<int>& bestDistances, const std::function<bool(int tileIndex)>& isCandidate) const
+{
+	const std::vector<int>& cell = m_cellFood[cellIndex];
+	for (int cellSlot = 0; cellSlot < (int)cell.size(); cellSlot++)
+	{
+		int tileIndex = cell[cellSlot];
+		int distance = GetManhattanDistance(tile, IntVec2(tileIndex % m_mapWidth, tileIndex / m_mapWidth));
+
+		bool isFull = (int)bestTileIndices.size() == k;
+		if (isFull && !IsBetterFood(distance, tileIndex, bestDistances.back(), bestTileIndices.back()))
+			continue;
+
+		if (!isCandidate(tileIndex))
+			continue;
+
+		if (isFull)
+		{
+			bestTileIndices.pop_back();
+			bestDistances.pop_back();
+		}
+
+		//Insertion sort, k is small
+		int insertAt = (int)bestTileIndices.size();
+		while (insertAt > 0 && IsBetterFood(distance, tileIndex, bestDistances[insertAt - 1], bestTileIndices[insertAt - 1]))
+		{
+			insertAt--;
+		}
+
+		bestTileIndices.insert(bestTileIndices.begin() + insertAt, tileIndex);
+		bestDistances.insert(bestDistances.begin() + insertAt, distance);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int FoodIndex::GetCellIndex(int tileIndex) const
+{
+	int cellX = (tileIndex % m_mapWidth) / FOOD_INDEX_CELL_SIZE;
+	int cellY = (tileIndex / m_mapWidth) / FOOD_INDEX_CELL_SIZE;
+
+	return cellY * m_cellsPerRow + cellX;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <vector>
+#include <functional>
+#include "IntVec2.hpp"
+
+constexpr int FOOD_INDEX_CELL_SIZE = 8;		//Tiles per cell side
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Every food tile we know of, kept both as a dense list and bucketed by map cell
+// Adding and removing are O(1), so it is kept up to date as food is seen or eaten instead of being rebuilt, and
+// nearest queries search cell rings outward from the asker so they cost about the food nearby rather than the map area
+//------------------------------------------------------------------------------------------------------------------------------
+class FoodIndex
+{
+public:
+	void			Init(int mapWidth);
+	void			Clear();
+
+	bool			Add(int tileIndex);			//False if the tile is already in
+	bool			Remove(int tileIndex);		//False if the tile wasn't in
+	bool			HasFood(int tileIndex) const;
+
+	int				GetNumFood() const;
+	const std::vector<int>&	GetFoodTiles() const;	//In no particular order
+
+	//Closest food tile by Manhattan distance, ties go to the higher tile index like the tile scans this replaced did
+	//Returns -1 if no tile passes isCandidate
+	int				FindNearest(const IntVec2& tile, const std::function<bool(int tileIndex)>& isCandidate) const;
+
+	//Up to k tiles, closest first. Returns how many were found
+	int				FindNearestK(const IntVec2& tile, int k, std::vector<int>& outTileIndices, const std::function<bool(int tileIndex)>& isCandidate) const;
+
+private:
+	int				GetCellIndex(int tileIndex) const;
+	void			SearchCell(int cellIndex, const IntVec2& tile, int k, std::vector<int>& bestTileIndices, std::vector<int>& bestDistances, const std::function<bool(int tileIndex)>& isCandidate) const;
+
+private:
+	int								m_mapWidth = 0;
+	int								m_cellsPerRow = 0;
+
+	std::vector<int>				m_foodTiles;
+	std::vector<int>				m_slotInFoodTiles;		//Per tile, -1 when the tile has no food
+	std::vector<std::vector<int>>	m_cellFood;				//Food tiles in each cell
+	std::vector<int>				m_slotInCell;			//Per tile, where it sits in its cell's list
+};
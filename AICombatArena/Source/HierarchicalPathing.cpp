@@ -0,0 +1,571 @@
+#include "HierarchicalPathing.hpp"
+#include "MathUtils.hpp"
+#include "AICommons.hpp"
+#include <algorithm>
+
+//------------------------------------------------------------------------------------------------------------------------------
+void HierarchicalPather::Init(const IntVec2& mapDimensions)
+{
+	m_mapDimensions = mapDimensions;
+	m_clusterCounts.x = (mapDimensions.x + HPA_CLUSTER_SIZE - 1) / HPA_CLUSTER_SIZE;
+	m_clusterCounts.y = (mapDimensions.y + HPA_CLUSTER_SIZE - 1) / HPA_CLUSTER_SIZE;
+
+	m_clusters.clear();
+	m_clusters.resize(m_clusterCounts.x * m_clusterCounts.y);
+
+	for (int clusterY = 0; clusterY < m_clusterCounts.y; clusterY++)
+	{
+		for (int clusterX = 0; clusterX < m_clusterCounts.x; clusterX++)
+		{
+			HPACluster_T& cluster = m_clusters[clusterY * m_clusterCounts.x + clusterX];
+			cluster.mins = IntVec2(clusterX * HPA_CLUSTER_SIZE, clusterY * HPA_CLUSTER_SIZE);
+			cluster.size.x = GetLowerValue(HPA_CLUSTER_SIZE, mapDimensions.x - cluster.mins.x);
+			cluster.size.y = GetLowerValue(HPA_CLUSTER_SIZE, mapDimensions.y - cluster.mins.y);
+			cluster.isDirty = true;
+		}
+	}
+
+	//Costs start out invalid so the first UpdateCosts builds every cluster
+	m_tileCosts.clear();
+	m_tileCosts.resize(mapDimensions.x * mapDimensions.y, -1);
+
+	InitQueryContext(m_queryContext, mapDimensions);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC void HierarchicalPather::InitQueryContext(HPAQueryContext_T& context, const IntVec2& mapDimensions)
+{
+	int mapSize = mapDimensions.x * mapDimensions.y;
+
+	context.floodCosts.resize(HPA_CLUSTER_SIZE * HPA_CLUSTER_SIZE);
+	context.floodParents.resize(HPA_CLUSTER_SIZE * HPA_CLUSTER_SIZE);
+	context.floodOpenList.Init(HPA_CLUSTER_SIZE * HPA_CLUSTER_SIZE);
+
+	context.searchGCosts.resize(mapSize);
+	context.searchParents.resize(mapSize);
+	context.searchFinished.resize(mapSize);
+	context.searchGenerations.clear();
+	context.searchGenerations.resize(mapSize, 0);
+	context.searchGeneration = 0;
+	context.searchOpenList.Init(mapSize);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Copies in the latest costs and rebuilds only the clusters touched by tiles whose cost changed
+//------------------------------------------------------------------------------------------------------------------------------
+void HierarchicalPather::UpdateCosts(const std::vector<int>& tileCosts)
+{
+	for (int tileIndex = 0; tileIndex < (int)m_tileCosts.size(); tileIndex++)
+	{
+		if (m_tileCosts[tileIndex] != tileCosts[tileIndex])
+		{
+			m_tileCosts[tileIndex] = tileCosts[tileIndex];
+			MarkTileDirty(tileIndex);
+		}
+	}
+
+	RebuildDirtyClusters();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Same as above when the caller already knows which tiles may have changed, the rest of the map isn't compared
+//------------------------------------------------------------------------------------------------------------------------------
+void HierarchicalPather::UpdateCosts(const std::vector<int>& tileCosts, const std::vector<int>& changedTiles)
+{
+	for (int changeIndex = 0; changeIndex < (int)changedTiles.size(); changeIndex++)
+	{
+		int tileIndex = changedTiles[changeIndex];
+		if (m_tileCosts[tileIndex] != tileCosts[tileIndex])
+		{
+			m_tileCosts[tileIndex] = tileCosts[tileIndex];
+			MarkTileDirty(tileIndex);
+		}
+	}
+
+	RebuildDirtyClusters();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void HierarchicalPather::RebuildDirtyClusters()
+{
+	for (int clusterIndex = 0; clusterIndex < (int)m_clusters.size(); clusterIndex++)
+	{
+		if (m_clusters[clusterIndex].isDirty)
+		{
+			RebuildCluster(clusterIndex);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+Path HierarchicalPather::CreatePath(int startTileIndex, int endTileIndex)
+{
+	return CreatePath(startTileIndex, endTileIndex, m_queryContext);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Returns the path ordered end first without the start tile (same as AStarPather), or an empty path if there is none
+// Only reads the cluster graph, so threads can query at the same time as long as each passes its own context
+//------------------------------------------------------------------------------------------------------------------------------
+Path HierarchicalPather::CreatePath(int startTileIndex, int endTileIndex, HPAQueryContext_T& context) const
+{
+	Path path;
+	if (startTileIndex == endTileIndex || m_clusters.empty() || !IsTilePassable(endTileIndex))
+	{
+		return path;
+	}
+
+	const HPACluster_T& startCluster = m_clusters[GetClusterIndexForTile(startTileIndex)];
+	const HPACluster_T& endCluster = m_clusters[GetClusterIndexForTile(endTileIndex)];
+
+	//Connect the start to the entrances of its cluster (and to the end if they share a cluster)
+	std::vector<int> startEdgeTiles;
+	std::vector<int> startEdgeCosts;
+	FloodCluster(context, startCluster, startTileIndex, false);
+	for (int slot = 0; slot < (int)startCluster.nodes.size(); slot++)
+	{
+		int cost = GetFloodCost(context, startCluster, startCluster.nodes[slot].tileIndex);
+		if (cost != INT_MAX)
+		{
+			startEdgeTiles.push_back(startCluster.nodes[slot].tileIndex);
+			startEdgeCosts.push_back(cost);
+		}
+	}
+	if (&startCluster == &endCluster && GetFloodCost(context, startCluster, endTileIndex) != INT_MAX)
+	{
+		startEdgeTiles.push_back(endTileIndex);
+		startEdgeCosts.push_back(GetFloodCost(context, startCluster, endTileIndex));
+	}
+
+	//Connect the entrances of the end cluster to the end
+	std::vector<int> endEdgeCosts;
+	FloodCluster(context, endCluster, endTileIndex, true);
+	for (int slot = 0; slot < (int)endCluster.nodes.size(); slot++)
+	{
+		endEdgeCosts.push_back(GetFloodCost(context, endCluster, endCluster.nodes[slot].tileIndex));
+	}
+
+	//A* over the abstract graph
+	StartNewSearch(context);
+	OpenOrDecreaseNode(context, startTileIndex, -1, 0, endTileIndex);
+
+	bool foundEnd = false;
+	while (!context.searchOpenList.IsEmpty())
+	{
+		int currentTile = context.searchOpenList.Pop();
+		context.nodesExpanded++;
+		context.searchFinished[currentTile] = true;
+
+		if (currentTile == endTileIndex)
+		{
+			foundEnd = true;
+			break;
+		}
+
+		int gCost = context.searchGCosts[currentTile];
+
+		if (currentTile == startTileIndex)
+		{
+			for (int edgeIndex = 0; edgeIndex < (int)startEdgeTiles.size(); edgeIndex++)
+			{
+				OpenOrDecreaseNode(context, startEdgeTiles[edgeIndex], currentTile, gCost + startEdgeCosts[edgeIndex], endTileIndex);
+			}
+		}
+
+		const HPACluster_T& cluster = m_clusters[GetClusterIndexForTile(currentTile)];
+		int slot = GetNodeSlot(cluster, currentTile);
+		if (slot == -1)
+			continue;
+
+		const HPANode_T& node = cluster.nodes[slot];
+		int numNodes = (int)cluster.nodes.size();
+		for (int otherSlot = 0; otherSlot < numNodes; otherSlot++)
+		{
+			int intraCost = cluster.intraCosts[slot * numNodes + otherSlot];
+			if (otherSlot != slot && intraCost != INT_MAX)
+			{
+				OpenOrDecreaseNode(context, cluster.nodes[otherSlot].tileIndex, currentTile, gCost + intraCost, endTileIndex);
+			}
+		}
+
+		for (int edgeIndex = 0; edgeIndex < (int)node.interEdgeTiles.size(); edgeIndex++)
+		{
+			OpenOrDecreaseNode(context, node.interEdgeTiles[edgeIndex], currentTile, gCost + node.interEdgeCosts[edgeIndex], endTileIndex);
+		}
+
+		if (&cluster == &endCluster && endEdgeCosts[slot] != INT_MAX)
+		{
+			OpenOrDecreaseNode(context, endTileIndex, currentTile, gCost + endEdgeCosts[slot], endTileIndex);
+		}
+	}
+
+	context.searchOpenList.Clear();
+
+	if (!foundEnd)
+	{
+		return path;
+	}
+
+	//Walk the abstract path back to the start
+	std::vector<int> abstractTiles;
+	for (int tileIndex = endTileIndex; tileIndex != -1; tileIndex = context.searchParents[tileIndex])
+	{
+		abstractTiles.push_back(tileIndex);
+	}
+	std::reverse(abstractTiles.begin(), abstractTiles.end());
+
+	//Refine each abstract edge into tiles; inter edges are a single step across a border
+	std::vector<int> refinedTiles;
+	for (int abstractIndex = 1; abstractIndex < (int)abstractTiles.size(); abstractIndex++)
+	{
+		int fromTile = abstractTiles[abstractIndex - 1];
+		int toTile = abstractTiles[abstractIndex];
+
+		int fromCluster = GetClusterIndexForTile(fromTile);
+		if (fromCluster != GetClusterIndexForTile(toTile))
+		{
+			refinedTiles.push_back(toTile);
+		}
+		else
+		{
+			AppendRefinedSegment(context, m_clusters[fromCluster], fromTile, toTile, refinedTiles);
+		}
+	}
+
+	for (int refinedIndex = (int)refinedTiles.size() - 1; refinedIndex >= 0; refinedIndex--)
+	{
+		path.push_back(IntVec2(refinedTiles[refinedIndex] % m_mapDimensions.x, refinedTiles[refinedIndex] / m_mapDimensions.x));
+	}
+
+	return path;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int HierarchicalPather::GetNumAbstractNodes() const
+{
+	int numNodes = 0;
+	for (int clusterIndex = 0; clusterIndex < (int)m_clusters.size(); clusterIndex++)
+	{
+		numNodes += (int)m_clusters[clusterIndex].nodes.size();
+	}
+
+	return numNodes;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int HierarchicalPather::GetClusterIndexForTile(int tileIndex) const
+{
+	int clusterX = (tileIndex % m_mapDimensions.x) / HPA_CLUSTER_SIZE;
+	int clusterY = (tileIndex / m_mapDimensions.x) / HPA_CLUSTER_SIZE;
+	return clusterY * m_clusterCounts.x + clusterX;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int HierarchicalPather::GetNodeSlot(const HPACluster_T& cluster, int tileIndex) const
+{
+	for (int slot = 0; slot < (int)cluster.nodes.size(); slot++)
+	{
+		if (cluster.nodes[slot].tileIndex == tileIndex)
+		{
+			return slot;
+		}
+	}
+
+	return -1;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool HierarchicalPather::IsTilePassable(int tileIndex) const
+{
+	return m_tileCosts[tileIndex] < ASTAR_IMPASSABLE_COST;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// A tile on a cluster border also changes the entrances of the cluster across that border
+//------------------------------------------------------------------------------------------------------------------------------
+void HierarchicalPather::MarkTileDirty(int tileIndex)
+{
+	int tileX = tileIndex % m_mapDimensions.x;
+	int tileY = tileIndex / m_mapDimensions.x;
+	int clusterX = tileX / HPA_CLUSTER_SIZE;
+	int clusterY = tileY / HPA_CLUSTER_SIZE;
+
+	m_clusters[clusterY * m_clusterCounts.x + clusterX].isDirty = true;
+
+	int localX = tileX - clusterX * HPA_CLUSTER_SIZE;
+	int localY = tileY - clusterY * HPA_CLUSTER_SIZE;
+
+	if (localX == 0 && clusterX > 0)
+	{
+		m_clusters[clusterY * m_clusterCounts.x + clusterX - 1].isDirty = true;
+	}
+	if (localX == HPA_CLUSTER_SIZE - 1 && clusterX < m_clusterCounts.x - 1)
+	{
+		m_clusters[clusterY * m_clusterCounts.x + clusterX + 1].isDirty = true;
+	}
+	if (localY == 0 && clusterY > 0)
+	{
+		m_clusters[(clusterY - 1) * m_clusterCounts.x + clusterX].isDirty = true;
+	}
+	if (localY == HPA_CLUSTER_SIZE - 1 && clusterY < m_clusterCounts.y - 1)
+	{
+		m_clusters[(clusterY + 1) * m_clusterCounts.x + clusterX].isDirty = true;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Entrances on a shared border are found the same way from both sides, so neighbors always agree on the transitions
+//------------------------------------------------------------------------------------------------------------------------------
+void HierarchicalPather::RebuildCluster(int clusterIndex)
+{
+	HPACluster_T& cluster = m_clusters[clusterIndex];
+	cluster.nodes.clear();
+
+	int clusterX = clusterIndex % m_clusterCounts.x;
+	int clusterY = clusterIndex / m_clusterCounts.x;
+	IntVec2 maxs = IntVec2(cluster.mins.x + cluster.size.x - 1, cluster.mins.y + cluster.size.y - 1);
+
+	if (clusterX < m_clusterCounts.x - 1)
+	{
+		AddBorderEntrances(cluster, IntVec2(maxs.x, cluster.mins.y), IntVec2(0, 1), IntVec2(1, 0), cluster.size.y);
+	}
+	if (clusterX > 0)
+	{
+		AddBorderEntrances(cluster, cluster.mins, IntVec2(0, 1), IntVec2(-1, 0), cluster.size.y);
+	}
+	if (clusterY < m_clusterCounts.y - 1)
+	{
+		AddBorderEntrances(cluster, IntVec2(cluster.mins.x, maxs.y), IntVec2(1, 0), IntVec2(0, 1), cluster.size.x);
+	}
+	if (clusterY > 0)
+	{
+		AddBorderEntrances(cluster, cluster.mins, IntVec2(1, 0), IntVec2(0, -1), cluster.size.x);
+	}
+
+	//Intra edges between every pair of transitions
+	int numNodes = (int)cluster.nodes.size();
+	cluster.intraCosts.clear();
+	cluster.intraCosts.resize(numNodes * numNodes, INT_MAX);
+
+	HPAQueryContext_T& context = m_queryContext;
+
+	for (int fromSlot = 0; fromSlot < numNodes; fromSlot++)
+	{
+		FloodCluster(context, cluster, cluster.nodes[fromSlot].tileIndex, false);
+		for (int toSlot = 0; toSlot < numNodes; toSlot++)
+		{
+			cluster.intraCosts[fromSlot * numNodes + toSlot] = GetFloodCost(context, cluster, cluster.nodes[toSlot].tileIndex);
+		}
+	}
+
+	cluster.isDirty = false;
+	m_clustersRebuilt++;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void HierarchicalPather::AddBorderEntrances(HPACluster_T& cluster, const IntVec2& borderStart, const IntVec2& borderStep, const IntVec2& acrossStep, int borderLength)
+{
+	int runStart = -1;
+
+	for (int borderIndex = 0; borderIndex <= borderLength; borderIndex++)
+	{
+		bool isOpen = false;
+		if (borderIndex < borderLength)
+		{
+			IntVec2 tile = borderStart + borderStep * borderIndex;
+			IntVec2 acrossTile = tile + acrossStep;
+			isOpen = IsTilePassable(tile.y * m_mapDimensions.x + tile.x) && IsTilePassable(acrossTile.y * m_mapDimensions.x + acrossTile.x);
+		}
+
+		if (isOpen && runStart == -1)
+		{
+			runStart = borderIndex;
+		}
+		else if (!isOpen && runStart != -1)
+		{
+			int runEnd = borderIndex - 1;
+			int runLength = runEnd - runStart + 1;
+
+			std::vector<int> transitionOffsets;
+			if (runLength >= HPA_ENTRANCE_SPLIT_LENGTH)
+			{
+				transitionOffsets.push_back(runStart);
+				transitionOffsets.push_back(runEnd);
+			}
+			else
+			{
+				transitionOffsets.push_back(runStart + (runLength - 1) / 2);
+			}
+
+			for (int offset : transitionOffsets)
+			{
+				IntVec2 tile = borderStart + borderStep * offset;
+				IntVec2 acrossTile = tile + acrossStep;
+				AddTransition(cluster, tile.y * m_mapDimensions.x + tile.x, acrossTile.y * m_mapDimensions.x + acrossTile.x);
+			}
+
+			runStart = -1;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void HierarchicalPather::AddTransition(HPACluster_T& cluster, int tileIndex, int acrossTileIndex)
+{
+	//Corner tiles can sit on two borders, keep them as one node
+	int slot = GetNodeSlot(cluster, tileIndex);
+	if (slot == -1)
+	{
+		HPANode_T node;
+		node.tileIndex = tileIndex;
+		cluster.nodes.push_back(node);
+		slot = (int)cluster.nodes.size() - 1;
+	}
+
+	cluster.nodes[slot].interEdgeTiles.push_back(acrossTileIndex);
+	cluster.nodes[slot].interEdgeCosts.push_back(m_tileCosts[acrossTileIndex]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Dijkstra that never leaves the cluster. Forward floods store the cost of walking from the source to each tile,
+// towardsSource floods store the cost of walking from each tile to the source
+//------------------------------------------------------------------------------------------------------------------------------
+void HierarchicalPather::FloodCluster(HPAQueryContext_T& context, const HPACluster_T& cluster, int sourceTileIndex, bool towardsSource, int targetTileIndex) const
+{
+	int numLocalTiles = cluster.size.x * cluster.size.y;
+	for (int localIndex = 0; localIndex < numLocalTiles; localIndex++)
+	{
+		context.floodCosts[localIndex] = INT_MAX;
+		context.floodParents[localIndex] = -1;
+	}
+
+	context.floodOpenList.Clear();
+
+	int sourceLocal = ((sourceTileIndex / m_mapDimensions.x) - cluster.mins.y) * cluster.size.x + ((sourceTileIndex % m_mapDimensions.x) - cluster.mins.x);
+	int targetLocal = -1;
+	if (targetTileIndex != -1)
+	{
+		targetLocal = ((targetTileIndex / m_mapDimensions.x) - cluster.mins.y) * cluster.size.x + ((targetTileIndex % m_mapDimensions.x) - cluster.mins.x);
+	}
+
+	context.floodCosts[sourceLocal] = 0;
+	context.floodOpenList.Push(sourceLocal, 0);
+
+	while (!context.floodOpenList.IsEmpty())
+	{
+		int currentLocal = context.floodOpenList.Pop();
+		context.nodesExpanded++;
+		if (currentLocal == targetLocal)
+			break;
+
+		int localX = currentLocal % cluster.size.x;
+		int localY = currentLocal / cluster.size.x;
+		int currentTile = (cluster.mins.y + localY) * m_mapDimensions.x + cluster.mins.x + localX;
+
+		int neighborLocals[4] = { -1, -1, -1, -1 };
+		if (localX + 1 < cluster.size.x)	neighborLocals[0] = currentLocal + 1;
+		if (localX > 0)						neighborLocals[1] = currentLocal - 1;
+		if (localY + 1 < cluster.size.y)	neighborLocals[2] = currentLocal + cluster.size.x;
+		if (localY > 0)						neighborLocals[3] = currentLocal - cluster.size.x;
+
+		for (int i = 0; i < 4; i++)
+		{
+			int neighborLocal = neighborLocals[i];
+			if (neighborLocal == -1)
+				continue;
+
+			int neighborTile = (cluster.mins.y + neighborLocal / cluster.size.x) * m_mapDimensions.x + cluster.mins.x + neighborLocal % cluster.size.x;
+			if (!IsTilePassable(neighborTile))
+				continue;
+
+			int stepCost = towardsSource ? m_tileCosts[currentTile] : m_tileCosts[neighborTile];
+			int cost = context.floodCosts[currentLocal] + stepCost;
+			if (cost >= context.floodCosts[neighborLocal])
+				continue;
+
+			bool wasOpen = context.floodOpenList.Contains(neighborLocal);
+			context.floodCosts[neighborLocal] = cost;
+			context.floodParents[neighborLocal] = currentLocal;
+
+			if (wasOpen)
+			{
+				context.floodOpenList.DecreasePriority(neighborLocal, cost);
+			}
+			else
+			{
+				context.floodOpenList.Push(neighborLocal, cost);
+			}
+		}
+	}
+
+	context.floodOpenList.Clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int HierarchicalPather::GetFloodCost(const HPAQueryContext_T& context, const HPACluster_T& cluster, int tileIndex) const
+{
+	int localIndex = ((tileIndex / m_mapDimensions.x) - cluster.mins.y) * cluster.size.x + ((tileIndex % m_mapDimensions.x) - cluster.mins.x);
+	return context.floodCosts[localIndex];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Appends the tiles from fromTileIndex (exclusive) to toTileIndex (inclusive), both inside cluster
+//------------------------------------------------------------------------------------------------------------------------------
+void HierarchicalPather::AppendRefinedSegment(HPAQueryContext_T& context, const HPACluster_T& cluster, int fromTileIndex, int toTileIndex, std::vector<int>& outTiles) const
+{
+	FloodCluster(context, cluster, fromTileIndex, false, toTileIndex);
+
+	int firstNewTile = (int)outTiles.size();
+	int toLocal = ((toTileIndex / m_mapDimensions.x) - cluster.mins.y) * cluster.size.x + ((toTileIndex % m_mapDimensions.x) - cluster.mins.x);
+
+	for (int local = toLocal; context.floodParents[local] != -1; local = context.floodParents[local])
+	{
+		outTiles.push_back((cluster.mins.y + local / cluster.size.x) * m_mapDimensions.x + cluster.mins.x + local % cluster.size.x);
+	}
+
+	std::reverse(outTiles.begin() + firstNewTile, outTiles.end());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void HierarchicalPather::StartNewSearch(HPAQueryContext_T& context) const
+{
+	context.searchGeneration++;
+
+	if (context.searchGeneration == 0)
+	{
+		std::fill(context.searchGenerations.begin(), context.searchGenerations.end(), 0);
+		context.searchGeneration = 1;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void HierarchicalPather::OpenOrDecreaseNode(HPAQueryContext_T& context, int tileIndex, int parentTileIndex, int gCost, int endTileIndex) const
+{
+	if (context.searchGenerations[tileIndex] != context.searchGeneration)
+	{
+		context.searchGenerations[tileIndex] = context.searchGeneration;
+		context.searchGCosts[tileIndex] = INT_MAX;
+		context.searchParents[tileIndex] = -1;
+		context.searchFinished[tileIndex] = false;
+	}
+
+	if (context.searchFinished[tileIndex] || gCost >= context.searchGCosts[tileIndex])
+		return;
+
+	bool wasOpen = context.searchOpenList.Contains(tileIndex);
+	context.searchGCosts[tileIndex] = gCost;
+	context.searchParents[tileIndex] = parentTileIndex;
+
+	AStarPriority_T priority;
+	priority.hCost = GetManhattanDistance(IntVec2(tileIndex % m_mapDimensions.x, tileIndex / m_mapDimensions.x), IntVec2(endTileIndex % m_mapDimensions.x, endTileIndex / m_mapDimensions.x));
+	priority.fCost = gCost + priority.hCost;
+
+	if (wasOpen)
+	{
+		context.searchOpenList.DecreasePriority(tileIndex, priority);
+	}
+	else
+	{
+		context.searchOpenList.Push(tileIndex, priority);
+	}
+}
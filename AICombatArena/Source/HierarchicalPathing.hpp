@@ -0,0 +1,96 @@
+#pragma once
+#include <vector>
+#include "IntVec2.hpp"
+#include "AStarPathing.hpp"
+#include "IndexedPriorityQueue.hpp"
+
+constexpr int HPA_CLUSTER_SIZE = 16;			//Clusters are HPA_CLUSTER_SIZE x HPA_CLUSTER_SIZE tiles (smaller on the map edge)
+constexpr int HPA_ENTRANCE_SPLIT_LENGTH = 6;	//Entrances this wide or wider get a transition at each end instead of one in the middle
+
+//------------------------------------------------------------------------------------------------------------------------------
+// A transition tile on a cluster border. Inter edges lead to the matching tile in the neighboring cluster
+struct HPANode_T
+{
+	int tileIndex = -1;
+	std::vector<int> interEdgeTiles;	//Tile across the border, entering it costs interEdgeCosts
+	std::vector<int> interEdgeCosts;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct HPACluster_T
+{
+	IntVec2 mins = IntVec2(0, 0);
+	IntVec2 size = IntVec2(0, 0);
+
+	std::vector<HPANode_T> nodes;
+	std::vector<int> intraCosts;		//nodes.size() x nodes.size(), cost of walking from node [row] to node [column] inside the cluster
+	bool isDirty = true;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Scratch memory for one query at a time. Each thread querying the same pather needs its own
+struct HPAQueryContext_T
+{
+	// Cluster bounded Dijkstra, indexed by the tile's local index in the cluster
+	std::vector<int>				floodCosts;
+	std::vector<int>				floodParents;
+	IndexedPriorityQueue<int>		floodOpenList;
+
+	// Abstract graph search state, indexed by tile and reset lazily with a generation stamp like AStarPather
+	std::vector<int>				searchGCosts;
+	std::vector<int>				searchParents;
+	std::vector<unsigned int>		searchGenerations;
+	std::vector<bool>				searchFinished;
+	unsigned int					searchGeneration = 0;
+	IndexedPriorityQueue<AStarPriority_T>	searchOpenList;
+
+	unsigned long long				nodesExpanded = 0;	//Tiles popped by the cluster floods plus nodes popped by the abstract search
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// HPA* : the map is split into clusters joined by entrances. Long queries are solved on the small abstract graph of
+// entrances and then refined inside each cluster. Only clusters whose tiles changed are rebuilt
+//------------------------------------------------------------------------------------------------------------------------------
+class HierarchicalPather
+{
+public:
+	void			Init(const IntVec2& mapDimensions);
+
+	static void		InitQueryContext(HPAQueryContext_T& context, const IntVec2& mapDimensions);
+
+	void			UpdateCosts(const std::vector<int>& tileCosts);
+	void			UpdateCosts(const std::vector<int>& tileCosts, const std::vector<int>& changedTiles);	//Only checks the listed tiles
+	Path			CreatePath(int startTileIndex, int endTileIndex);
+	Path			CreatePath(int startTileIndex, int endTileIndex, HPAQueryContext_T& context) const;
+
+	int				GetNumAbstractNodes() const;
+
+	int				m_clustersRebuilt = 0;
+
+private:
+	int				GetClusterIndexForTile(int tileIndex) const;
+	int				GetNodeSlot(const HPACluster_T& cluster, int tileIndex) const;
+	bool			IsTilePassable(int tileIndex) const;
+
+	void			MarkTileDirty(int tileIndex);
+	void			RebuildDirtyClusters();
+	void			RebuildCluster(int clusterIndex);
+	void			AddBorderEntrances(HPACluster_T& cluster, const IntVec2& borderStart, const IntVec2& borderStep, const IntVec2& acrossStep, int borderLength);
+	void			AddTransition(HPACluster_T& cluster, int tileIndex, int acrossTileIndex);
+
+	void			FloodCluster(HPAQueryContext_T& context, const HPACluster_T& cluster, int sourceTileIndex, bool towardsSource, int targetTileIndex = -1) const;
+	int				GetFloodCost(const HPAQueryContext_T& context, const HPACluster_T& cluster, int tileIndex) const;
+	void			AppendRefinedSegment(HPAQueryContext_T& context, const HPACluster_T& cluster, int fromTileIndex, int toTileIndex, std::vector<int>& outTiles) const;
+
+	void			StartNewSearch(HPAQueryContext_T& context) const;
+	void			OpenOrDecreaseNode(HPAQueryContext_T& context, int tileIndex, int parentTileIndex, int gCost, int endTileIndex) const;
+
+private:
+	IntVec2							m_mapDimensions = IntVec2(0, 0);
+	IntVec2							m_clusterCounts = IntVec2(0, 0);
+	std::vector<int>				m_tileCosts;
+	std::vector<HPACluster_T>		m_clusters;
+
+	// Used by cluster rebuilds and by CreatePath calls that don't pass a context
+	HPAQueryContext_T				m_queryContext;
+};
@@ -0,0 +1,331 @@
+#include "IncrementalPathing.hpp"
+#include "MathUtils.hpp"
+#include <algorithm>
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool DStarKey_T::operator<(const DStarKey_T& compare) const
+{
+	if (k1 != compare.k1)
+	{
+		return k1 < compare.k1;
+	}
+
+	return k2 < compare.k2;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void DStarLitePather::Init(const IntVec2& mapDimensions)
+{
+	m_mapDimensions = mapDimensions;
+
+	int mapSize = mapDimensions.x * mapDimensions.y;
+	m_tileCosts.resize(mapSize);
+	m_gCosts.resize(mapSize);
+	m_rhsCosts.resize(mapSize);
+	m_openList.Init(mapSize);
+
+	Reset();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void DStarLitePather::Reset()
+{
+	m_openList.Clear();
+	m_startTileIndex = -1;
+	m_goalTileIndex = -1;
+	m_keyModifier = 0;
+
+	m_pendingChangedTiles.clear();
+	m_needsFullRescan = false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Without a goal there is no search state to repair, the next goal copies every cost anyway
+//------------------------------------------------------------------------------------------------------------------------------
+void DStarLitePather::AddChangedTiles(const std::vector<int>& changedTiles)
+{
+	if (m_goalTileIndex == -1 || m_needsFullRescan)
+		return;
+
+	if ((int)(m_pendingChangedTiles.size() + changedTiles.size()) > (int)m_tileCosts.size() / DSTAR_RESCAN_CHANGES_DIVISOR)
+	{
+		m_pendingChangedTiles.clear();
+		m_needsFullRescan = true;
+		return;
+	}
+
+	m_pendingChangedTiles.insert(m_pendingChangedTiles.end(), changedTiles.begin(), changedTiles.end());
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool DStarLitePather::IsInitialized() const
+{
+	return m_openList.GetCapacity() > 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int DStarLitePather::GetGoalTileIndex() const
+{
+	return m_goalTileIndex;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Returns the path ordered end first without the start tile (same as AStarPather), or an empty path if the goal
+// can't be reached or the search ran out of expansions
+//------------------------------------------------------------------------------------------------------------------------------
+Path DStarLitePather::CreatePath(int startTileIndex, int goalTileIndex, const std::vector<int>& tileCosts, int expansionLimit)
+{
+	Path path;
+
+	if (goalTileIndex != m_goalTileIndex)
+	{
+		StartNewGoal(startTileIndex, goalTileIndex, tileCosts);
+	}
+	else
+	{
+		//The start moving only shifts every key by the same amount, fold it into km instead of re-keying the open list
+		m_keyModifier += GetHeuristic(m_startTileIndex, startTileIndex);
+		m_startTileIndex = startTileIndex;
+
+		ApplyChangedCosts(tileCosts);
+	}
+
+	if (startTileIndex == goalTileIndex || !ComputeShortestPath(expansionLimit))
+	{
+		return path;
+	}
+
+	if (m_gCosts[startTileIndex] >= DSTAR_INFINITE_COST)
+	{
+		return path;
+	}
+
+	//Walk down the gCosts from the start to the goal
+	std::vector<int> forwardTiles;
+	int maxSteps = (int)m_gCosts.size();
+	int neighbors[4];
+
+	for (int currentTile = startTileIndex; currentTile != goalTileIndex; )
+	{
+		int bestTile = -1;
+		int bestCost = DSTAR_INFINITE_COST;
+
+		int numNeighbors = PopulateNeighbors(currentTile, neighbors);
+		for (int i = 0; i < numNeighbors; i++)
+		{
+			int cost = GetStepCost(neighbors[i]) + m_gCosts[neighbors[i]];
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestTile = neighbors[i];
+			}
+		}
+
+		if (bestTile == -1 || (int)forwardTiles.size() >= maxSteps)
+		{
+			return path;
+		}
+
+		forwardTiles.push_back(bestTile);
+		currentTile = bestTile;
+	}
+
+	for (int tileIndex = (int)forwardTiles.size() - 1; tileIndex >= 0; tileIndex--)
+	{
+		path.push_back(IntVec2(forwardTiles[tileIndex] % m_mapDimensions.x, forwardTiles[tileIndex] / m_mapDimensions.x));
+	}
+
+	return path;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void DStarLitePather::StartNewGoal(int startTileIndex, int goalTileIndex, const std::vector<int>& tileCosts)
+{
+	Reset();
+
+	std::copy(tileCosts.begin(), tileCosts.end(), m_tileCosts.begin());
+	std::fill(m_gCosts.begin(), m_gCosts.end(), DSTAR_INFINITE_COST);
+	std::fill(m_rhsCosts.begin(), m_rhsCosts.end(), DSTAR_INFINITE_COST);
+
+	m_startTileIndex = startTileIndex;
+	m_goalTileIndex = goalTileIndex;
+
+	m_rhsCosts[goalTileIndex] = 0;
+	m_openList.Push(goalTileIndex, CalculateKey(goalTileIndex));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Only the tiles passed to AddChangedTiles since the last path are compared, unless there were too many to be worth it
+//------------------------------------------------------------------------------------------------------------------------------
+void DStarLitePather::ApplyChangedCosts(const std::vector<int>& tileCosts)
+{
+	if (m_needsFullRescan)
+	{
+		for (int tileIndex = 0; tileIndex < (int)m_tileCosts.size(); tileIndex++)
+		{
+			ApplyChangedCost(tileIndex, tileCosts);
+		}
+	}
+	else
+	{
+		for (int changeIndex = 0; changeIndex < (int)m_pendingChangedTiles.size(); changeIndex++)
+		{
+			ApplyChangedCost(m_pendingChangedTiles[changeIndex], tileCosts);
+		}
+	}
+
+	m_pendingChangedTiles.clear();
+	m_needsFullRescan = false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Entering a tile costs that tile's cost, so a change only touches the rhs of the tiles next to it
+//------------------------------------------------------------------------------------------------------------------------------
+void DStarLitePather::ApplyChangedCost(int tileIndex, const std::vector<int>& tileCosts)
+{
+	if (m_tileCosts[tileIndex] == tileCosts[tileIndex])
+		return;
+
+	m_tileCosts[tileIndex] = tileCosts[tileIndex];
+
+	int neighbors[4];
+	int numNeighbors = PopulateNeighbors(tileIndex, neighbors);
+	for (int i = 0; i < numNeighbors; i++)
+	{
+		UpdateTile(neighbors[i]);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool DStarLitePather::ComputeShortestPath(int expansionLimit)
+{
+	int expansions = 0;
+	int neighbors[4];
+
+	while (!m_openList.IsEmpty())
+	{
+		int startG = m_gCosts[m_startTileIndex];
+		int startRhs = m_rhsCosts[m_startTileIndex];
+
+		if (!(m_openList.GetTopPriority() < CalculateKey(m_startTileIndex)) && startRhs == startG)
+			break;
+
+		if (expansions >= expansionLimit)
+			return false;
+
+		expansions++;
+		m_nodesExpanded++;
+
+		int currentTile = m_openList.GetTop();
+		DStarKey_T oldKey = m_openList.GetTopPriority();
+		DStarKey_T newKey = CalculateKey(currentTile);
+
+		if (oldKey < newKey)
+		{
+			m_openList.UpdatePriority(currentTile, newKey);
+			continue;
+		}
+
+		int numNeighbors = PopulateNeighbors(currentTile, neighbors);
+
+		if (m_gCosts[currentTile] > m_rhsCosts[currentTile])
+		{
+			m_gCosts[currentTile] = m_rhsCosts[currentTile];
+			m_openList.Pop();
+
+			for (int i = 0; i < numNeighbors; i++)
+			{
+				UpdateTile(neighbors[i]);
+			}
+		}
+		else
+		{
+			m_gCosts[currentTile] = DSTAR_INFINITE_COST;
+
+			UpdateTile(currentTile);
+			for (int i = 0; i < numNeighbors; i++)
+			{
+				UpdateTile(neighbors[i]);
+			}
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void DStarLitePather::UpdateTile(int tileIndex)
+{
+	if (tileIndex != m_goalTileIndex)
+	{
+		int neighbors[4];
+		int numNeighbors = PopulateNeighbors(tileIndex, neighbors);
+
+		int rhsCost = DSTAR_INFINITE_COST;
+		for (int i = 0; i < numNeighbors; i++)
+		{
+			rhsCost = GetLowerValue(rhsCost, GetStepCost(neighbors[i]) + m_gCosts[neighbors[i]]);
+		}
+
+		m_rhsCosts[tileIndex] = GetLowerValue(rhsCost, DSTAR_INFINITE_COST);
+	}
+
+	bool isOpen = m_openList.Contains(tileIndex);
+	bool isConsistent = m_gCosts[tileIndex] == m_rhsCosts[tileIndex];
+
+	if (isOpen && isConsistent)
+	{
+		m_openList.Remove(tileIndex);
+	}
+	else if (isOpen)
+	{
+		m_openList.UpdatePriority(tileIndex, CalculateKey(tileIndex));
+	}
+	else if (!isConsistent)
+	{
+		m_openList.Push(tileIndex, CalculateKey(tileIndex));
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+DStarKey_T DStarLitePather::CalculateKey(int tileIndex) const
+{
+	DStarKey_T key;
+	key.k2 = GetLowerValue(m_gCosts[tileIndex], m_rhsCosts[tileIndex]);
+	key.k1 = key.k2 + GetHeuristic(m_startTileIndex, tileIndex) + m_keyModifier;
+	return key;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int DStarLitePather::GetHeuristic(int tileIndexA, int tileIndexB) const
+{
+	IntVec2 tileA = IntVec2(tileIndexA % m_mapDimensions.x, tileIndexA / m_mapDimensions.x);
+	IntVec2 tileB = IntVec2(tileIndexB % m_mapDimensions.x, tileIndexB / m_mapDimensions.x);
+	return GetManhattanDistance(tileA, tileB);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int DStarLitePather::GetStepCost(int toTileIndex) const
+{
+	if (m_tileCosts[toTileIndex] >= ASTAR_IMPASSABLE_COST)
+	{
+		return DSTAR_INFINITE_COST;
+	}
+
+	return m_tileCosts[toTileIndex];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int DStarLitePather::PopulateNeighbors(int tileIndex, int* outNeighbors) const
+{
+	int tileX = tileIndex % m_mapDimensions.x;
+	int tileY = tileIndex / m_mapDimensions.x;
+	int numNeighbors = 0;
+
+	if (tileX + 1 < m_mapDimensions.x)	outNeighbors[numNeighbors++] = tileIndex + 1;
+	if (tileX > 0)						outNeighbors[numNeighbors++] = tileIndex - 1;
+	if (tileY + 1 < m_mapDimensions.y)	outNeighbors[numNeighbors++] = tileIndex + m_mapDimensions.x;
+	if (tileY > 0)						outNeighbors[numNeighbors++] = tileIndex - m_mapDimensions.x;
+
+	return numNeighbors;
+}
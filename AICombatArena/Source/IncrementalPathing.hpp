@@ -0,0 +1,70 @@
+#pragma once
+#include <vector>
+#include "IntVec2.hpp"
+#include "AStarPathing.hpp"
+#include "IndexedPriorityQueue.hpp"
+
+constexpr int DSTAR_INFINITE_COST = INT_MAX / 2;		//Leaves room to add a tile cost without overflowing
+constexpr int DSTAR_DEFAULT_EXPANSION_LIMIT = 8192;	//Expansions allowed per CreatePath call, the search resumes on the next call
+constexpr int DSTAR_MAX_POOLED_PATHERS = 8;			//Each pather holds map sized state, so only a few agents keep one at a time
+constexpr int DSTAR_RESCAN_CHANGES_DIVISOR = 8;		//Past mapSize / this many pending changed tiles the next path rescans every tile instead
+
+//------------------------------------------------------------------------------------------------------------------------------
+// D* Lite open list key, compared on k1 then k2
+struct DStarKey_T
+{
+	int k1 = 0;
+	int k2 = 0;
+
+	bool	operator<(const DStarKey_T& compare) const;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// D* Lite: searches backwards from the goal and keeps its state between calls. When the start moves or tile costs
+// change only the affected tiles are repaired instead of running a fresh search. Changing the goal resets everything
+//------------------------------------------------------------------------------------------------------------------------------
+class DStarLitePather
+{
+public:
+	void			Init(const IntVec2& mapDimensions);
+	void			Reset();
+
+	Path			CreatePath(int startTileIndex, int goalTileIndex, const std::vector<int>& tileCosts, int expansionLimit = DSTAR_DEFAULT_EXPANSION_LIMIT);
+
+	void			AddChangedTiles(const std::vector<int>& changedTiles);		//Tiles whose cost may differ on the next CreatePath
+
+	bool			IsInitialized() const;
+	int				GetGoalTileIndex() const;
+
+	int					m_ownerID = -1;			//Whoever is using this pather (the controller pools them by agent ID)
+	int					m_lastUsedTurn = -1;
+	bool				m_isInUse = false;		//A thread is searching with it, the pool hands out another one
+	unsigned long long	m_nodesExpanded = 0;
+
+private:
+	void			StartNewGoal(int startTileIndex, int goalTileIndex, const std::vector<int>& tileCosts);
+	void			ApplyChangedCosts(const std::vector<int>& tileCosts);
+	void			ApplyChangedCost(int tileIndex, const std::vector<int>& tileCosts);
+
+	bool			ComputeShortestPath(int expansionLimit);
+	void			UpdateTile(int tileIndex);
+	DStarKey_T		CalculateKey(int tileIndex) const;
+
+	int				GetHeuristic(int tileIndexA, int tileIndexB) const;
+	int				GetStepCost(int toTileIndex) const;
+	int				PopulateNeighbors(int tileIndex, int* outNeighbors) const;
+
+private:
+	IntVec2							m_mapDimensions = IntVec2(0, 0);
+	std::vector<int>				m_tileCosts;	//Costs the current state was built with
+	std::vector<int>				m_gCosts;
+	std::vector<int>				m_rhsCosts;		//One step lookahead of gCost, the tile is consistent when they match
+	IndexedPriorityQueue<DStarKey_T>	m_openList;
+
+	int								m_startTileIndex = -1;
+	int								m_goalTileIndex = -1;
+	int								m_keyModifier = 0;	//km, grows by the heuristic distance every time the start moves
+
+	std::vector<int>				m_pendingChangedTiles;	//Checked against the costs on the next CreatePath for the same goal
+	bool							m_needsFullRescan = false;
+};
@@ -0,0 +1,44 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#pragma once
+#include <vector>
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Binary min-heap of tile indices keyed on a priority of type T (T needs operator<)
+// Keeps a lookup from tile index to heap slot so priorities can be decreased in O(log n)
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+class IndexedPriorityQueue
+{
+public:
+	IndexedPriorityQueue();
+	explicit IndexedPriorityQueue(int maxIndexCount);
+
+	void			Init(int maxIndexCount);
+	void			Clear();
+
+	bool			IsEmpty() const;
+	int				GetSize() const;
+	int				GetCapacity() const;
+	bool			Contains(int index) const;
+	const T&		GetPriority(int index) const;
+	int				GetTop() const;
+	const T&		GetTopPriority() const;
+
+	void			Push(int index, const T& priority);
+	void			DecreasePriority(int index, const T& priority);
+	void			UpdatePriority(int index, const T& priority);	//Priority may go either way
+	void			Remove(int index);
+	int				Pop();
+
+private:
+	void			SiftUp(int heapSlot);
+	void			SiftDown(int heapSlot);
+	void			SwapSlots(int slotA, int slotB);
+
+private:
+	std::vector<int>	m_heap;				// Tile indices in heap order
+	std::vector<T>		m_priorities;		// Priority for each heap slot
+	std::vector<int>	m_slotForIndex;		// Heap slot for each tile index, -1 if not in the heap
+};
+
+#include "IndexedPriorityQueue.inl"
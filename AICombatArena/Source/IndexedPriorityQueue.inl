@@ -0,0 +1,234 @@
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+IndexedPriorityQueue<T>::IndexedPriorityQueue()
+{
+	//Empty constructor
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+IndexedPriorityQueue<T>::IndexedPriorityQueue(int maxIndexCount)
+{
+	Init(maxIndexCount);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+void IndexedPriorityQueue<T>::Init(int maxIndexCount)
+{
+	m_heap.clear();
+	m_priorities.clear();
+	m_heap.reserve(maxIndexCount);
+	m_priorities.reserve(maxIndexCount);
+
+	m_slotForIndex.clear();
+	m_slotForIndex.resize(maxIndexCount, -1);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Only resets the slots that are in use so clearing a small heap stays cheap on a large map
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+void IndexedPriorityQueue<T>::Clear()
+{
+	for (int heapSlot = 0; heapSlot < (int)m_heap.size(); heapSlot++)
+	{
+		m_slotForIndex[m_heap[heapSlot]] = -1;
+	}
+
+	m_heap.clear();
+	m_priorities.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+bool IndexedPriorityQueue<T>::IsEmpty() const
+{
+	return m_heap.empty();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+int IndexedPriorityQueue<T>::GetSize() const
+{
+	return (int)m_heap.size();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+int IndexedPriorityQueue<T>::GetCapacity() const
+{
+	return (int)m_slotForIndex.size();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+bool IndexedPriorityQueue<T>::Contains(int index) const
+{
+	return m_slotForIndex[index] != -1;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+const T& IndexedPriorityQueue<T>::GetPriority(int index) const
+{
+	return m_priorities[m_slotForIndex[index]];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+int IndexedPriorityQueue<T>::GetTop() const
+{
+	return m_heap.front();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+const T& IndexedPriorityQueue<T>::GetTopPriority() const
+{
+	return m_priorities.front();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+void IndexedPriorityQueue<T>::Push(int index, const T& priority)
+{
+	int heapSlot = (int)m_heap.size();
+	m_heap.push_back(index);
+	m_priorities.push_back(priority);
+	m_slotForIndex[index] = heapSlot;
+
+	SiftUp(heapSlot);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+void IndexedPriorityQueue<T>::DecreasePriority(int index, const T& priority)
+{
+	int heapSlot = m_slotForIndex[index];
+	m_priorities[heapSlot] = priority;
+
+	SiftUp(heapSlot);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+void IndexedPriorityQueue<T>::UpdatePriority(int index, const T& priority)
+{
+	int heapSlot = m_slotForIndex[index];
+	bool isDecrease = priority < m_priorities[heapSlot];
+	m_priorities[heapSlot] = priority;
+
+	if (isDecrease)
+	{
+		SiftUp(heapSlot);
+	}
+	else
+	{
+		SiftDown(heapSlot);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Moves the last entry into the removed slot and lets it settle in whichever direction it needs to
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+void IndexedPriorityQueue<T>::Remove(int index)
+{
+	int heapSlot = m_slotForIndex[index];
+	int lastSlot = (int)m_heap.size() - 1;
+
+	SwapSlots(heapSlot, lastSlot);
+	m_heap.pop_back();
+	m_priorities.pop_back();
+	m_slotForIndex[index] = -1;
+
+	if (heapSlot < (int)m_heap.size())
+	{
+		int movedIndex = m_heap[heapSlot];
+		SiftUp(heapSlot);
+		SiftDown(m_slotForIndex[movedIndex]);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+int IndexedPriorityQueue<T>::Pop()
+{
+	int topIndex = m_heap.front();
+	int lastSlot = (int)m_heap.size() - 1;
+
+	SwapSlots(0, lastSlot);
+	m_heap.pop_back();
+	m_priorities.pop_back();
+	m_slotForIndex[topIndex] = -1;
+
+	if (!m_heap.empty())
+	{
+		SiftDown(0);
+	}
+
+	return topIndex;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+void IndexedPriorityQueue<T>::SiftUp(int heapSlot)
+{
+	while (heapSlot > 0)
+	{
+		int parentSlot = (heapSlot - 1) / 2;
+		if (!(m_priorities[heapSlot] < m_priorities[parentSlot]))
+			break;
+
+		SwapSlots(heapSlot, parentSlot);
+		heapSlot = parentSlot;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+void IndexedPriorityQueue<T>::SiftDown(int heapSlot)
+{
+	int heapSize = (int)m_heap.size();
+
+	while (true)
+	{
+		int smallestSlot = heapSlot;
+		int leftSlot = 2 * heapSlot + 1;
+		int rightSlot = leftSlot + 1;
+
+		if (leftSlot < heapSize && m_priorities[leftSlot] < m_priorities[smallestSlot])
+		{
+			smallestSlot = leftSlot;
+		}
+		if (rightSlot < heapSize && m_priorities[rightSlot] < m_priorities[smallestSlot])
+		{
+			smallestSlot = rightSlot;
+		}
+
+		if (smallestSlot == heapSlot)
+			break;
+
+		SwapSlots(heapSlot, smallestSlot);
+		heapSlot = smallestSlot;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+void IndexedPriorityQueue<T>::SwapSlots(int slotA, int slotB)
+{
+	int indexA = m_heap[slotA];
+	int indexB = m_heap[slotB];
+
+	m_heap[slotA] = indexB;
+	m_heap[slotB] = indexA;
+
+	T priorityA = m_priorities[slotA];
+	m_priorities[slotA] = m_priorities[slotB];
+	m_priorities[slotB] = priorityA;
+
+	m_slotForIndex[indexA] = slotB;
+	m_slotForIndex[indexB] = slotA;
+}
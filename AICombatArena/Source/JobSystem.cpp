@@ -0,0 +1,173 @@
+#include "JobSystem.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+void JobSystem::Startup(int numThreads)
+{
+	m_numThreads = numThreads > 1 ? numThreads : 1;
+	m_queues = std::make_unique<JobQueue_T[]>(m_numThreads);
+
+	m_currentJob = nullptr;
+	m_batchNumber = 0;
+	m_numWorkersInBatch = 0;
+	m_numWorkersExited = 0;
+	m_isBatchOpen = false;
+	m_stopRequested = false;
+
+	m_numJobsRemaining = 0;
+	m_jobsRun = 0;
+	m_jobsStolen = 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void JobSystem::RequestStop()
+{
+	{
+		std::unique_lock lk(m_batchLock);
+		m_stopRequested = true;
+	}
+
+	m_batchStartCV.notify_all();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Every thread but the turn thread is a worker; the DLL can't be unloaded while any of them is still running
+//------------------------------------------------------------------------------------------------------------------------------
+void JobSystem::WaitForWorkersToExit()
+{
+	int numWorkers = m_numThreads - 1;
+
+	std::unique_lock lk(m_batchLock);
+	m_batchDoneCV.wait(lk, [&]() { return m_numWorkersExited >= numWorkers; });
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Jobs are dealt out in contiguous runs, one run per thread, so neighbouring jobs tend to stay on the same thread
+//------------------------------------------------------------------------------------------------------------------------------
+void JobSystem::ParallelFor(int numJobs, const JobFunction& job, int threadIdx)
+{
+	if (numJobs <= 0)
+		return;
+
+	for (int queueIndex = 0; queueIndex < m_numThreads; queueIndex++)
+	{
+		int firstJob = (numJobs * queueIndex) / m_numThreads;
+		int endJob = (numJobs * (queueIndex + 1)) / m_numThreads;
+
+		std::unique_lock lk(m_queues[queueIndex].lock);
+		for (int jobIndex = firstJob; jobIndex < endJob; jobIndex++)
+		{
+			m_queues[queueIndex].jobs.push_back(jobIndex);
+		}
+	}
+
+	m_numJobsRemaining = numJobs;
+
+	{
+		std::unique_lock lk(m_batchLock);
+		m_currentJob = &job;
+		m_batchNumber++;
+		m_isBatchOpen = true;
+	}
+	m_batchStartCV.notify_all();
+
+	//The turn thread runs jobs too, so this still finishes with no workers at all
+	RunJobs(threadIdx);
+
+	//Wait for the last jobs and for every worker to be out of the queues, workers that wake up late won't join a closed batch
+	std::unique_lock lk(m_batchLock);
+	m_batchDoneCV.wait(lk, [&]() { return m_numJobsRemaining == 0 && m_numWorkersInBatch == 0; });
+	m_isBatchOpen = false;
+	m_currentJob = nullptr;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void JobSystem::WorkerThreadEntry(int threadIdx)
+{
+	int lastBatchNumber = 0;
+
+	while (true)
+	{
+		{
+			std::unique_lock lk(m_batchLock);
+			m_batchStartCV.wait(lk, [&]() { return m_stopRequested || (m_isBatchOpen && m_batchNumber != lastBatchNumber); });
+
+			if (m_stopRequested)
+				break;
+
+			lastBatchNumber = m_batchNumber;
+			m_numWorkersInBatch++;
+		}
+
+		RunJobs(threadIdx);
+
+		{
+			std::unique_lock lk(m_batchLock);
+			m_numWorkersInBatch--;
+		}
+		m_batchDoneCV.notify_all();
+	}
+
+	{
+		std::unique_lock lk(m_batchLock);
+		m_numWorkersExited++;
+	}
+	m_batchDoneCV.notify_all();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int JobSystem::GetNumThreads() const
+{
+	return m_numThreads;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void JobSystem::RunJobs(int threadIdx)
+{
+	int queueIndex = threadIdx % m_numThreads;
+	int jobIndex = -1;
+
+	while (PopJob(queueIndex, jobIndex) || StealJob(queueIndex, jobIndex))
+	{
+		(*m_currentJob)(jobIndex, threadIdx);
+
+		m_jobsRun++;
+		m_numJobsRemaining--;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool JobSystem::PopJob(int queueIndex, int& outJobIndex)
+{
+	JobQueue_T& queue = m_queues[queueIndex];
+	std::unique_lock lk(queue.lock);
+
+	if (queue.jobs.empty())
+		return false;
+
+	outJobIndex = queue.jobs.back();
+	queue.jobs.pop_back();
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Takes the oldest job of the next thread that still has any, the victim keeps working on the jobs it queued last
+//------------------------------------------------------------------------------------------------------------------------------
+bool JobSystem::StealJob(int queueIndex, int& outJobIndex)
+{
+	for (int offset = 1; offset < m_numThreads; offset++)
+	{
+		JobQueue_T& victim = m_queues[(queueIndex + offset) % m_numThreads];
+		std::unique_lock lk(victim.lock);
+
+		if (victim.jobs.empty())
+			continue;
+
+		outJobIndex = victim.jobs.front();
+		victim.jobs.pop_front();
+
+		m_jobsStolen++;
+		return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <condition_variable>
+
+typedef std::function<void(int jobIndex, int threadIdx)> JobFunction;
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Job indices waiting to run. The owning thread pops from the back, idle threads steal from the front
+struct JobQueue_T
+{
+	std::mutex			lock;
+	std::deque<int>		jobs;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Runs the jobs of a ParallelFor on every server thread. Each thread starts on its own share of the jobs and steals
+// from the others once it runs dry, so a few slow jobs don't leave the other threads idle
+// The turn thread calls ParallelFor, the other threads sit in WorkerThreadEntry until there is work
+//------------------------------------------------------------------------------------------------------------------------------
+class JobSystem
+{
+public:
+	void			Startup(int numThreads);
+	void			RequestStop();
+	void			WaitForWorkersToExit();
+
+	void			ParallelFor(int numJobs, const JobFunction& job, int threadIdx);	//Returns once every job has run
+	void			WorkerThreadEntry(int threadIdx);
+
+	int				GetNumThreads() const;
+
+	std::atomic<unsigned long long>		m_jobsRun = 0;
+	std::atomic<unsigned long long>		m_jobsStolen = 0;
+
+private:
+	void			RunJobs(int threadIdx);
+	bool			PopJob(int queueIndex, int& outJobIndex);
+	bool			StealJob(int queueIndex, int& outJobIndex);
+
+private:
+	int									m_numThreads = 1;
+	std::unique_ptr<JobQueue_T[]>		m_queues;		//One per server thread, indexed by thread index
+
+	const JobFunction*					m_currentJob = nullptr;
+
+	std::mutex							m_batchLock;
+	std::condition_variable				m_batchStartCV;
+	std::condition_variable				m_batchDoneCV;
+	int									m_batchNumber = 0;
+	int									m_numWorkersInBatch = 0;
+	int									m_numWorkersExited = 0;
+	bool								m_isBatchOpen = false;
+	bool								m_stopRequested = false;
+
+	std::atomic<int>					m_numJobsRemaining = 0;
+};
@@ -0,0 +1,186 @@
+#include "JumpPointTable.hpp"
+#include "AStarPathing.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Columns first: a horizontal jump stops wherever a vertical jump from the tile finds a jump point
+//------------------------------------------------------------------------------------------------------------------------------
+void JumpPointTable::Build(const IntVec2& mapDimensions, const std::vector<int>& tileCosts)
+{
+	m_mapDimensions = mapDimensions;
+	m_jumpDistances.resize(mapDimensions.x * mapDimensions.y * NUM_JUMP_DIRECTIONS);
+
+	m_isColumnDirty.assign(mapDimensions.x, 0);
+	m_isRowDirty.assign(mapDimensions.y, 0);
+	m_hadVerticalJumpPoint.resize(mapDimensions.y);
+
+	for (int tileX = 0; tileX < mapDimensions.x; tileX++)
+	{
+		BuildColumn(tileX, tileCosts);
+	}
+	for (int tileY = 0; tileY < mapDimensions.y; tileY++)
+	{
+		BuildRow(tileY, tileCosts);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// A tile's vertical jumps depend on its own column and the two beside it, through the forced neighbor checks. Its rows
+// change where the tile is, and wherever a rebuilt column gained or lost a vertical jump point
+//------------------------------------------------------------------------------------------------------------------------------
+void JumpPointTable::UpdateChangedTiles(const std::vector<int>& tileCosts, const std::vector<int>& changedTiles)
+{
+	for (int changeIndex = 0; changeIndex < (int)changedTiles.size(); changeIndex++)
+	{
+		int tileX = changedTiles[changeIndex] % m_mapDimensions.x;
+		int tileY = changedTiles[changeIndex] / m_mapDimensions.x;
+
+		for (int columnX = tileX - 1; columnX <= tileX + 1; columnX++)
+		{
+			if (columnX >= 0 && columnX < m_mapDimensions.x)
+			{
+				m_isColumnDirty[columnX] = 1;
+			}
+		}
+		m_isRowDirty[tileY] = 1;
+	}
+
+	for (int tileX = 0; tileX < m_mapDimensions.x; tileX++)
+	{
+		if (!m_isColumnDirty[tileX])
+			continue;
+
+		for (int tileY = 0; tileY < m_mapDimensions.y; tileY++)
+		{
+			m_hadVerticalJumpPoint[tileY] = HasVerticalJumpPoint(tileY * m_mapDimensions.x + tileX);
+		}
+
+		BuildColumn(tileX, tileCosts);
+		m_isColumnDirty[tileX] = 0;
+		m_linesRebuilt++;
+
+		for (int tileY = 0; tileY < m_mapDimensions.y; tileY++)
+		{
+			if (m_hadVerticalJumpPoint[tileY] != (unsigned char)HasVerticalJumpPoint(tileY * m_mapDimensions.x + tileX))
+			{
+				m_isRowDirty[tileY] = 1;
+			}
+		}
+	}
+
+	for (int tileY = 0; tileY < m_mapDimensions.y; tileY++)
+	{
+		if (!m_isRowDirty[tileY])
+			continue;
+
+		BuildRow(tileY, tileCosts);
+		m_isRowDirty[tileY] = 0;
+		m_linesRebuilt++;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool JumpPointTable::IsBuiltFor(const IntVec2& mapDimensions) const
+{
+	return m_mapDimensions == mapDimensions && !m_jumpDistances.empty();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int JumpPointTable::GetJumpDistance(int tileIndex, eJumpDirection direction) const
+{
+	return m_jumpDistances[tileIndex * NUM_JUMP_DIRECTIONS + direction];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Walks the column from each end, so every tile extends the jump of the tile it steps onto
+// The rules are AStarPather::JumpVertical's: stop on a forced east or west neighbor, fail on a wall
+//------------------------------------------------------------------------------------------------------------------------------
+void JumpPointTable::BuildColumn(int tileX, const std::vector<int>& tileCosts)
+{
+	for (int dirY = -1; dirY <= 1; dirY += 2)
+	{
+		eJumpDirection direction = dirY > 0 ? JUMP_NORTH : JUMP_SOUTH;
+		int firstY = dirY > 0 ? m_mapDimensions.y - 1 : 0;
+
+		for (int tileY = firstY; tileY >= 0 && tileY < m_mapDimensions.y; tileY -= dirY)
+		{
+			int nextY = tileY + dirY;
+			short jumpDistance = 0;
+
+			if (!IsTileBlocked(tileX, nextY, tileCosts))
+			{
+				if (IsForcedVertically(tileX, nextY, dirY, tileCosts))
+				{
+					jumpDistance = 1;
+				}
+				else
+				{
+					short nextDistance = m_jumpDistances[(nextY * m_mapDimensions.x + tileX) * NUM_JUMP_DIRECTIONS + direction];
+					jumpDistance = nextDistance > 0 ? nextDistance + 1 : nextDistance - 1;
+				}
+			}
+
+			m_jumpDistances[(tileY * m_mapDimensions.x + tileX) * NUM_JUMP_DIRECTIONS + direction] = jumpDistance;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// The rules are AStarPather::JumpHorizontal's: stop where a vertical jump finds a jump point, fail on a wall
+//------------------------------------------------------------------------------------------------------------------------------
+void JumpPointTable::BuildRow(int tileY, const std::vector<int>& tileCosts)
+{
+	for (int dirX = -1; dirX <= 1; dirX += 2)
+	{
+		eJumpDirection direction = dirX > 0 ? JUMP_EAST : JUMP_WEST;
+		int firstX = dirX > 0 ? m_mapDimensions.x - 1 : 0;
+
+		for (int tileX = firstX; tileX >= 0 && tileX < m_mapDimensions.x; tileX -= dirX)
+		{
+			int nextX = tileX + dirX;
+			short jumpDistance = 0;
+
+			if (!IsTileBlocked(nextX, tileY, tileCosts))
+			{
+				int nextIndex = tileY * m_mapDimensions.x + nextX;
+				if (HasVerticalJumpPoint(nextIndex))
+				{
+					jumpDistance = 1;
+				}
+				else
+				{
+					short nextDistance = m_jumpDistances[nextIndex * NUM_JUMP_DIRECTIONS + direction];
+					jumpDistance = nextDistance > 0 ? nextDistance + 1 : nextDistance - 1;
+				}
+			}
+
+			m_jumpDistances[(tileY * m_mapDimensions.x + tileX) * NUM_JUMP_DIRECTIONS + direction] = jumpDistance;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool JumpPointTable::IsTileBlocked(int tileX, int tileY, const std::vector<int>& tileCosts) const
+{
+	if (tileX < 0 || tileY < 0 || tileX >= m_mapDimensions.x || tileY >= m_mapDimensions.y)
+	{
+		return true;
+	}
+
+	return tileCosts[tileY * m_mapDimensions.x + tileX] >= ASTAR_IMPASSABLE_COST;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Stepping onto the tile while moving dirY, a wall behind it to the east or west opens up beside it
+//------------------------------------------------------------------------------------------------------------------------------
+bool JumpPointTable::IsForcedVertically(int tileX, int tileY, int dirY, const std::vector<int>& tileCosts) const
+{
+	bool forcedEast = IsTileBlocked(tileX + 1, tileY - dirY, tileCosts) && !IsTileBlocked(tileX + 1, tileY, tileCosts);
+	bool forcedWest = IsTileBlocked(tileX - 1, tileY - dirY, tileCosts) && !IsTileBlocked(tileX - 1, tileY, tileCosts);
+	return forcedEast || forcedWest;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool JumpPointTable::HasVerticalJumpPoint(int tileIndex) const
+{
+	return m_jumpDistances[tileIndex * NUM_JUMP_DIRECTIONS + JUMP_NORTH] > 0 || m_jumpDistances[tileIndex * NUM_JUMP_DIRECTIONS + JUMP_SOUTH] > 0;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <vector>
+#include "IntVec2.hpp"
+
+enum eJumpDirection
+{
+	JUMP_EAST = 0,	//+x
+	JUMP_WEST,		//-x
+	JUMP_NORTH,		//+y
+	JUMP_SOUTH,		//-y
+	NUM_JUMP_DIRECTIONS
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// JPS+ jump distances for AStarPather's Jump Point Search, from every tile in each direction, so a jump is a lookup
+// instead of a walk. Above 0 the jump stops at a jump point that many tiles away, 0 or below it runs into a wall after
+// minus that many free tiles. The goal is not in the table, AStarPather checks it against the free tiles
+// Only whether a tile is blocked matters, so a cost map's costs can change without touching its table
+//------------------------------------------------------------------------------------------------------------------------------
+class JumpPointTable
+{
+public:
+	void			Build(const IntVec2& mapDimensions, const std::vector<int>& tileCosts);
+	void			UpdateChangedTiles(const std::vector<int>& tileCosts, const std::vector<int>& changedTiles);
+
+	bool			IsBuiltFor(const IntVec2& mapDimensions) const;
+	int				GetJumpDistance(int tileIndex, eJumpDirection direction) const;
+
+	int				m_linesRebuilt = 0;		//Columns and rows UpdateChangedTiles walked again
+
+private:
+	void			BuildColumn(int tileX, const std::vector<int>& tileCosts);
+	void			BuildRow(int tileY, const std::vector<int>& tileCosts);
+
+	bool			IsTileBlocked(int tileX, int tileY, const std::vector<int>& tileCosts) const;
+	bool			IsForcedVertically(int tileX, int tileY, int dirY, const std::vector<int>& tileCosts) const;
+	bool			HasVerticalJumpPoint(int tileIndex) const;
+
+private:
+	IntVec2						m_mapDimensions = IntVec2(0, 0);
+	std::vector<short>			m_jumpDistances;	//NUM_JUMP_DIRECTIONS per tile, side by side so a tile's four share a cache line
+
+	std::vector<unsigned char>	m_isColumnDirty;
+	std::vector<unsigned char>	m_isRowDirty;
+	std::vector<unsigned char>	m_hadVerticalJumpPoint;		//One column's flags from before it was rebuilt
+};
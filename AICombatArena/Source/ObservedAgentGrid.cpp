@@ -0,0 +1,110 @@
+#include "ObservedAgentGrid.hpp"
+#include "MathUtils.hpp"
+#include "CellRings.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ObservedAgentGrid::Init(int mapWidth)
+{
+	m_cellsPerRow = (mapWidth + OBSERVED_AGENT_GRID_CELL_SIZE - 1) / OBSERVED_AGENT_GRID_CELL_SIZE;
+	m_cellStarts.assign(m_cellsPerRow * m_cellsPerRow + 1, 0);
+	m_cellAgents.clear();
+	m_agentCells.clear();
+	m_snapshot = nullptr;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// The snapshot has to outlive the queries, the grid only keeps agent indices into it
+//------------------------------------------------------------------------------------------------------------------------------
+void ObservedAgentGrid::Build(const TurnSnapshot& snapshot)
+{
+	m_snapshot = &snapshot;
+
+	int numAgents = snapshot.numObservedAgents;
+	int numCells = m_cellsPerRow * m_cellsPerRow;
+
+	std::fill(m_cellStarts.begin(), m_cellStarts.end(), 0);
+	m_agentCells.resize(numAgents);
+	m_cellAgents.resize(numAgents);
+
+	for (int observedIndex = 0; observedIndex < numAgents; observedIndex++)
+	{
+		int cellIndex = GetCellIndex(snapshot.observedAgents[observedIndex].tileX, snapshot.observedAgents[observedIndex].tileY);
+		m_agentCells[observedIndex] = cellIndex;
+		m_cellStarts[cellIndex + 1]++;
+	}
+
+	for (int cellIndex = 0; cellIndex < numCells; cellIndex++)
+	{
+		m_cellStarts[cellIndex + 1] += m_cellStarts[cellIndex];
+	}
+
+	//m_cellStarts[cell] is used as the fill cursor, afterwards it holds where the next cell starts
+	for (int observedIndex = 0; observedIndex < numAgents; observedIndex++)
+	{
+		int cellIndex = m_agentCells[observedIndex];
+		m_cellAgents[m_cellStarts[cellIndex]] = observedIndex;
+		m_cellStarts[cellIndex]++;
+	}
+
+	for (int cellIndex = numCells; cellIndex > 0; cellIndex--)
+	{
+		m_cellStarts[cellIndex] = m_cellStarts[cellIndex - 1];
+	}
+	m_cellStarts[0] = 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Walks the cell rings out from the tile's cell until the best distance found beats everything further out
+//------------------------------------------------------------------------------------------------------------------------------
+int ObservedAgentGrid::FindClosest(const IntVec2& tile, const std::function<bool(int observedIndex)>& isCandidate) const
+{
+	if (m_snapshot == nullptr || m_snapshot->numObservedAgents == 0)
+		return -1;
+
+	int bestIndex = -1;
+	int bestDistance = 999999;
+
+	int centerCell = GetCellIndex(tile.x, tile.y);
+	int centerX = centerCell % m_cellsPerRow;
+	int centerY = centerCell / m_cellsPerRow;
+
+	VisitCellRings(centerX, centerY, m_cellsPerRow, OBSERVED_AGENT_GRID_CELL_SIZE,
+		[&](int ringLowerBound) { return bestDistance < ringLowerBound; },
+		[&](int cellX, int cellY) { SearchCell(cellX, cellY, tile, isCandidate, bestIndex, bestDistance); });
+
+	return bestIndex;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ObservedAgentGrid::SearchCell(int cellX, int cellY, const IntVec2& tile, const std::function<bool(int observedIndex)>& isCandidate, int& bestIndex, int& bestDistance) const
+{
+	int cellIndex = cellY * m_cellsPerRow + cellX;
+
+	for (int slot = m_cellStarts[cellIndex]; slot < m_cellStarts[cellIndex + 1]; slot++)
+	{
+		int observedIndex = m_cellAgents[slot];
+		const ObservedAgent& agent = m_snapshot->observedAgents[observedIndex];
+
+		int distance = GetManhattanDistance(tile, IntVec2(agent.tileX, agent.tileY));
+		if (distance > bestDistance || (distance == bestDistance && observedIndex > bestIndex))
+			continue;
+
+		if (!isCandidate(observedIndex))
+			continue;
+
+		bestIndex = observedIndex;
+		bestDistance = distance;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int ObservedAgentGrid::GetCellIndex(int tileX, int tileY) const
+{
+	int cellX = tileX / OBSERVED_AGENT_GRID_CELL_SIZE;
+	int cellY = tileY / OBSERVED_AGENT_GRID_CELL_SIZE;
+
+	cellX = cellX < 0 ? 0 : (cellX >= m_cellsPerRow ? m_cellsPerRow - 1 : cellX);
+	cellY = cellY < 0 ? 0 : (cellY >= m_cellsPerRow ? m_cellsPerRow - 1 : cellY);
+
+	return cellY * m_cellsPerRow + cellX;
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <vector>
+#include <functional>
+#include "IntVec2.hpp"
+#include "TurnSnapshot.hpp"
+
+constexpr int OBSERVED_AGENT_GRID_CELL_SIZE = 8;		//Tiles per cell side
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Buckets the turn's observed agents by map cell so a nearest-agent query only looks at the cells around the asker
+// Rebuilt every turn with a counting sort, the agents in each cell stay in observed agent order
+//------------------------------------------------------------------------------------------------------------------------------
+class ObservedAgentGrid
+{
+public:
+	void			Init(int mapWidth);
+	void			Build(const TurnSnapshot& snapshot);
+
+	//Returns the observed agent index closest to the tile by Manhattan distance, lowest index on ties, -1 if none qualify
+	int				FindClosest(const IntVec2& tile, const std::function<bool(int observedIndex)>& isCandidate) const;
+
+private:
+	int				GetCellIndex(int tileX, int tileY) const;
+	void			SearchCell(int cellX, int cellY, const IntVec2& tile, const std::function<bool(int observedIndex)>& isCandidate, int& bestIndex, int& bestDistance) const;
+
+private:
+	int					m_cellsPerRow = 0;
+	const TurnSnapshot*	m_snapshot = nullptr;
+
+	std::vector<int>	m_cellStarts;		//Where each cell's agents start in m_cellAgents, one extra entry for the end
+	std::vector<int>	m_cellAgents;		//Observed agent indices sorted by cell
+	std::vector<int>	m_agentCells;		//Scratch, the cell of each observed agent
+};
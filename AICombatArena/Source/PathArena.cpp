@@ -0,0 +1,174 @@
+#include "PathArena.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Direction codes in eOrderCode move order
+static const int s_codeOffsetX[4] = { 1, 0, -1, 0 };
+static const int s_codeOffsetY[4] = { 0, 1, 0, -1 };
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PathArena::Init(int numAgents)
+{
+	m_capacityInCodes = (numAgents > 1 ? numAgents : 1) * PATH_ARENA_CODES_PER_AGENT;
+
+	m_codes[0].assign(m_capacityInCodes / PATH_CODES_PER_BYTE, 0);
+	m_codes[1].assign(m_capacityInCodes / PATH_CODES_PER_BYTE, 0);
+
+	m_activeBuffer = 0;
+	m_numCodesUsed = 0;
+	m_numWritesDropped = 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Runs on the turn thread with nothing reading the arena. Growing here is the only place the arena allocates
+//------------------------------------------------------------------------------------------------------------------------------
+void PathArena::BeginTurn()
+{
+	int codesRequested = m_numCodesUsed;
+	if (codesRequested * 2 > m_capacityInCodes)
+	{
+		while (codesRequested * 2 > m_capacityInCodes)
+		{
+			m_capacityInCodes *= 2;
+		}
+
+		//The buffer being swapped out still holds the paths to carry over, resize keeps them
+		m_codes[0].resize(m_capacityInCodes / PATH_CODES_PER_BYTE, 0);
+		m_codes[1].resize(m_capacityInCodes / PATH_CODES_PER_BYTE, 0);
+	}
+
+	m_activeBuffer = 1 - m_activeBuffer;
+	m_numCodesUsed = 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PathArena::CarryPath(PackedPath_T& path)
+{
+	if (path.numTiles <= 1)
+	{
+		path.firstCode = 0;
+		return;
+	}
+
+	int numCodes = path.numTiles - 1;
+	int firstCode = AllocateCodes(numCodes);
+	if (firstCode < 0)
+	{
+		path.Clear();
+		return;
+	}
+
+	const std::vector<unsigned char>& oldCodes = m_codes[1 - m_activeBuffer];
+	std::vector<unsigned char>& newCodes = m_codes[m_activeBuffer];
+
+	for (int codeIndex = 0; codeIndex < numCodes; codeIndex++)
+	{
+		SetCode(newCodes, firstCode + codeIndex, GetCode(oldCodes, path.firstCode + codeIndex));
+	}
+
+	path.firstCode = firstCode;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Takes a path in the order the pathers return it, destination first and the next tile last. Steps have to be between
+// neighbouring tiles, which every pather guarantees by filling in jump points
+//------------------------------------------------------------------------------------------------------------------------------
+PackedPath_T PathArena::WritePath(const Path& path)
+{
+	PackedPath_T packedPath;
+
+	int numTiles = (int)path.size();
+	if (numTiles == 0)
+		return packedPath;
+
+	int firstCode = AllocateCodes(numTiles - 1);
+	if (firstCode < 0)
+		return packedPath;
+
+	std::vector<unsigned char>& codes = m_codes[m_activeBuffer];
+
+	for (int tileIndex = numTiles - 1; tileIndex > 0; tileIndex--)
+	{
+		int deltaX = path[tileIndex - 1].x - path[tileIndex].x;
+		int deltaY = path[tileIndex - 1].y - path[tileIndex].y;
+
+		unsigned char code = deltaX > 0 ? 0 : (deltaY > 0 ? 1 : (deltaX < 0 ? 2 : 3));
+		SetCode(codes, firstCode + numTiles - 1 - tileIndex, code);
+	}
+
+	packedPath.firstCode = firstCode;
+	packedPath.numTiles = numTiles;
+	packedPath.nextX = (short)path.back().x;
+	packedPath.nextY = (short)path.back().y;
+	packedPath.destX = (short)path.front().x;
+	packedPath.destY = (short)path.front().y;
+
+	return packedPath;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PathArena::PopStep(PackedPath_T& path) const
+{
+	if (path.numTiles <= 1)
+	{
+		path.Clear();
+		return;
+	}
+
+	unsigned char code = GetCode(m_codes[m_activeBuffer], path.firstCode);
+	path.nextX = (short)(path.nextX + s_codeOffsetX[code]);
+	path.nextY = (short)(path.nextY + s_codeOffsetY[code]);
+
+	path.firstCode++;
+	path.numTiles--;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+IntVec2 PathArena::GetStepOffset(const PackedPath_T& path, int tileIndex) const
+{
+	unsigned char code = GetCode(m_codes[m_activeBuffer], path.firstCode + tileIndex);
+	return IntVec2(s_codeOffsetX[code], s_codeOffsetY[code]);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int PathArena::GetCapacityInCodes() const
+{
+	return m_capacityInCodes;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int PathArena::GetNumCodesUsed() const
+{
+	return m_numCodesUsed < m_capacityInCodes ? (int)m_numCodesUsed : m_capacityInCodes;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Rounded up to whole bytes so writers on different threads never touch the same byte. Returns -1 when full
+//------------------------------------------------------------------------------------------------------------------------------
+int PathArena::AllocateCodes(int numCodes)
+{
+	int numCodesRounded = (numCodes + PATH_CODES_PER_BYTE - 1) & ~(PATH_CODES_PER_BYTE - 1);
+	int firstCode = m_numCodesUsed.fetch_add(numCodesRounded);
+
+	if (firstCode + numCodesRounded > m_capacityInCodes)
+	{
+		m_numWritesDropped++;
+		return -1;
+	}
+
+	return firstCode;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+unsigned char PathArena::GetCode(const std::vector<unsigned char>& codes, int codeIndex) const
+{
+	return (codes[codeIndex / PATH_CODES_PER_BYTE] >> ((codeIndex % PATH_CODES_PER_BYTE) * 2)) & 0x3;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PathArena::SetCode(std::vector<unsigned char>& codes, int codeIndex, unsigned char code)
+{
+	unsigned char& codeByte = codes[codeIndex / PATH_CODES_PER_BYTE];
+	int shift = (codeIndex % PATH_CODES_PER_BYTE) * 2;
+
+	codeByte = (unsigned char)((codeByte & ~(0x3 << shift)) | (code << shift));
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <vector>
+#include <atomic>
+#include "IntVec2.hpp"
+
+typedef std::vector<IntVec2> Path;
+
+constexpr int PATH_ARENA_CODES_PER_AGENT = 1024;	//Starting arena size per agent, in steps
+constexpr int PATH_CODES_PER_BYTE = 4;
+
+//------------------------------------------------------------------------------------------------------------------------------
+// An agent's path as a handle into the PathArena. Only the next tile and the destination are kept as coordinates, every
+// step after the next tile is a 2-bit direction code in the arena
+//------------------------------------------------------------------------------------------------------------------------------
+struct PackedPath_T
+{
+	int		firstCode = 0;		//Arena code of the step off the next tile
+	int		numTiles = 0;		//Tiles left to walk, the next tile included
+	short	nextX = 0;
+	short	nextY = 0;
+	short	destX = 0;
+	short	destY = 0;
+	bool	isBlocked = false;	//A tile on it turned impassable, it is kept for its destination until it is repaired
+
+	bool	IsEmpty() const				{ return numTiles == 0; }
+	int		GetNumTiles() const			{ return numTiles; }
+	IntVec2	GetNextTile() const			{ return IntVec2(nextX, nextY); }
+	IntVec2	GetDestination() const		{ return IntVec2(destX, destY); }
+	void	Clear()						{ numTiles = 0; isBlocked = false; }
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Pooled storage for every agent's path, 4 steps to a byte. Writes bump a shared counter, so chunks on different threads
+// can store paths at once without allocating; each write starts on a fresh byte so no two writers share one
+// There are two buffers: BeginTurn swaps them and the paths still being walked are carried over with CarryPath, which
+// drops the steps already taken. The buffers only grow, between turns, when a turn came close to filling them
+//------------------------------------------------------------------------------------------------------------------------------
+class PathArena
+{
+public:
+	void			Init(int numAgents);
+
+	void			BeginTurn();								//Every live path must be carried over right after
+	void			CarryPath(PackedPath_T& path);
+
+	PackedPath_T	WritePath(const Path& path);				//Empty if the arena is full this turn
+	void			PopStep(PackedPath_T& path) const;
+	IntVec2			GetStepOffset(const PackedPath_T& path, int tileIndex) const;	//From tile tileIndex to the one after
+
+	int				GetCapacityInCodes() const;
+	int				GetNumCodesUsed() const;
+
+	std::atomic<int>	m_numWritesDropped = 0;
+
+private:
+	int				AllocateCodes(int numCodes);
+	unsigned char	GetCode(const std::vector<unsigned char>& codes, int codeIndex) const;
+	void			SetCode(std::vector<unsigned char>& codes, int codeIndex, unsigned char code);
+
+private:
+	std::vector<unsigned char>	m_codes[2];
+	int							m_activeBuffer = 0;
+	int							m_capacityInCodes = 0;
+
+	std::atomic<int>			m_numCodesUsed = 0;		//Failed writes count too, so BeginTurn sees what the turn asked for
+};
@@ -1,10 +1,8 @@
 //------------------------------------------------------------------------------------------------------------------------------
 #include "Pathing.hpp"
-#include "RandomNumberGenerator.hpp"
 #include "AICommons.hpp"
 #include "ErrorWarningAssert.hpp"
-
-extern RandomNumberGenerator* g_RNG;
+#include <math.h>
 
 //------------------------------------------------------------------------------------------------------------------------------
 void Pather::Init(const IntVec2& mapSize, float initialCost)
@@ -36,344 +34,213 @@ void Pather::AddCost(const IntVec2& cell, float costToAdd)
 	m_costs.Set(cell, newCost);
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+// Copies an integer cost map (indexed y * width + x) into the float costs
+//------------------------------------------------------------------------------------------------------------------------------
+void Pather::SetCostsFromCostMap(const std::vector<int>& costMap)
+{
+	for (int tileIndex = 0; tileIndex < (int)costMap.size(); tileIndex++)
+	{
+		m_costs.SetAtIndex(tileIndex, (float)costMap[tileIndex]);
+	}
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 // Method to create the distance field based on costs
 //------------------------------------------------------------------------------------------------------------------------------
 void PathSolver::StartDistanceField(Pather* pather, Path* unitPath)
 {
-	m_visited.clear();
 	m_pather = pather;
-	PathInfo_T info;
-	m_pathInfo.Init(m_pather->m_costs.GetSize(), info);
+	m_mapSize = m_pather->m_costs.GetSize();
+	int mapTileCount = m_mapSize.x * m_mapSize.y;
 
-	//Make array for neighbor tiles and an openList vector
-	std::vector<PathInfo_T> neighbors(4);
-	std::vector<PathInfo_T> openList;
+	m_distanceField.Init(m_mapSize, INFINITY);
+	m_directionField.Init(m_mapSize, FLOW_DIRECTION_NONE);
+	m_seedField.Init(m_mapSize, -1);
 
-	//Push the seed into openList
-	info.cost = m_pather->m_costs.Get(m_endPoint);
-	info.tile = m_endPoint;
-	info.parent = m_endPoint;
-	openList.push_back(info);
-	PathInfo_T prevTile = info;
-	PathInfo_T lowestCostCell;
+	if (m_openList.GetCapacity() != mapTileCount)
+	{
+		m_openList.Init(mapTileCount);
+	}
+	m_openList.Clear();
 
-	//Run Dijkstra Path Finder
-	while (!openList.empty())
+	//Push the seeds into openList
+	for (int endIndex = 0; endIndex < (int)m_endPoints.size(); endIndex++)
 	{
-		//Get cell with minimum cost and delete from set
-		lowestCostCell = PopLowestCostCellFromList(openList);
+		const IntVec2& endPoint = m_endPoints[endIndex];
+		if (!endPoint.IsInBounds(m_mapSize))
+			continue;
 
-		//Visit the lowest cost cell
-		m_visited.push_back(lowestCostCell);
-		info.cost = m_pather->m_costs.Get(lowestCostCell.tile) + lowestCostCell.cost;
-		info.state = PATH_STATE_VISITED;
-		info.tile = lowestCostCell.tile;
-		info.parent = prevTile.tile;
-		prevTile = lowestCostCell;
-		prevTile.parent = lowestCostCell.tile;
+		int tileIndex = GetIndexForTile(endPoint);
+		if (m_openList.Contains(tileIndex))
+			continue;
 
-		m_pathInfo.Set(lowestCostCell.tile, info);
+		m_distanceField.Set(endPoint, 0.f);
+		m_seedField.Set(endPoint, endIndex);
+		m_openList.Push(tileIndex, 0.f);
+	}
 
-		if (info.tile == m_startPoint)
+	//Run Dijkstra Path Finder
+	while (!m_openList.IsEmpty())
+	{
+		//Get cell with minimum cost, it is settled once it leaves the heap
+		IntVec2 currentTile = GetTileForIndex(m_openList.Pop());
+		m_nodesExpanded++;
+
+		if (currentTile == m_startPoint)
 		{
 			break;
 		}
 
-		//Get neighbors and push into open list
-		GetNeighbors(lowestCostCell, neighbors);
-		SetNeighborCosts(neighbors, lowestCostCell.cost);
-		PushToOpenList(neighbors, openList);
+		//Walking from a neighbor onto this tile costs this tile's cost
+		float distance = m_distanceField.Get(currentTile) + m_pather->m_costs.Get(currentTile);
+		int endIndex = m_seedField.Get(currentTile);
 
+		RelaxNeighbor(IntVec2(currentTile.x - 1, currentTile.y), distance, FLOW_DIRECTION_EAST, endIndex);
+		RelaxNeighbor(IntVec2(currentTile.x + 1, currentTile.y), distance, FLOW_DIRECTION_WEST, endIndex);
+		RelaxNeighbor(IntVec2(currentTile.x, currentTile.y + 1), distance, FLOW_DIRECTION_SOUTH, endIndex);
+		RelaxNeighbor(IntVec2(currentTile.x, currentTile.y - 1), distance, FLOW_DIRECTION_NORTH, endIndex);
 	}
 
-	FallDownToShortestPath(*unitPath);
-}
+	m_openList.Clear();
 
-//------------------------------------------------------------------------------------------------------------------------------
-PathInfo_T PathSolver::PopLowestCostCellFromList(std::vector<PathInfo_T>& openList)
-{
-	float lowestCost = 1000000.f;
-	PathInfo_T lowestCostCell;
-	lowestCostCell.tile = IntVec2(-1, -1);
-	int lowestIndex = 0;
-	for (int index = 0; index < openList.size(); index++)
+	if (unitPath != nullptr && m_startPoint.IsInBounds(m_mapSize))
 	{
-		if (openList[index].tile == IntVec2(-1, -1))
-			continue;
-
-		if (openList[index].cost < lowestCost)
-		{
-			lowestCost = openList[index].cost;
-			lowestCostCell = openList[index];
-			lowestIndex = index;
-		}
+		FallDownToShortestPath(*unitPath);
 	}
-
-	openList.erase(openList.begin() + lowestIndex);
-	return lowestCostCell;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-void PathSolver::PushToOpenList(const std::vector<PathInfo_T>& neighbors, std::vector<PathInfo_T>& openList)
+void PathSolver::RelaxNeighbor(const IntVec2& neighbor, float distance, eFlowDirection directionToCurrent, int endIndex)
 {
-	for (int index = 0; index < 4; index++)
-	{
-		if (neighbors[index].tile != IntVec2(-1, -1))
-		{
-			if (std::find(openList.begin(), openList.end(), neighbors[index]) == openList.end())
-			{
-				if (m_pathInfo.Get(neighbors[index].tile).state == PATH_STATE_UNVISITED)
-				{
-					openList.push_back(neighbors[index]);
-				}
-			}
-		}
-	}
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-void PathSolver::GetNeighbors(const PathInfo_T& cell, std::vector<PathInfo_T>& neighbors)
-{
-	PathInfo_T neighbor;
-
-	//Left neighbor
-	neighbor.tile = cell.tile;
-	neighbor.tile.x -= 1;
-	neighbor.cost = m_pather->m_costs.Get(cell.tile);
-	SetNeighbor(neighbor, neighbors, 0);
-
-	//Right neighbor
-	neighbor = cell;
-	neighbor.tile.x += 1;
-	neighbor.cost = m_pather->m_costs.Get(cell.tile);
-	SetNeighbor(neighbor, neighbors, 1);
-
-	//Top neighbor
-	neighbor = cell;
-	neighbor.tile.y += 1;
-	neighbor.cost = m_pather->m_costs.Get(cell.tile);
-	SetNeighbor(neighbor, neighbors, 2);
-
-	//Bottom neighbor
-	neighbor = cell;
-	neighbor.tile.y -= 1;
-	neighbor.cost = m_pather->m_costs.Get(cell.tile);
-	SetNeighbor(neighbor, neighbors, 3);
-}
-
-//------------------------------------------------------------------------------------------------------------------------------
-void PathSolver::GetNeighborsFromVisited(const PathInfo_T& cell, std::vector<PathInfo_T>& neighbors)
-{
-	PathInfo_T neighbor;
-	PathInfo_T defaultInfo;
-	neighbor.tile = cell.tile;
-	IntVec2 bounds = m_pather->m_costs.GetSize();
-
-	//Left neighbor
-	neighbor.tile.x -= 1;
-	if (neighbor.tile.IsInBounds(bounds))
-	{
-		neighbor.cost = m_pathInfo.Get(neighbor.tile).cost;
-		SetNeighbor(neighbor, neighbors, 0);
-	}
-	else
-	{
-
-		SetNeighbor(defaultInfo, neighbors, 0);
-	}
+	if (!neighbor.IsInBounds(m_mapSize))
+		return;
 
-	//Right neighbor
-	neighbor = cell;
-	neighbor.tile.x += 1;
-	if (neighbor.tile.IsInBounds(bounds))
-	{
-		neighbor.cost = m_pathInfo.Get(neighbor.tile).cost;
-		SetNeighbor(neighbor, neighbors, 1);
-	}
-	else
-	{
+	if (m_pather->m_costs.Get(neighbor) >= PATHER_IMPASSABLE_COST)
+		return;
 
-		SetNeighbor(defaultInfo, neighbors, 1);
-	}
+	if (distance >= m_distanceField.Get(neighbor))
+		return;
 
-	//Top neighbor
-	neighbor = cell;
-	neighbor.tile.y += 1;
-	if (neighbor.tile.IsInBounds(bounds))
-	{
-		neighbor.cost = m_pathInfo.Get(neighbor.tile).cost;
-		SetNeighbor(neighbor, neighbors, 2);
-	}
-	else
-	{
+	int tileIndex = GetIndexForTile(neighbor);
+	bool wasOpen = m_openList.Contains(tileIndex);
 
-		SetNeighbor(defaultInfo, neighbors, 2);
-	}
+	m_distanceField.Set(neighbor, distance);
+	m_directionField.Set(neighbor, directionToCurrent);
+	m_seedField.Set(neighbor, endIndex);
 
-	//Bottom neighbor
-	neighbor = cell;
-	neighbor.tile.y -= 1;
-	if (neighbor.tile.IsInBounds(bounds))
+	if (wasOpen)
 	{
-		neighbor.cost = m_pathInfo.Get(neighbor.tile).cost;
-		SetNeighbor(neighbor, neighbors, 3);
+		m_openList.DecreasePriority(tileIndex, distance);
 	}
 	else
 	{
-
-		SetNeighbor(defaultInfo, neighbors, 3);
+		m_openList.Push(tileIndex, distance);
 	}
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-void PathSolver::GetCheapestNeighbors(std::vector<PathInfo_T>& cheapestCostCells, const std::vector<PathInfo_T>& list)
+void PathSolver::AddEnd(const IntVec2& tile)
 {
-	float lowestCost = 1000000.f;
-
-	for (int index = 0; index < list.size(); ++index)
-	{
-		if (list[index].tile == IntVec2(-1, -1))
-			continue;
-
-		if (m_pathInfo.Get(list[index].tile).cost <= lowestCost)
-		{
-			lowestCost = m_pathInfo.Get(list[index].tile).cost;
-			cheapestCostCells.push_back(list[index]);
-		}
-	}
+	m_endPoints.push_back(tile);
+}
 
-	//Remove anything that has a cost less than the lowestCost 
-	for (int cheapestListIndex = 0; cheapestListIndex < (int)cheapestCostCells.size(); ++cheapestListIndex)
-	{
-		if (cheapestCostCells[cheapestListIndex].cost > lowestCost)
-		{
-			cheapestCostCells.erase(cheapestCostCells.begin() + cheapestListIndex);
-			--cheapestListIndex;
-		}
-	}
+//------------------------------------------------------------------------------------------------------------------------------
+void PathSolver::AddStart(const IntVec2& tile)
+{
+	m_startPoint = tile;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-void PathSolver::SetNeighbor(const PathInfo_T neighbor, std::vector<PathInfo_T>& neighborsArray, int index)
+void PathSolver::ClearEndsAndStart()
 {
-	if (neighbor.tile.IsInBounds(m_pather->m_costs.GetSize()))
-	{
-		neighborsArray[index] = neighbor;
-	}
-	else
-	{
-		PathInfo_T info;
-		neighborsArray[index] = info;
-	}
+	m_endPoints.clear();
+	m_startPoint = IntVec2(-1, -1);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-void PathSolver::SetNeighborCosts(std::vector<PathInfo_T>& neighborsArray, float previousTileCost)
+// Follows the direction field from the start to a seed, one step per tile on the path
+//------------------------------------------------------------------------------------------------------------------------------
+void PathSolver::FallDownToShortestPath(Path& shortestPath)
 {
-	for (int index = 0; index < 4; index++)
+	shortestPath.push_back(m_startPoint);
+
+	if (!IsReachable(m_startPoint))
+		return;
+
+	int maxSteps = m_mapSize.x * m_mapSize.y;
+	IntVec2 currentTile = m_startPoint;
+
+	for (eFlowDirection direction = GetDirection(currentTile); direction != FLOW_DIRECTION_NONE; direction = GetDirection(currentTile))
 	{
-		if (neighborsArray[index].tile != IntVec2(-1, -1))
+		switch (direction)
 		{
-			neighborsArray[index].cost = m_pather->m_costs.Get(neighborsArray[index].tile) + previousTileCost;
+		case FLOW_DIRECTION_EAST:	currentTile.x += 1;	break;
+		case FLOW_DIRECTION_WEST:	currentTile.x -= 1;	break;
+		case FLOW_DIRECTION_NORTH:	currentTile.y += 1;	break;
+		case FLOW_DIRECTION_SOUTH:	currentTile.y -= 1;	break;
+		default:					return;
 		}
 
-		//If the neighbor has been visited already, update his cost
-		for (int visitedIndex = 0; visitedIndex < (int)m_visited.size(); visitedIndex++)
+		shortestPath.push_back(currentTile);
+
+		if ((int)shortestPath.size() > maxSteps)
 		{
-			std::vector<PathInfo_T>::iterator neighborVisited = std::find(m_visited.begin(), m_visited.end(), neighborsArray[index]);
-			if (neighborVisited != m_visited.end())
-			{
-				if (neighborVisited->cost > neighborsArray[index].cost)
-				{
-					neighborVisited->cost = neighborsArray[index].cost;
-					neighborVisited->tile = neighborsArray[index].tile;
-				}
-			}
+			ERROR_RECOVERABLE("Direction field has a loop in it");
+			return;
 		}
 	}
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-void PathSolver::AddEnd(const IntVec2& tile)
+// The lookups treat a field that was never started as unreachable everywhere, its map size is still 0 by 0
+//------------------------------------------------------------------------------------------------------------------------------
+float PathSolver::GetDistance(const IntVec2& tile) const
 {
-	m_endPoint = tile;
+	if (!tile.IsInBounds(m_mapSize))
+		return INFINITY;
+
+	return m_distanceField.Get(tile);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-void PathSolver::AddStart(const IntVec2& tile)
+eFlowDirection PathSolver::GetDirection(const IntVec2& tile) const
 {
-	m_startPoint = tile;
+	if (!tile.IsInBounds(m_mapSize))
+		return FLOW_DIRECTION_NONE;
+
+	return m_directionField.Get(tile);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-void PathSolver::FallDownToShortestPath(Path& shortestPath)
+IntVec2 PathSolver::GetClosestEnd(const IntVec2& tile) const
 {
-	//m_endPoint;
-
-	shortestPath.push_back(m_startPoint);
-	std::vector<PathInfo_T> neighbors(4);
-	std::vector<PathInfo_T> lowestCostCells;
-	PathInfo_T lowestCostCell;
-
-	PathInfo_T lastCell = m_pathInfo.Get(m_startPoint);
+	if (!tile.IsInBounds(m_mapSize))
+		return IntVec2(-1, -1);
 
-	while (shortestPath[(int)shortestPath.size() - 1] != m_endPoint)
+	int endIndex = m_seedField.Get(tile);
+	if (endIndex == -1)
 	{
-		lowestCostCells.clear();
-
-		//Get neighbors
-		GetNeighborsFromVisited(lastCell, neighbors);
-		RemoveNeighborsIfInList(neighbors, shortestPath);
-		GetCheapestNeighbors(lowestCostCells, neighbors);
-
-		if ((int)lowestCostCells.size() > 1)
-		{
-			//Pick one of the cells
-			int randomIndex = g_RNG->GetRandomIntInRange(0, (int)lowestCostCells.size() - 1);
-			lowestCostCell = lowestCostCells[randomIndex];
-		}
-		else if (lowestCostCells.size() == 0)
-		{
-			ERROR_RECOVERABLE("There are no lowest cost cells");
-		}
-		else
-		{
-			lowestCostCell = lowestCostCells[0];
-		}
+		return IntVec2(-1, -1);
+	}
 
-		if (std::find(shortestPath.begin(), shortestPath.end(), lowestCostCell.tile) == shortestPath.end())
-		{
-			shortestPath.push_back(lowestCostCell.tile);
-		}
+	return m_endPoints[endIndex];
+}
 
-		lastCell = lowestCostCell;
-	}
+//------------------------------------------------------------------------------------------------------------------------------
+bool PathSolver::IsReachable(const IntVec2& tile) const
+{
+	return tile.IsInBounds(m_mapSize) && m_distanceField.Get(tile) != INFINITY;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-void PathSolver::RemoveNeighborsIfInList(std::vector<PathInfo_T>& neighbors, std::vector<IntVec2>& shortestPath)
+int PathSolver::GetIndexForTile(const IntVec2& tile) const
 {
-	for (int index = 0; index < (int)neighbors.size(); ++index)
-	{
-		if (std::find(shortestPath.begin(), shortestPath.end(), neighbors[index].tile) != shortestPath.end())
-		{
-			//Reset this element as we don't need it
-			PathInfo_T info;
-			neighbors[index] = info;
-		}
-	}
+	return tile.y * m_mapSize.x + tile.x;
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
-bool PathInfo_T::operator==(const PathInfo_T& compare) const
+IntVec2 PathSolver::GetTileForIndex(int tileIndex) const
 {
-	if (cost == compare.cost && tile == compare.tile && state == compare.state)
-	{
-		return true;
-	}
-	else
-	{
-		return false;
-	}
+	return IntVec2(tileIndex % m_mapSize.x, tileIndex / m_mapSize.x);
 }
@@ -2,26 +2,26 @@
 
 #include "IntVec2.hpp"
 #include "Array2D.hpp"
+#include "IndexedPriorityQueue.hpp"
 
-enum ePathState
-{
-	PATH_STATE_UNVISITED = 0,
-	PATH_STATE_VISITED,
-	PATH_STATE_FINISHED,
-};
+constexpr float PATHER_IMPASSABLE_COST = 99999.f;	//Tiles costing this much or more are never flooded through
 
-struct PathInfo_T
+//------------------------------------------------------------------------------------------------------------------------------
+// Step to take from a tile to get one tile closer to the nearest seed
+// Values line up with ORDER_MOVE_EAST..ORDER_MOVE_SOUTH so they can be cast straight to an eOrderCode
+enum eFlowDirection : unsigned char
 {
-	float cost = INFINITY;  // how much did it cost to reach this point
-	IntVec2 tile = IntVec2(-1, -1);  //Who am I
-	IntVec2 parent = IntVec2(-1,-1);// who was I visited by
-	ePathState state = PATH_STATE_UNVISITED;
-
-	bool	operator==(const PathInfo_T& compare) const;
+	FLOW_DIRECTION_NONE = 0,	//Seed tiles and tiles the flood fill never reached
+	FLOW_DIRECTION_EAST,
+	FLOW_DIRECTION_NORTH,
+	FLOW_DIRECTION_WEST,
+	FLOW_DIRECTION_SOUTH,
 };
 
 typedef Array2D<float> TileCosts;
-typedef Array2D<PathInfo_T> PathInfo;
+typedef Array2D<float> DistanceField;
+typedef Array2D<eFlowDirection> DirectionField;
+typedef Array2D<int> SeedField;
 typedef std::vector<IntVec2> Path;
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -35,44 +35,52 @@ public:
 	void		SetAllCosts(float cost);
 	void		SetCost(const IntVec2& cell, float cost);
 	void		AddCost(const IntVec2& cell, float costToAdd);
+	void		SetCostsFromCostMap(const std::vector<int>& costMap);
 
 public:
 	TileCosts	m_costs;
 };
 
 //------------------------------------------------------------------------------------------------------------------------------
-// This object will use the Pather and run Dijkstra to create a path
+// This object will use the Pather and run Dijkstra to create a distance field and a direction field
+// Every seed added with AddEnd has distance 0, all other tiles store the cheapest cost of walking to any seed
 //------------------------------------------------------------------------------------------------------------------------------
 class PathSolver
 {
 public:
 	//The function that actually takes a pather and does the distance field calculations
-	//You need to set a seed point (the end we set) and calculate Distance Field from it
-	void		StartDistanceField(Pather* pather, Path* unitPath);
+	//You need to set at least one seed point (the end we set) and calculate Distance Field from it
+	//If a start point was added the flood fill stops once the start is settled and unitPath is filled
+	void			StartDistanceField(Pather* pather, Path* unitPath);
 
-	PathInfo_T	PopLowestCostCellFromList(std::vector<PathInfo_T>& openList);
-	void		PushToOpenList(const std::vector<PathInfo_T>& neighbors, std::vector<PathInfo_T>& openList);
+	void			AddEnd(const IntVec2& tile);		//We will flood fill from this destination, can be called for multiple seeds
+	void			AddStart(const IntVec2& tile);		//Technically becomes our end point for Dijkstra
+	void			ClearEndsAndStart();
 
-	void		GetNeighbors(const PathInfo_T& cell, std::vector<PathInfo_T>& neighbors);
-	void		GetNeighborsFromVisited(const PathInfo_T& cell, std::vector<PathInfo_T>& neighbors);
-	void		GetCheapestNeighbors(std::vector<PathInfo_T>& cheapestCostCells, const std::vector<PathInfo_T>& list);
+	void			FallDownToShortestPath(Path& shortestPath);
 
-	void		SetNeighbor(const PathInfo_T neighbor, std::vector<PathInfo_T>& neighborsArray, int index);
-	void		SetNeighborCosts(std::vector<PathInfo_T>& neighborsArray, float previousTileCost);
+	float			GetDistance(const IntVec2& tile) const;
+	eFlowDirection	GetDirection(const IntVec2& tile) const;
+	IntVec2			GetClosestEnd(const IntVec2& tile) const;	//The seed this tile flows down to, (-1,-1) if unreachable
+	bool			IsReachable(const IntVec2& tile) const;
 
-	void		AddEnd(const IntVec2& tile);		//We will flood fill from this destination
-	void		AddStart(const IntVec2& tile);		//Technically becomes our end point for Dijkstra
+	unsigned long long	m_nodesExpanded = 0;	//Tiles settled off the open list
 
-	void		FallDownToShortestPath(Path& shortestPath);
-	void		RemoveNeighborsIfInList(std::vector<PathInfo_T>& neighbors, std::vector<IntVec2>& shortestPath);
+private:
+	void			RelaxNeighbor(const IntVec2& neighbor, float distance, eFlowDirection directionToCurrent, int endIndex);
+	int				GetIndexForTile(const IntVec2& tile) const;
+	IntVec2			GetTileForIndex(int tileIndex) const;
 
 private:
 
-	Pather*						m_pather = nullptr;
-	std::vector<PathInfo_T>		m_visited;
-	std::vector<IntVec2>		m_termination_points; // used for ending early if you have a start point in mind; 
-	PathInfo					m_pathInfo;
+	Pather*							m_pather = nullptr;
+	IntVec2							m_mapSize = IntVec2(0, 0);
+
+	DistanceField					m_distanceField;
+	DirectionField					m_directionField;
+	SeedField						m_seedField;	//Index into m_endPoints of the closest seed
+	IndexedPriorityQueue<float>		m_openList;
 
-	IntVec2			m_endPoint = IntVec2(-1, -1);	//Start of flood fill
-	IntVec2			m_startPoint = IntVec2(-1, -1);
-};
\ No newline at end of file
+	std::vector<IntVec2>			m_endPoints;	//Seeds of the flood fill
+	IntVec2							m_startPoint = IntVec2(-1, -1);
+};
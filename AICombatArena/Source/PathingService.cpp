@@ -0,0 +1,106 @@
+#include "PathingService.hpp"
+#include "MathUtils.hpp"
+#include "AICommons.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PathingService::Startup(const IntVec2& mapDimensions, int numThreads)
+{
+	m_mapDimensions = mapDimensions;
+
+	m_contexts.clear();
+	m_contexts.resize(numThreads > 1 ? numThreads : 1);
+
+	for (int contextIndex = 0; contextIndex < (int)m_contexts.size(); contextIndex++)
+	{
+		m_contexts[contextIndex].aStarPather.Init(mapDimensions);
+		HierarchicalPather::InitQueryContext(m_contexts[contextIndex].hpaContext, mapDimensions);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PathingService::ClearRequests()
+{
+	m_requests.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int PathingService::QueuePath(const PathRequest_T& request)
+{
+	m_requests.push_back(request);
+	return (int)m_requests.size() - 1;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int PathingService::GetNumRequests() const
+{
+	return (int)m_requests.size();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+Path& PathingService::GetResult(int requestIndex)
+{
+	return m_requests[requestIndex].result;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool PathingService::IsSolved(int requestIndex) const
+{
+	return m_requests[requestIndex].isSolved;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// One job per request, each thread solves with the context matching its thread index
+//------------------------------------------------------------------------------------------------------------------------------
+void PathingService::ProcessRequests(JobSystem& jobSystem, int threadIdx, const TurnScheduler* scheduler)
+{
+	jobSystem.ParallelFor((int)m_requests.size(), [this, scheduler](int requestIndex, int jobThreadIdx)
+	{
+		PathRequest_T& request = m_requests[requestIndex];
+		if (scheduler != nullptr && scheduler->IsPastDeadline())
+			return;
+
+		request.result = SolveRequest(request, m_contexts[jobThreadIdx % m_contexts.size()], m_mapDimensions);
+		request.isSolved = true;
+	}, threadIdx);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Solves on the calling thread; only safe while no batch is being processed
+//------------------------------------------------------------------------------------------------------------------------------
+Path PathingService::SolveNow(const PathRequest_T& request, int threadIdx)
+{
+	return SolveRequest(request, m_contexts[threadIdx % m_contexts.size()], m_mapDimensions);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Long trips try the cluster graph first so they are not cut short by the A* limit
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC Path PathingService::SolveRequest(const PathRequest_T& request, PathingContext_T& context, const IntVec2& mapDimensions)
+{
+	if (request.hierarchicalPather != nullptr)
+	{
+		IntVec2 startTile = IntVec2(request.startTileIndex % mapDimensions.x, request.startTileIndex / mapDimensions.x);
+		IntVec2 endTile = IntVec2(request.endTileIndex % mapDimensions.x, request.endTileIndex / mapDimensions.x);
+
+		if (GetManhattanDistance(startTile, endTile) > HPA_CLUSTER_SIZE)
+		{
+			Path path = request.hierarchicalPather->CreatePath(request.startTileIndex, request.endTileIndex, context.hpaContext);
+			if (path.size() > 0)
+				return path;
+		}
+	}
+
+	return context.aStarPather.CreatePath(request.startTileIndex, request.endTileIndex, mapDimensions, *request.tileCosts, request.uniformTileCost, request.limit, request.jumpPointTable);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const AStarPather& PathingService::GetAStarPather(int threadIdx) const
+{
+	return m_contexts[threadIdx % m_contexts.size()].aStarPather;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int PathingService::GetNumContexts() const
+{
+	return (int)m_contexts.size();
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <vector>
+#include "IntVec2.hpp"
+#include "JobSystem.hpp"
+#include "AStarPathing.hpp"
+#include "HierarchicalPathing.hpp"
+#include "TurnScheduler.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+// One path to solve. The cost map and hierarchical pather are only read while requests are being processed
+struct PathRequest_T
+{
+	int startTileIndex = -1;
+	int endTileIndex = -1;
+	int limit = 256;
+
+	const std::vector<int>*		tileCosts = nullptr;
+	int							uniformTileCost = -1;
+	const HierarchicalPather*	hierarchicalPather = nullptr;	//Optional, tried first for trips longer than a cluster
+	const JumpPointTable*		jumpPointTable = nullptr;		//Optional, built from tileCosts so uniform cost searches look jumps up
+
+	Path						result;
+	bool						isSolved = false;		//False if the turn ran out of time before it was picked up
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Everything a thread mutates while solving a request
+struct PathingContext_T
+{
+	AStarPather			aStarPather;
+	HPAQueryContext_T	hpaContext;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Paths queued during the turn are solved as jobs on every server thread at once, each with its own PathingContext_T
+//------------------------------------------------------------------------------------------------------------------------------
+class PathingService
+{
+public:
+	void			Startup(const IntVec2& mapDimensions, int numThreads);
+
+	void			ClearRequests();
+	int				QueuePath(const PathRequest_T& request);
+	int				GetNumRequests() const;
+	Path&			GetResult(int requestIndex);
+	bool			IsSolved(int requestIndex) const;
+
+	//Returns once every queued request has a result. Requests picked up past the scheduler's deadline are left unsolved
+	void			ProcessRequests(JobSystem& jobSystem, int threadIdx, const TurnScheduler* scheduler = nullptr);
+
+	Path			SolveNow(const PathRequest_T& request, int threadIdx);
+	static Path		SolveRequest(const PathRequest_T& request, PathingContext_T& context, const IntVec2& mapDimensions);
+
+	const AStarPather&	GetAStarPather(int threadIdx) const;
+	int				GetNumContexts() const;
+
+private:
+	IntVec2								m_mapDimensions = IntVec2(0, 0);
+	std::vector<PathingContext_T>		m_contexts;		//One per server thread, indexed by thread index
+	std::vector<PathRequest_T>			m_requests;
+};
@@ -55,16 +55,21 @@ void PlayerThreadEntry(int yourThreadIdx)
 {
 	AIPlayerController* player = AIPlayerController::GetInstance();
 
-	player->m_workerCostMapInitialized = false;
-	player->m_scoutCostMapInitialized = false;
-	player->m_soldierCostMapInitialized = false;
-
-	player->m_agentIterator = 0;
-
 	if (yourThreadIdx == 0)
 	{
+		player->m_workerCostMapInitialized = false;
+		player->m_scoutCostMapInitialized = false;
+		player->m_soldierCostMapInitialized = false;
+
+		player->m_agentIterator = 0;
+
 		player->WorkerThreadEntry(yourThreadIdx);
 	}
+	else
+	{
+		//Every other thread runs the per-agent and pathing jobs of each turn
+		player->JobThreadEntry(yourThreadIdx);
+	}
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
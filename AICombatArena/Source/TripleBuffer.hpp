@@ -0,0 +1,40 @@
+//------------------------------------------------------------------------------------------------------------------------------
+#pragma once
+#include <atomic>
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Lock-free handoff of the latest T from one producer thread to one consumer thread
+// The producer fills the write buffer and publishes it, the consumer acquires the newest published buffer. Neither
+// side ever waits on the other, a publish the consumer hasn't picked up yet is simply replaced by the next one
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+class TripleBuffer
+{
+public:
+	static constexpr int	NUM_BUFFERS = 3;
+
+	TripleBuffer();
+
+	T&				GetBuffer(int bufferIndex);		//Only for setting the buffers up before either thread uses them
+
+	//Producer side
+	T&				GetWriteBuffer();
+	void			Publish();
+
+	//Consumer side
+	bool			Acquire();			//Returns false and keeps the current read buffer if nothing new was published
+	T&				GetReadBuffer();
+	bool			HasNewData() const;
+
+private:
+	static constexpr unsigned int	INDEX_MASK = 0x3;
+	static constexpr unsigned int	FRESH_BIT = 0x4;	//Set on the shared index when it holds a buffer the consumer hasn't seen
+
+	T								m_buffers[NUM_BUFFERS];
+
+	unsigned int					m_writeIndex = 0;	//Only touched by the producer
+	unsigned int					m_readIndex = 1;	//Only touched by the consumer
+	std::atomic<unsigned int>		m_sharedIndex = 2;	//The buffer in between, swapped by both sides
+};
+
+#include "TripleBuffer.inl"
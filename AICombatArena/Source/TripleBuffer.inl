@@ -0,0 +1,56 @@
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+TripleBuffer<T>::TripleBuffer()
+{
+	//Empty constructor
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+T& TripleBuffer<T>::GetBuffer(int bufferIndex)
+{
+	return m_buffers[bufferIndex];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+T& TripleBuffer<T>::GetWriteBuffer()
+{
+	return m_buffers[m_writeIndex];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Hands the write buffer over and takes whichever buffer was in between to write into next
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+void TripleBuffer<T>::Publish()
+{
+	m_writeIndex = m_sharedIndex.exchange(m_writeIndex | FRESH_BIT, std::memory_order_acq_rel) & INDEX_MASK;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+bool TripleBuffer<T>::Acquire()
+{
+	if (!HasNewData())
+		return false;
+
+	m_readIndex = m_sharedIndex.exchange(m_readIndex, std::memory_order_acq_rel) & INDEX_MASK;
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// The consumer owns the read buffer until its next Acquire, so it may modify it too
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+T& TripleBuffer<T>::GetReadBuffer()
+{
+	return m_buffers[m_readIndex];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename T>
+bool TripleBuffer<T>::HasNewData() const
+{
+	return (m_sharedIndex.load(std::memory_order_acquire) & FRESH_BIT) != 0;
+}
@@ -0,0 +1,235 @@
+#include "TurnProfiler.hpp"
+#include "AICommons.hpp"
+#include "ErrorWarningAssert.hpp"
+#include <chrono>
+
+static const char* const g_turnPhaseNames[NUM_TURN_PHASES] =
+{
+	"Turn Copy",
+	"Cost Maps",
+	"Food Index",
+	"Agent Sync",
+	"Queen Decisions",
+	"Flow Fields",
+	"Food Assignment",
+	"Agent Decisions",
+	"Worker Decision",
+	"Soldier Decision",
+	"Scout Decision",
+	"Pathing",
+	"Order Publish",
+	"Turn Latency",
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+static int GetHighestBitIndex(unsigned long long value)
+{
+	int bitIndex = 0;
+	for (int shift = 32; shift > 0; shift >>= 1)
+	{
+		if ((value >> shift) != 0)
+		{
+			value >>= shift;
+			bitIndex += shift;
+		}
+	}
+
+	return bitIndex;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// The value at or under which the given share of the recorded values fall, exact to the bucket it lands in
+//------------------------------------------------------------------------------------------------------------------------------
+static unsigned long long GetPercentile(const std::vector<unsigned long long>& counts, unsigned long long numRecorded, unsigned long long max, double percentile)
+{
+	if (numRecorded == 0)
+		return 0;
+
+	unsigned long long rank = (unsigned long long)(percentile * (double)numRecorded + 0.5);
+	if (rank < 1)
+	{
+		rank = 1;
+	}
+
+	unsigned long long numSeen = 0;
+	for (int bucketIndex = 0; bucketIndex < (int)counts.size(); bucketIndex++)
+	{
+		numSeen += counts[bucketIndex];
+		if (numSeen >= rank)
+		{
+			unsigned long long highestValue = LatencyHistogram::GetBucketHighestValue(bucketIndex);
+			return highestValue < max ? highestValue : max;
+		}
+	}
+
+	return max;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+LatencyHistogram::LatencyHistogram()
+	: m_counts(std::make_unique<std::atomic<unsigned int>[]>(HISTOGRAM_NUM_BUCKETS))
+{
+	Clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Only the owning thread writes, so a relaxed load and store is all an increment needs
+//------------------------------------------------------------------------------------------------------------------------------
+void LatencyHistogram::Record(unsigned long long nanoseconds)
+{
+	std::atomic<unsigned int>& count = m_counts[GetBucketIndex(nanoseconds)];
+	count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+	m_numRecorded.store(m_numRecorded.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+	if (nanoseconds > m_max.load(std::memory_order_relaxed))
+	{
+		m_max.store(nanoseconds, std::memory_order_relaxed);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void LatencyHistogram::Clear()
+{
+	for (int bucketIndex = 0; bucketIndex < HISTOGRAM_NUM_BUCKETS; bucketIndex++)
+	{
+		m_counts[bucketIndex].store(0, std::memory_order_relaxed);
+	}
+
+	m_numRecorded.store(0, std::memory_order_relaxed);
+	m_max.store(0, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void LatencyHistogram::AddTo(std::vector<unsigned long long>& counts, unsigned long long& outMax) const
+{
+	for (int bucketIndex = 0; bucketIndex < HISTOGRAM_NUM_BUCKETS; bucketIndex++)
+	{
+		counts[bucketIndex] += m_counts[bucketIndex].load(std::memory_order_relaxed);
+	}
+
+	unsigned long long max = m_max.load(std::memory_order_relaxed);
+	if (max > outMax)
+	{
+		outMax = max;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+unsigned long long LatencyHistogram::GetNumRecorded() const
+{
+	return m_numRecorded.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Values under HISTOGRAM_SUB_BUCKETS get a bucket each. Above that each power of two gets HISTOGRAM_SUB_BUCKETS buckets,
+// picked by the bits right under the highest one
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC int LatencyHistogram::GetBucketIndex(unsigned long long value)
+{
+	if (value < HISTOGRAM_SUB_BUCKETS)
+		return (int)value;
+
+	int highestBit = GetHighestBitIndex(value);
+	if (highestBit > HISTOGRAM_HIGHEST_BIT)
+		return HISTOGRAM_NUM_BUCKETS - 1;
+
+	int shift = highestBit - HISTOGRAM_SUB_BUCKET_BITS;
+	int subBucket = (int)(value >> shift) - HISTOGRAM_SUB_BUCKETS;
+
+	return (shift + 1) * HISTOGRAM_SUB_BUCKETS + subBucket;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC unsigned long long LatencyHistogram::GetBucketHighestValue(int bucketIndex)
+{
+	if (bucketIndex < HISTOGRAM_SUB_BUCKETS)
+		return (unsigned long long)bucketIndex;
+
+	int shift = bucketIndex / HISTOGRAM_SUB_BUCKETS - 1;
+	unsigned long long subBucket = (unsigned long long)(bucketIndex % HISTOGRAM_SUB_BUCKETS);
+
+	return ((HISTOGRAM_SUB_BUCKETS + subBucket + 1) << shift) - 1;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void TurnProfiler::Init(int numThreads)
+{
+	m_numThreads = numThreads > 1 ? numThreads : 1;
+	m_histograms = std::make_unique<LatencyHistogram[]>((m_numThreads + 1) * NUM_TURN_PHASES);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void TurnProfiler::Record(eTurnPhase phase, int threadIdx, unsigned long long nanoseconds)
+{
+	GetHistogram(phase, threadIdx).Record(nanoseconds);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Merges every thread's histogram of a phase. Safe while other threads are still recording, the numbers are then just
+// a moment old
+//------------------------------------------------------------------------------------------------------------------------------
+void TurnProfiler::PrintSummary(const char* heading) const
+{
+	DebuggerPrintf("\n %s (ms)", heading);
+	DebuggerPrintf("\n %-18s %10s %9s %9s %9s", "Phase", "Count", "p50", "p99", "Max");
+
+	std::vector<unsigned long long> counts;
+	for (int phaseIndex = 0; phaseIndex < NUM_TURN_PHASES; phaseIndex++)
+	{
+		counts.assign(HISTOGRAM_NUM_BUCKETS, 0);
+		unsigned long long max = 0;
+		unsigned long long numRecorded = 0;
+
+		for (int threadIdx = 0; threadIdx <= m_numThreads; threadIdx++)
+		{
+			const LatencyHistogram& histogram = m_histograms[threadIdx * NUM_TURN_PHASES + phaseIndex];
+			histogram.AddTo(counts, max);
+			numRecorded += histogram.GetNumRecorded();
+		}
+
+		if (numRecorded == 0)
+			continue;
+
+		//The total can run ahead of the buckets while another thread records, count what the buckets hold
+		numRecorded = 0;
+		for (int bucketIndex = 0; bucketIndex < HISTOGRAM_NUM_BUCKETS; bucketIndex++)
+		{
+			numRecorded += counts[bucketIndex];
+		}
+
+		double p50 = (double)GetPercentile(counts, numRecorded, max, 0.50) * 1e-6;
+		double p99 = (double)GetPercentile(counts, numRecorded, max, 0.99) * 1e-6;
+
+		DebuggerPrintf("\n %-18s %10llu %9.3f %9.3f %9.3f", g_turnPhaseNames[phaseIndex], numRecorded, p50, p99, (double)max * 1e-6);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC unsigned long long TurnProfiler::GetCurrentTimeNanoseconds()
+{
+	using namespace std::chrono;
+	return (unsigned long long)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+LatencyHistogram& TurnProfiler::GetHistogram(eTurnPhase phase, int threadIdx)
+{
+	int row = threadIdx == PROFILER_SERVER_THREAD ? m_numThreads : threadIdx % m_numThreads;
+	return m_histograms[row * NUM_TURN_PHASES + phase];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+ScopedPhaseTimer::ScopedPhaseTimer(TurnProfiler& profiler, eTurnPhase phase, int threadIdx)
+	: m_profiler(profiler)
+	, m_phase(phase)
+	, m_threadIdx(threadIdx)
+	, m_startNanoseconds(TurnProfiler::GetCurrentTimeNanoseconds())
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+ScopedPhaseTimer::~ScopedPhaseTimer()
+{
+	m_profiler.Record(m_phase, m_threadIdx, TurnProfiler::GetCurrentTimeNanoseconds() - m_startNanoseconds);
+}
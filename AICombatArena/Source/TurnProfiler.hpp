@@ -0,0 +1,95 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <vector>
+
+constexpr int HISTOGRAM_SUB_BUCKET_BITS = 4;		//16 buckets per power of two, a recorded value is off by at most 1/16
+constexpr int HISTOGRAM_SUB_BUCKETS = 1 << HISTOGRAM_SUB_BUCKET_BITS;
+constexpr int HISTOGRAM_HIGHEST_BIT = 40;			//Nanoseconds, a little over 18 minutes
+constexpr int HISTOGRAM_NUM_BUCKETS = (HISTOGRAM_HIGHEST_BIT - HISTOGRAM_SUB_BUCKET_BITS + 2) * HISTOGRAM_SUB_BUCKETS;
+
+constexpr int PROFILER_SERVER_THREAD = -1;			//ReceiveTurnState and TurnOrderRequest run on the server's own thread
+
+//------------------------------------------------------------------------------------------------------------------------------
+enum eTurnPhase
+{
+	TURN_PHASE_TURN_COPY = 0,		//ReceiveTurnState
+	TURN_PHASE_COST_MAPS,			//World model merge, the cost maps and HPA clusters are rebuilt from it
+	TURN_PHASE_FOOD_INDEX,
+	TURN_PHASE_AGENT_SYNC,			//Agent reports, registry, store and path arena
+	TURN_PHASE_QUEEN_DECISIONS,		//Queens and the default orders
+	TURN_PHASE_FLOW_FIELDS,
+	TURN_PHASE_FOOD_ASSIGNMENT,
+	TURN_PHASE_AGENT_DECISIONS,		//Every other agent, on all threads, merge included
+	TURN_PHASE_WORKER_DECISION,		//Per agent, on whichever thread decided it
+	TURN_PHASE_SOLDIER_DECISION,
+	TURN_PHASE_SCOUT_DECISION,
+	TURN_PHASE_PATHING,				//Queued paths solved on all threads and turned into orders
+	TURN_PHASE_ORDER_PUBLISH,		//TurnOrderRequest handing the orders over
+	TURN_PHASE_TURN_LATENCY,		//From the turn being received to its orders being ready
+
+	NUM_TURN_PHASES
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Log-linear latency histogram in the style of HdrHistogram: every power of two is split into HISTOGRAM_SUB_BUCKETS
+// buckets, so percentiles keep the same relative precision from microseconds to seconds in a fixed size table
+// Only one thread may record into a histogram, any thread can read it at the same time. Counts are relaxed atomics
+// the recording thread loads and stores, so nothing is ever locked or retried
+//------------------------------------------------------------------------------------------------------------------------------
+class alignas(64) LatencyHistogram
+{
+public:
+	LatencyHistogram();
+
+	void				Record(unsigned long long nanoseconds);
+	void				Clear();
+	void				AddTo(std::vector<unsigned long long>& counts, unsigned long long& outMax) const;
+
+	unsigned long long	GetNumRecorded() const;
+
+	static int					GetBucketIndex(unsigned long long value);
+	static unsigned long long	GetBucketHighestValue(int bucketIndex);
+
+private:
+	std::unique_ptr<std::atomic<unsigned int>[]>	m_counts;
+	std::atomic<unsigned long long>					m_numRecorded;
+	std::atomic<unsigned long long>					m_max;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// A histogram per phase for every thread that records, merged only when printed
+//------------------------------------------------------------------------------------------------------------------------------
+class TurnProfiler
+{
+public:
+	void				Init(int numThreads);
+
+	void				Record(eTurnPhase phase, int threadIdx, unsigned long long nanoseconds);
+	void				PrintSummary(const char* heading) const;
+
+	static unsigned long long	GetCurrentTimeNanoseconds();
+
+private:
+	LatencyHistogram&	GetHistogram(eTurnPhase phase, int threadIdx);
+
+private:
+	int									m_numThreads = 0;
+	std::unique_ptr<LatencyHistogram[]>	m_histograms;		//NUM_TURN_PHASES per thread, the server thread's last
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Records the time from construction to the end of the scope
+//------------------------------------------------------------------------------------------------------------------------------
+class ScopedPhaseTimer
+{
+public:
+	ScopedPhaseTimer(TurnProfiler& profiler, eTurnPhase phase, int threadIdx);
+	~ScopedPhaseTimer();
+
+private:
+	TurnProfiler&		m_profiler;
+	eTurnPhase			m_phase;
+	int					m_threadIdx;
+	unsigned long long	m_startNanoseconds;
+};
@@ -0,0 +1,125 @@
+#include "TurnScheduler.hpp"
+#include "AICommons.hpp"
+#include <chrono>
+
+//------------------------------------------------------------------------------------------------------------------------------
+// The server only tells us how long a single call may take. The turn itself is paced by the match's minTurnTime, which
+// isn't passed to the DLL, so the shorter of the two is the window the orders have to be ready in
+//------------------------------------------------------------------------------------------------------------------------------
+void TurnScheduler::Init(double maxTurnSeconds)
+{
+	double turnWindowSeconds = TURN_WINDOW_SECONDS;
+	if (maxTurnSeconds > 0.0 && maxTurnSeconds < turnWindowSeconds)
+	{
+		turnWindowSeconds = maxTurnSeconds;
+	}
+
+	m_budgetSeconds = turnWindowSeconds * TURN_WORK_BUDGET_SHARE;
+	m_fallbackSeconds = turnWindowSeconds * TURN_FALLBACK_SHARE;
+
+	m_turnNumber = -1;
+	m_deferredAgents.clear();
+	m_lastTurnDeferredAgents.clear();
+
+	m_turnsScheduled = 0;
+	m_turnsOverBudget = 0;
+	m_agentsDeferred = 0;
+	m_tasksSkipped = 0;
+	m_maxBudgetUsed = 0.f;
+	m_lastBudgetUsed = 0.f;
+	m_totalBudgetUsed = 0.0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void TurnScheduler::BeginTurn(int turnNumber, double turnReceivedSeconds)
+{
+	m_turnNumber = turnNumber;
+	m_turnReceivedSeconds = turnReceivedSeconds;
+	m_deadlineSeconds = turnReceivedSeconds + m_budgetSeconds;
+
+	m_deferredAgents.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// The agents deferred this turn are the ones to go first next turn
+//------------------------------------------------------------------------------------------------------------------------------
+void TurnScheduler::EndTurn()
+{
+	m_lastTurnDeferredAgents.clear();
+	m_lastTurnDeferredAgents.insert(m_deferredAgents.begin(), m_deferredAgents.end());
+
+	m_lastBudgetUsed = (float)((GetCurrentTimeSeconds() - m_turnReceivedSeconds) / m_budgetSeconds);
+	m_totalBudgetUsed += m_lastBudgetUsed;
+	m_turnsScheduled++;
+
+	if (m_lastBudgetUsed > m_maxBudgetUsed)
+	{
+		m_maxBudgetUsed = m_lastBudgetUsed;
+	}
+
+	if (m_lastBudgetUsed > 1.f)
+	{
+		m_turnsOverBudget++;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Read by every thread deciding agents, nothing it reads changes until the next BeginTurn
+//------------------------------------------------------------------------------------------------------------------------------
+bool TurnScheduler::IsPastDeadline() const
+{
+	return GetCurrentTimeSeconds() >= m_deadlineSeconds;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+double TurnScheduler::GetFallbackSeconds() const
+{
+	return m_fallbackSeconds;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+double TurnScheduler::GetBudgetSeconds() const
+{
+	return m_budgetSeconds;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void TurnScheduler::DeferAgent(AgentID agentID)
+{
+	m_deferredAgents.push_back(agentID);
+	m_agentsDeferred++;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool TurnScheduler::WasDeferredLastTurn(AgentID agentID) const
+{
+	return m_lastTurnDeferredAgents.find(agentID) != m_lastTurnDeferredAgents.end();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void TurnScheduler::SkipTask()
+{
+	m_tasksSkipped++;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+float TurnScheduler::GetLastBudgetUsed() const
+{
+	return m_lastBudgetUsed;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+float TurnScheduler::GetAverageBudgetUsed() const
+{
+	if (m_turnsScheduled == 0)
+		return 0.f;
+
+	return (float)(m_totalBudgetUsed / (double)m_turnsScheduled);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC double TurnScheduler::GetCurrentTimeSeconds()
+{
+	using namespace std::chrono;
+	return duration_cast<duration<double>>(steady_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <vector>
+#include <unordered_set>
+#include "ArenaPlayerInterface.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Keeps a turn inside its time budget. The turn thread commits the cheap default orders first, then checks
+// IsPastDeadline before each piece of expensive work, in priority order. Agents it had no time for are deferred and
+// decided first next turn
+// The budget is measured from when the server handed us the turn, so time spent waiting for the turn thread counts too
+//------------------------------------------------------------------------------------------------------------------------------
+class TurnScheduler
+{
+public:
+	void			Init(double maxTurnSeconds);
+
+	void			BeginTurn(int turnNumber, double turnReceivedSeconds);
+	void			EndTurn();
+
+	bool			IsPastDeadline() const;			//No new expensive work should start
+	double			GetFallbackSeconds() const;		//After this long the default orders are handed over instead of none
+	double			GetBudgetSeconds() const;
+
+	void			DeferAgent(AgentID agentID);
+	bool			WasDeferredLastTurn(AgentID agentID) const;
+	void			SkipTask();						//A whole task had to wait for the next turn
+
+	float			GetLastBudgetUsed() const;		//Share of the budget the last finished turn took, over 1 if it ran late
+	float			GetAverageBudgetUsed() const;
+
+	static double	GetCurrentTimeSeconds();
+
+	int				m_turnsScheduled = 0;
+	int				m_turnsOverBudget = 0;
+	int				m_agentsDeferred = 0;
+	int				m_tasksSkipped = 0;
+	float			m_maxBudgetUsed = 0.f;
+
+private:
+	double			m_budgetSeconds = 0.0;
+	double			m_fallbackSeconds = 0.0;
+
+	int				m_turnNumber = -1;
+	double			m_turnReceivedSeconds = 0.0;
+	double			m_deadlineSeconds = 0.0;
+
+	std::vector<AgentID>			m_deferredAgents;			//This turn's, in the order they were deferred
+	std::unordered_set<AgentID>		m_lastTurnDeferredAgents;
+
+	float			m_lastBudgetUsed = 0.f;
+	double			m_totalBudgetUsed = 0.0;
+};
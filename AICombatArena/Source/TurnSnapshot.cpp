@@ -0,0 +1,49 @@
+#include "TurnSnapshot.hpp"
+#include <algorithm>
+#include <cstring>
+
+static_assert(sizeof(bool) == sizeof(unsigned char), "tilesThatHaveFood is copied as raw bytes");
+
+//------------------------------------------------------------------------------------------------------------------------------
+void TurnSnapshot::Init(int mapWidth)
+{
+	turnNumber = -1;
+	numReports = 0;
+	numObservedAgents = 0;
+
+	agentReports.resize(MAX_REPORTS_PER_PLAYER);
+	observedAgents.resize(MAX_AGENTS_TOTAL);
+
+	observedTiles.assign(mapWidth * mapWidth, TILE_TYPE_UNSEEN);
+	tilesThatHaveFood.assign(mapWidth * mapWidth, 0);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Called on the server thread inside ReceiveTurnState, so it only moves what the map size and counts need
+//------------------------------------------------------------------------------------------------------------------------------
+void TurnSnapshot::CopyFrom(const ArenaTurnStateForPlayer& state)
+{
+	turnNumber = state.turnNumber;
+	currentNutrients = state.currentNutrients;
+
+	numFaults = state.numFaults;
+	nutrientsLostDueToFault = state.nutrientsLostDueToFault;
+	nutrientsLostDueToQueenDamage = state.nutrientsLostDueToQueenDamage;
+	nutrientsLostDueToQueenSuffocation = state.nutrientsLostDueToQueenSuffocation;
+
+	numReports = std::min(state.numReports, (int)agentReports.size());
+	std::copy(state.agentReports, state.agentReports + numReports, agentReports.begin());
+
+	numObservedAgents = std::min(state.numObservedAgents, (int)observedAgents.size());
+	std::copy(state.observedAgents, state.observedAgents + numObservedAgents, observedAgents.begin());
+
+	int numTiles = GetNumTiles();
+	std::copy(state.observedTiles, state.observedTiles + numTiles, observedTiles.begin());
+	memcpy(tilesThatHaveFood.data(), state.tilesThatHaveFood, numTiles);	//std::copy converts bool by bool here
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int TurnSnapshot::GetNumTiles() const
+{
+	return (int)observedTiles.size();
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <vector>
+#include "ArenaPlayerInterface.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+// The parts of ArenaTurnStateForPlayer this turn actually uses. The server struct is sized for a 256x256 map and
+// every agent in the match, a snapshot only copies mapWidth*mapWidth tiles and the reports and observations sent
+// Storage is sized once in Init so copying a turn never allocates
+//------------------------------------------------------------------------------------------------------------------------------
+class TurnSnapshot
+{
+public:
+	void			Init(int mapWidth);
+	void			CopyFrom(const ArenaTurnStateForPlayer& state);
+
+	int				GetNumTiles() const;
+
+public:
+	int							turnNumber = -1;
+	int							currentNutrients = 0;
+	double						receivedSeconds = 0.0;	//When the server handed the turn over, the turn's budget starts here
+
+	int							numFaults = 0;
+	int							nutrientsLostDueToFault = 0;
+	int							nutrientsLostDueToQueenDamage = 0;
+	int							nutrientsLostDueToQueenSuffocation = 0;
+
+	std::vector<AgentReport>	agentReports;		//Only the first numReports are valid
+	int							numReports = 0;
+
+	std::vector<ObservedAgent>	observedAgents;		//Only the first numObservedAgents are valid
+	int							numObservedAgents = 0;
+
+	std::vector<eTileType>		observedTiles;		//mapWidth*mapWidth entries
+	std::vector<unsigned char>	tilesThatHaveFood;	//Bytes rather than vector<bool> so the copy stays a memcpy
+};
@@ -0,0 +1,183 @@
+#include "WorldModel.hpp"
+#include <string.h>
+#include <algorithm>
+
+//------------------------------------------------------------------------------------------------------------------------------
+void WorldModel::Init(int mapWidth)
+{
+	int numTiles = mapWidth * mapWidth;
+
+	m_mapWidth = mapWidth;
+	m_currentTurn = -1;
+	m_tileTypes.assign(numTiles, TILE_TYPE_UNSEEN);
+	m_hasFood.assign(numTiles, 0);
+	m_lastSeenTurn.assign(numTiles, WORLD_TILE_NEVER_SEEN);
+
+	m_observedTiles.assign(numTiles, TILE_TYPE_UNSEEN);
+	m_observedFood.assign(numTiles, 0);
+
+	m_changedTiles.clear();
+	m_changedTiles.reserve(numTiles);
+	m_dirtyRowMask.assign((mapWidth + 63) / 64, 0);
+
+	m_subscribers.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Rows that look exactly like last turn are skipped with a memcmp, which the CRT vectorizes, so a quiet turn only
+// touches the tiles that moved in or out of vision or changed under it
+//------------------------------------------------------------------------------------------------------------------------------
+int WorldModel::MergeVisibleTiles(const TurnSnapshot& snapshot)
+{
+	std::fill(m_dirtyRowMask.begin(), m_dirtyRowMask.end(), 0);
+	m_changedTiles.clear();
+
+	for (int tileY = 0; tileY < m_mapWidth; tileY++)
+	{
+		int rowStart = tileY * m_mapWidth;
+
+		bool isSameVision = memcmp(&snapshot.observedTiles[rowStart], &m_observedTiles[rowStart], m_mapWidth * sizeof(eTileType)) == 0;
+		bool isSameFood = memcmp(&snapshot.tilesThatHaveFood[rowStart], &m_observedFood[rowStart], m_mapWidth) == 0;
+
+		if (!isSameVision || !isSameFood)
+		{
+			MergeRow(snapshot, tileY);
+		}
+	}
+
+	m_currentTurn = snapshot.turnNumber;
+
+	if (m_changedTiles.size() > 0)
+	{
+		for (int subscriberIndex = 0; subscriberIndex < (int)m_subscribers.size(); subscriberIndex++)
+		{
+			m_subscribers[subscriberIndex].second(*this);
+		}
+	}
+
+	return (int)m_changedTiles.size();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void WorldModel::MergeRow(const TurnSnapshot& snapshot, int tileY)
+{
+	int rowStart = tileY * m_mapWidth;
+	bool isRowDirty = false;
+
+	for (int tileIndex = rowStart; tileIndex < rowStart + m_mapWidth; tileIndex++)
+	{
+		eTileType tileType = snapshot.observedTiles[tileIndex];
+		unsigned char hasFood = snapshot.tilesThatHaveFood[tileIndex];
+
+		if (tileType == m_observedTiles[tileIndex] && hasFood == m_observedFood[tileIndex])
+			continue;
+
+		if (tileType == TILE_TYPE_UNSEEN)
+		{
+			//Left vision, the tile was last seen in the turn merged before this one
+			m_lastSeenTurn[tileIndex] = m_currentTurn;
+		}
+		else if (tileType != m_tileTypes[tileIndex] || hasFood != m_hasFood[tileIndex])
+		{
+			m_tileTypes[tileIndex] = tileType;
+			m_hasFood[tileIndex] = hasFood;
+
+			m_changedTiles.push_back(tileIndex);
+			isRowDirty = true;
+		}
+
+		m_observedTiles[tileIndex] = tileType;
+		m_observedFood[tileIndex] = hasFood;
+	}
+
+	if (isRowDirty)
+	{
+		m_dirtyRowMask[tileY / 64] |= 1ULL << (tileY % 64);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int WorldModel::Subscribe(const WorldChangeCallback& callback)
+{
+	int subscriptionID = m_nextSubscriptionID++;
+	m_subscribers.push_back(std::make_pair(subscriptionID, callback));
+	return subscriptionID;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void WorldModel::Unsubscribe(int subscriptionID)
+{
+	for (int subscriberIndex = 0; subscriberIndex < (int)m_subscribers.size(); subscriberIndex++)
+	{
+		if (m_subscribers[subscriberIndex].first == subscriptionID)
+		{
+			m_subscribers.erase(m_subscribers.begin() + subscriberIndex);
+			return;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+eTileType WorldModel::GetTileType(int tileIndex) const
+{
+	return m_tileTypes[tileIndex];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool WorldModel::HasFood(int tileIndex) const
+{
+	return m_hasFood[tileIndex] != 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int WorldModel::GetLastSeenTurn(int tileIndex) const
+{
+	if (IsTileVisible(tileIndex))
+	{
+		return m_currentTurn;
+	}
+
+	return m_lastSeenTurn[tileIndex];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool WorldModel::IsTileVisible(int tileIndex) const
+{
+	return m_observedTiles[tileIndex] != TILE_TYPE_UNSEEN;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int WorldModel::GetNumTiles() const
+{
+	return (int)m_tileTypes.size();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int WorldModel::GetMapWidth() const
+{
+	return m_mapWidth;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int WorldModel::GetCurrentTurn() const
+{
+	return m_currentTurn;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const std::vector<eTileType>& WorldModel::GetTileTypes() const
+{
+	return m_tileTypes;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const std::vector<int>& WorldModel::GetChangedTiles() const
+{
+	return m_changedTiles;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool WorldModel::IsRowDirty(int tileY) const
+{
+	return (m_dirtyRowMask[tileY / 64] & (1ULL << (tileY % 64))) != 0;
+}
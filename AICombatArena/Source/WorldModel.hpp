@@ -0,0 +1,61 @@
+#pragma once
+#include <vector>
+#include <functional>
+#include "ArenaPlayerInterface.hpp"
+#include "TurnSnapshot.hpp"
+
+constexpr int WORLD_TILE_NEVER_SEEN = -1;
+
+class WorldModel;
+typedef std::function<void(const WorldModel& worldModel)> WorldChangeCallback;
+
+//------------------------------------------------------------------------------------------------------------------------------
+// What we know about every tile across turns. Only the tiles visible this turn are merged in, everything else keeps
+// the type and food it had when we last saw it, so explored terrain isn't forgotten the moment it leaves vision
+// Each merge diffs the turn against the last one and tells subscribers which remembered tiles changed
+//------------------------------------------------------------------------------------------------------------------------------
+class WorldModel
+{
+public:
+	void			Init(int mapWidth);
+	int				MergeVisibleTiles(const TurnSnapshot& snapshot);	//Returns how many tiles changed type or food
+
+	int				Subscribe(const WorldChangeCallback& callback);	//Called after every merge that changed a tile
+	void			Unsubscribe(int subscriptionID);
+
+	eTileType		GetTileType(int tileIndex) const;		//TILE_TYPE_UNSEEN only if the tile was never seen
+	bool			HasFood(int tileIndex) const;			//As of the last time the tile was seen
+	int				GetLastSeenTurn(int tileIndex) const;
+	bool			IsTileVisible(int tileIndex) const;		//Seen in the turn merged last
+
+	int				GetNumTiles() const;
+	int				GetMapWidth() const;
+	int				GetCurrentTurn() const;
+	const std::vector<eTileType>&	GetTileTypes() const;
+
+	// What the last merge changed
+	const std::vector<int>&	GetChangedTiles() const;		//Tiles whose type or food changed, first sightings included
+	bool			IsRowDirty(int tileY) const;			//True if any tile in the row is in GetChangedTiles
+
+private:
+	void			MergeRow(const TurnSnapshot& snapshot, int tileY);
+
+private:
+	int								m_mapWidth = 0;
+	int								m_currentTurn = -1;
+
+	// Remembered state
+	std::vector<eTileType>			m_tileTypes;
+	std::vector<unsigned char>		m_hasFood;
+	std::vector<int>				m_lastSeenTurn;		//Only kept up to date for tiles out of vision
+
+	// The last turn's vision, the next turn is diffed against these
+	std::vector<eTileType>			m_observedTiles;
+	std::vector<unsigned char>		m_observedFood;
+
+	std::vector<int>				m_changedTiles;
+	std::vector<unsigned long long>	m_dirtyRowMask;		//One bit per row
+
+	std::vector<std::pair<int, WorldChangeCallback>>	m_subscribers;
+	int								m_nextSubscriptionID = 0;
+};
@@ -28,7 +28,9 @@ constexpr int	COMMON_INTERFACE_VERSION_NUMBER		= 12;
 //-----------------------------------------------------------------------------------------------
 // Macros
 //-----------------------------------------------------------------------------------------------
-#if defined( ARENA_SERVER )
+#if !defined( _WIN32 )
+	#define DLL __attribute__( ( visibility( "default" ) ) )	// Linux shared object, e.g. for the headless arena simulator
+#elif defined( ARENA_SERVER )
 	#define DLL __declspec( dllimport )
 #else // ARENA_PLAYER
 	#define DLL __declspec( dllexport )
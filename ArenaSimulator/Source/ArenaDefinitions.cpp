@@ -0,0 +1,311 @@
+#include "ArenaDefinitions.hpp"
+#include "XmlReader.hpp"
+#include "SimulatorCommons.hpp"
+#include "RandomNumberGenerator.hpp"
+#include <cstdlib>
+
+//------------------------------------------------------------------------------------------------------------------------------
+static const char* const g_agentTypeNames[NUM_AGENT_TYPES] = { "Scout", "Worker", "Soldier", "Queen" };
+
+//------------------------------------------------------------------------------------------------------------------------------
+float FloatRange_T::GetRandomInRange(RandomNumberGenerator& rng) const
+{
+	if (max <= min)
+		return min;
+
+	return rng.GetRandomFloatInRange(min, max);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Whole counts from a fractional range round up or down with the chance of their fraction, so "0.5" strands per 100
+// tiles really averages out to one strand every 200 tiles
+//------------------------------------------------------------------------------------------------------------------------------
+int FloatRange_T::GetRandomIntInRange(RandomNumberGenerator& rng) const
+{
+	float value = GetRandomInRange(rng);
+	int wholeValue = (int)value;
+	if (rng.GetRandomFloatZeroToOne() < value - (float)wholeValue)
+	{
+		wholeValue++;
+	}
+
+	return wholeValue;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC FloatRange_T FloatRange_T::FromText(const std::string& text, float defaultValue)
+{
+	FloatRange_T range;
+	range.min = defaultValue;
+	range.max = defaultValue;
+
+	if (text.empty())
+		return range;
+
+	size_t separator = text.find('~');
+	range.min = (float)atof(text.substr(0, separator).c_str());
+	range.max = separator == std::string::npos ? range.min : (float)atof(text.substr(separator + 1).c_str());
+
+	if (range.max < range.min)
+	{
+		float swap = range.min;
+		range.min = range.max;
+		range.max = swap;
+	}
+
+	return range;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// The Data files only list what differs from the defaults. Moving into dirt or stone is impossible and moving anywhere
+// else is free, nothing can be dug unless it is listed
+//------------------------------------------------------------------------------------------------------------------------------
+static bool LoadExhaustPenalties(const XmlElement_T* penaltiesElement, int (&outPenalties)[NUM_TILE_TYPES], std::string& outError)
+{
+	if (penaltiesElement == nullptr)
+		return true;
+
+	for (int childIndex = 0; childIndex < (int)penaltiesElement->children.size(); childIndex++)
+	{
+		const XmlElement_T& penaltyElement = penaltiesElement->children[childIndex];
+		std::string tileName = GetXmlAttribute(penaltyElement, "tile", std::string());
+
+		eTileType tileType = GetTileTypeForName(tileName);
+		if (tileType == NUM_TILE_TYPES)
+		{
+			outError = "unknown tile type \"" + tileName + "\" in " + penaltiesElement->name;
+			return false;
+		}
+
+		outPenalties[tileType] = GetXmlAttribute(penaltyElement, "exhaustion", 0);
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool LoadAgentDefinitions(const std::string& filePath, AgentTypeInfo (&outAgentTypeInfos)[NUM_AGENT_TYPES], std::string& outError)
+{
+	XmlElement_T root;
+	if (!LoadXmlFile(filePath, root, outError))
+		return false;
+
+	bool agentTypesLoaded[NUM_AGENT_TYPES] = {};
+	for (int childIndex = 0; childIndex < (int)root.children.size(); childIndex++)
+	{
+		const XmlElement_T& definition = root.children[childIndex];
+		std::string typeName = GetXmlAttribute(definition, "type", std::string());
+
+		int agentType = 0;
+		while (agentType < NUM_AGENT_TYPES && typeName != g_agentTypeNames[agentType])
+		{
+			agentType++;
+		}
+
+		if (agentType == NUM_AGENT_TYPES)
+		{
+			outError = filePath + ": unknown agent type \"" + typeName + "\"";
+			return false;
+		}
+
+		AgentTypeInfo& info = outAgentTypeInfos[agentType];
+		info.name = g_agentTypeNames[agentType];
+		info.costToBirth = GetXmlAttribute(definition, "costToBirth", 0);
+		info.exhaustAfterBirth = GetXmlAttribute(definition, "exhaustAfterBirth", 0);
+		info.upkeepPerTurn = GetXmlAttribute(definition, "upkeepPerTurn", 0);
+		info.visibilityRange = GetXmlAttribute(definition, "visibilityRange", 0);
+		info.combatStrength = GetXmlAttribute(definition, "combatStrength", 0);
+		info.combatPriority = GetXmlAttribute(definition, "combatPriority", 0);
+		info.sacrificePriority = GetXmlAttribute(definition, "sacrificePriority", 0);
+		info.canCarryFood = GetXmlAttribute(definition, "canCarryFood", false);
+		info.canCarryTiles = GetXmlAttribute(definition, "canCarryTiles", false);
+		info.canBirth = GetXmlAttribute(definition, "canBirth", false);
+
+		for (int tileType = 0; tileType < NUM_TILE_TYPES; tileType++)
+		{
+			bool isSolid = tileType == TILE_TYPE_DIRT || tileType == TILE_TYPE_STONE;
+			info.moveExhaustPenalties[tileType] = isSolid ? TILE_IMPASSABLE : 0;
+			info.digExhaustPenalties[tileType] = DIG_IMPOSSIBLE;
+		}
+
+		if (!LoadExhaustPenalties(definition.FindChild("MoveExhaustPenalties"), info.moveExhaustPenalties, outError)
+			|| !LoadExhaustPenalties(definition.FindChild("DigExhaustPenalties"), info.digExhaustPenalties, outError))
+		{
+			outError = filePath + ": " + outError;
+			return false;
+		}
+
+		//Stone is never anything but stone
+		info.moveExhaustPenalties[TILE_TYPE_STONE] = TILE_IMPASSABLE;
+		info.digExhaustPenalties[TILE_TYPE_STONE] = DIG_IMPOSSIBLE;
+
+		agentTypesLoaded[agentType] = true;
+	}
+
+	for (int agentType = 0; agentType < NUM_AGENT_TYPES; agentType++)
+	{
+		if (!agentTypesLoaded[agentType])
+		{
+			outError = filePath + ": no definition for " + g_agentTypeNames[agentType];
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static bool GetTileTypeAttribute(const XmlElement_T& element, const char* attributeName, eTileType defaultType, eTileType& outType, std::string& outError)
+{
+	const char* tileName = element.FindAttribute(attributeName);
+	if (tileName == nullptr)
+	{
+		outType = defaultType;
+		return true;
+	}
+
+	outType = GetTileTypeForName(tileName);
+	if (outType == NUM_TILE_TYPES)
+	{
+		outError = std::string("unknown tile type \"") + tileName + "\" for " + attributeName;
+		return false;
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool LoadMapDefinition(const std::string& filePath, const std::string& mapName, MapDefinition_T& outDefinition, std::string& outError)
+{
+	XmlElement_T root;
+	if (!LoadXmlFile(filePath, root, outError))
+		return false;
+
+	for (int childIndex = 0; childIndex < (int)root.children.size(); childIndex++)
+	{
+		const XmlElement_T& definition = root.children[childIndex];
+		if (GetXmlAttribute(definition, "name", std::string()) != mapName)
+			continue;
+
+		outDefinition = MapDefinition_T();
+		outDefinition.name = mapName;
+		outDefinition.defaultSize = GetXmlAttribute(definition, "defaultSize", outDefinition.defaultSize);
+		outDefinition.foodStrandsPer100Tiles = FloatRange_T::FromText(GetXmlAttribute(definition, "foodStrandsPer100Tiles", std::string()), 0.f);
+		outDefinition.foodStrandLength = FloatRange_T::FromText(GetXmlAttribute(definition, "foodStrandLength", std::string()), 1.f);
+		outDefinition.foodSpawnedPerTurnPer100Tiles = GetXmlAttribute(definition, "foodSpawnedPerTurnPer100Tiles", 0.f);
+
+		if (!GetTileTypeAttribute(definition, "fillTile", TILE_TYPE_AIR, outDefinition.fillTile, outError)
+			|| !GetTileTypeAttribute(definition, "edgeTile", TILE_TYPE_STONE, outDefinition.edgeTile, outError)
+			|| !GetTileTypeAttribute(definition, "tunnelTile", outDefinition.fillTile, outDefinition.tunnelTile, outError))
+		{
+			outError = filePath + ": " + outError;
+			return false;
+		}
+
+		for (int tileInfoIndex = 0; tileInfoIndex < (int)definition.children.size(); tileInfoIndex++)
+		{
+			const XmlElement_T& tileInfo = definition.children[tileInfoIndex];
+			if (tileInfo.name != "TileInfo")
+				continue;
+
+			TileStrandInfo_T strand;
+			if (!GetTileTypeAttribute(tileInfo, "type", NUM_TILE_TYPES, strand.type, outError) || strand.type == NUM_TILE_TYPES)
+			{
+				outError = filePath + ": TileInfo in " + mapName + " needs a known type";
+				return false;
+			}
+
+			strand.strandsPer100Tiles = FloatRange_T::FromText(GetXmlAttribute(tileInfo, "strandsPer100Tiles", std::string()), 0.f);
+			strand.strandLength = FloatRange_T::FromText(GetXmlAttribute(tileInfo, "strandLength", std::string()), 0.f);
+			outDefinition.tileStrands.push_back(strand);
+		}
+
+		return true;
+	}
+
+	outError = filePath + ": no map named \"" + mapName + "\"";
+	return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void ReadMatchDefinition(const XmlElement_T& definition, MatchDefinition_T& inOutDefinition)
+{
+	static const char* const startingAttributes[NUM_AGENT_TYPES] = { "startingScouts", "startingWorkers", "startingSoldiers", "startingQueens" };
+
+	inOutDefinition.name = GetXmlAttribute(definition, "name", inOutDefinition.name);
+	inOutDefinition.minTurnTime = GetXmlAttribute(definition, "minTurnTime", inOutDefinition.minTurnTime);
+	inOutDefinition.mapSizeOverride = GetXmlAttribute(definition, "mapSizeOverride", inOutDefinition.mapSizeOverride);
+	inOutDefinition.maxPopulation = GetXmlAttribute(definition, "maxPopulation", inOutDefinition.maxPopulation);
+
+	inOutDefinition.startingNutrientsPerPlayer = GetXmlAttribute(definition, "startingNutrientsPerPlayer", inOutDefinition.startingNutrientsPerPlayer);
+	inOutDefinition.nutrientLossPerAttackerStrength = GetXmlAttribute(definition, "nutrientLossPerAttackerStrength", inOutDefinition.nutrientLossPerAttackerStrength);
+	inOutDefinition.nutrientLossPerQueenSuffocation = GetXmlAttribute(definition, "nutrientLossPerQueenSuffocation", inOutDefinition.nutrientLossPerQueenSuffocation);
+
+	//The shipped data spells it "nurtients", either spelling is taken
+	inOutDefinition.nutrientsEarnedPerFoodEatenByQueen = GetXmlAttribute(definition, "nurtientsEarnedPerFoodEatenByQueen", inOutDefinition.nutrientsEarnedPerFoodEatenByQueen);
+	inOutDefinition.nutrientsEarnedPerFoodEatenByQueen = GetXmlAttribute(definition, "nutrientsEarnedPerFoodEatenByQueen", inOutDefinition.nutrientsEarnedPerFoodEatenByQueen);
+
+	for (int agentType = 0; agentType < NUM_AGENT_TYPES; agentType++)
+	{
+		inOutDefinition.startingAgents[agentType] = GetXmlAttribute(definition, startingAttributes[agentType], inOutDefinition.startingAgents[agentType]);
+	}
+
+	inOutDefinition.turnsUntilSuddenDeath = GetXmlAttribute(definition, "turnsUntilSuddenDeath", inOutDefinition.turnsUntilSuddenDeath);
+	inOutDefinition.suddenDeathTurnsPerUpkeepIncrease = GetXmlAttribute(definition, "suddenDeathTurnsPerUpkeepIncrease", inOutDefinition.suddenDeathTurnsPerUpkeepIncrease);
+	inOutDefinition.nutrientPenaltyPerFault = GetXmlAttribute(definition, "nutrientPenaltyPerFault", inOutDefinition.nutrientPenaltyPerFault);
+	inOutDefinition.agentsKilledPerFault = GetXmlAttribute(definition, "agentsKilledPerFault", inOutDefinition.agentsKilledPerFault);
+
+	inOutDefinition.foodCarryExhaustPenalty = GetXmlAttribute(definition, "foodCarryExhaustPenalty", inOutDefinition.foodCarryExhaustPenalty);
+	inOutDefinition.tileCarryExhaustPenalty = GetXmlAttribute(definition, "tileCarryExhaustPenalty", inOutDefinition.tileCarryExhaustPenalty);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool LoadMatchDefinition(const std::string& filePath, const std::string& matchName, MatchDefinition_T& outDefinition, std::string& outError)
+{
+	XmlElement_T root;
+	if (!LoadXmlFile(filePath, root, outError))
+		return false;
+
+	if (root.children.empty())
+	{
+		outError = filePath + ": no match definitions";
+		return false;
+	}
+
+	outDefinition = MatchDefinition_T();
+	ReadMatchDefinition(root.children[0], outDefinition);
+
+	for (int childIndex = 0; childIndex < (int)root.children.size(); childIndex++)
+	{
+		const XmlElement_T& definition = root.children[childIndex];
+		if (GetXmlAttribute(definition, "name", std::string()) != matchName)
+			continue;
+
+		ReadMatchDefinition(definition, outDefinition);
+		return true;
+	}
+
+	outError = filePath + ": no match named \"" + matchName + "\"";
+	return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+eTileType GetTileTypeForName(const std::string& tileName)
+{
+	if (tileName == "air")		return TILE_TYPE_AIR;
+	if (tileName == "dirt")		return TILE_TYPE_DIRT;
+	if (tileName == "stone")	return TILE_TYPE_STONE;
+	if (tileName == "water")	return TILE_TYPE_WATER;
+	if (tileName == "bridge")	return TILE_TYPE_CORPSE_BRIDGE;
+
+	return NUM_TILE_TYPES;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const char* GetNameForAgentType(eAgentType agentType)
+{
+	if (agentType >= NUM_AGENT_TYPES)
+		return "Invalid";
+
+	return g_agentTypeNames[agentType];
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <string>
+#include <vector>
+#define ARENA_SERVER
+#include "../../Arena/Code/Game/ArenaPlayerInterface.hpp"
+
+class RandomNumberGenerator;
+
+//------------------------------------------------------------------------------------------------------------------------------
+// A "min~max" value from the Data files, a single number is a range of one
+//------------------------------------------------------------------------------------------------------------------------------
+struct FloatRange_T
+{
+	float	min = 0.f;
+	float	max = 0.f;
+
+	float	GetRandomInRange(RandomNumberGenerator& rng) const;
+	int		GetRandomIntInRange(RandomNumberGenerator& rng) const;
+
+	static FloatRange_T		FromText(const std::string& text, float defaultValue);
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct TileStrandInfo_T
+{
+	eTileType		type = TILE_TYPE_AIR;
+	FloatRange_T	strandsPer100Tiles;
+	FloatRange_T	strandLength;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct MapDefinition_T
+{
+	std::string		name;
+	int				defaultSize = 64;
+	eTileType		fillTile = TILE_TYPE_AIR;
+	eTileType		edgeTile = TILE_TYPE_STONE;
+	eTileType		tunnelTile = TILE_TYPE_AIR;
+	FloatRange_T	foodStrandsPer100Tiles;
+	FloatRange_T	foodStrandLength;
+	float			foodSpawnedPerTurnPer100Tiles = 0.f;
+
+	std::vector<TileStrandInfo_T>	tileStrands;		//In the order they are listed, later strands draw over earlier ones
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// MatchDefinitions.xml lists the "Debug" match first and every later match only overrides what it sets
+//------------------------------------------------------------------------------------------------------------------------------
+struct MatchDefinition_T
+{
+	std::string		name;
+	double			minTurnTime = 0.060;
+	int				mapSizeOverride = 0;
+	int				maxPopulation = 100;
+
+	int				startingNutrientsPerPlayer = 2000;
+	int				nutrientsEarnedPerFoodEatenByQueen = 1000;
+	int				nutrientLossPerAttackerStrength = 10;
+	int				nutrientLossPerQueenSuffocation = 10000;
+
+	int				startingAgents[NUM_AGENT_TYPES] = { 2, 2, 1, 1 };
+
+	int				turnsUntilSuddenDeath = 1000;
+	int				suddenDeathTurnsPerUpkeepIncrease = 2;
+	int				nutrientPenaltyPerFault = 0;
+	int				agentsKilledPerFault = 0;
+
+	int				foodCarryExhaustPenalty = 1;
+	int				tileCarryExhaustPenalty = 1;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool			LoadAgentDefinitions(const std::string& filePath, AgentTypeInfo (&outAgentTypeInfos)[NUM_AGENT_TYPES], std::string& outError);
+bool			LoadMapDefinition(const std::string& filePath, const std::string& mapName, MapDefinition_T& outDefinition, std::string& outError);
+bool			LoadMatchDefinition(const std::string& filePath, const std::string& matchName, MatchDefinition_T& outDefinition, std::string& outError);
+
+eTileType		GetTileTypeForName(const std::string& tileName);		//NUM_TILE_TYPES when it isn't one
+const char*		GetNameForAgentType(eAgentType agentType);
@@ -0,0 +1,227 @@
+#include "ArenaMap.hpp"
+#include "SimulatorCommons.hpp"
+#include "RandomNumberGenerator.hpp"
+#include <math.h>
+#include <stdlib.h>
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMap::Generate(const MapDefinition_T& definition, int mapWidth, int numColonies, RandomNumberGenerator& rng)
+{
+	m_width = mapWidth;
+	m_tiles.assign(GetNumTiles(), definition.fillTile);
+	m_food.assign(GetNumTiles(), 0);
+	m_colonyStarts.clear();
+
+	m_tunnelTile = definition.tunnelTile;
+	m_foodSpawnedPerTurnPer100Tiles = definition.foodSpawnedPerTurnPer100Tiles;
+	m_foodSpawnDebt = 0.f;
+
+	for (int strandInfoIndex = 0; strandInfoIndex < (int)definition.tileStrands.size(); strandInfoIndex++)
+	{
+		const TileStrandInfo_T& strandInfo = definition.tileStrands[strandInfoIndex];
+
+		int numStrands = GetNumStrands(strandInfo.strandsPer100Tiles, rng);
+		for (int strandIndex = 0; strandIndex < numStrands; strandIndex++)
+		{
+			AddStrand(strandInfo.type, strandInfo.strandLength.GetRandomIntInRange(rng), rng);
+		}
+	}
+
+	for (int tileY = 0; tileY < m_width; tileY++)
+	{
+		for (int tileX = 0; tileX < m_width; tileX++)
+		{
+			if (!IsInterior(tileX, tileY))
+			{
+				m_tiles[GetTileIndex(tileX, tileY)] = definition.edgeTile;
+			}
+		}
+	}
+
+	AddColonyStarts(numColonies, rng);
+
+	int numFoodStrands = GetNumStrands(definition.foodStrandsPer100Tiles, rng);
+	for (int strandIndex = 0; strandIndex < numFoodStrands; strandIndex++)
+	{
+		AddFoodStrand(definition.foodStrandLength.GetRandomIntInRange(rng), rng);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMap::SpawnFood(RandomNumberGenerator& rng)
+{
+	m_foodSpawnDebt += m_foodSpawnedPerTurnPer100Tiles * (float)GetNumTiles() * 0.01f;
+
+	//A few tries per food so a nearly full map doesn't spin, food that found no tile is dropped
+	while (m_foodSpawnDebt >= 1.f)
+	{
+		m_foodSpawnDebt -= 1.f;
+
+		for (int tryIndex = 0; tryIndex < 8; tryIndex++)
+		{
+			IntVec2 tile = GetRandomInteriorTile(rng);
+			int tileIndex = GetTileIndex(tile.x, tile.y);
+			if (CanHoldFood(tileIndex) && !HasFood(tileIndex))
+			{
+				SetFood(tileIndex, true);
+				break;
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool ArenaMap::IsInBounds(int tileX, int tileY) const
+{
+	return tileX >= 0 && tileY >= 0 && tileX < m_width && tileY < m_width;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int ArenaMap::GetNumFood() const
+{
+	int numFood = 0;
+	for (int tileIndex = 0; tileIndex < GetNumTiles(); tileIndex++)
+	{
+		numFood += m_food[tileIndex];
+	}
+
+	return numFood;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// A random walk from a random interior tile, painting every tile it steps on
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMap::AddStrand(eTileType tileType, int length, RandomNumberGenerator& rng)
+{
+	IntVec2 tile = GetRandomInteriorTile(rng);
+	for (int stepIndex = 0; stepIndex < length; stepIndex++)
+	{
+		m_tiles[GetTileIndex(tile.x, tile.y)] = tileType;
+
+		IntVec2 nextTile = tile + GetRandomStep(rng);
+		if (IsInterior(nextTile.x, nextTile.y))
+		{
+			tile = nextTile;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMap::AddFoodStrand(int length, RandomNumberGenerator& rng)
+{
+	IntVec2 tile = GetRandomInteriorTile(rng);
+	for (int stepIndex = 0; stepIndex < length; stepIndex++)
+	{
+		int tileIndex = GetTileIndex(tile.x, tile.y);
+		if (CanHoldFood(tileIndex))
+		{
+			m_food[tileIndex] = 1;
+		}
+
+		IntVec2 nextTile = tile + GetRandomStep(rng);
+		if (IsInterior(nextTile.x, nextTile.y))
+		{
+			tile = nextTile;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Colonies start evenly spread on a circle around the centre, turned by a random angle, each with an air pocket around it
+// and a tunnel to the centre so no colony is sealed in
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMap::AddColonyStarts(int numColonies, RandomNumberGenerator& rng)
+{
+	float centre = (float)(m_width - 1) * 0.5f;
+	float radius = (float)m_width * COLONY_START_RADIUS_FRACTION;
+	float startAngle = rng.GetRandomFloatInRange(0.f, 6.2831853f);
+	IntVec2 centreTile((int)centre, (int)centre);
+
+	for (int colonyIndex = 0; colonyIndex < numColonies; colonyIndex++)
+	{
+		float angle = startAngle + 6.2831853f * (float)colonyIndex / (float)numColonies;
+		IntVec2 start((int)roundf(centre + cosf(angle) * radius), (int)roundf(centre + sinf(angle) * radius));
+
+		m_colonyStarts.push_back(start);
+		AddTunnel(start, centreTile, rng);
+
+		for (int offsetY = -COLONY_START_CLEAR_RADIUS; offsetY <= COLONY_START_CLEAR_RADIUS; offsetY++)
+		{
+			for (int offsetX = -COLONY_START_CLEAR_RADIUS; offsetX <= COLONY_START_CLEAR_RADIUS; offsetX++)
+			{
+				if (IsInterior(start.x + offsetX, start.y + offsetY))
+				{
+					m_tiles[GetTileIndex(start.x + offsetX, start.y + offsetY)] = TILE_TYPE_AIR;
+				}
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Every step closes in on the end along one axis or the other, picked at random so the tunnel wanders a little
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMap::AddTunnel(const IntVec2& start, const IntVec2& end, RandomNumberGenerator& rng)
+{
+	IntVec2 tile = start;
+	while (tile != end)
+	{
+		if (IsInterior(tile.x, tile.y))
+		{
+			m_tiles[GetTileIndex(tile.x, tile.y)] = m_tunnelTile;
+		}
+
+		int distanceX = end.x - tile.x;
+		int distanceY = end.y - tile.y;
+		bool stepAlongX = distanceY == 0 || (distanceX != 0 && rng.GetRandomIntLessThan(abs(distanceX) + abs(distanceY)) < abs(distanceX));
+
+		if (stepAlongX)
+		{
+			tile.x += distanceX > 0 ? 1 : -1;
+		}
+		else
+		{
+			tile.y += distanceY > 0 ? 1 : -1;
+		}
+	}
+
+	m_tiles[GetTileIndex(end.x, end.y)] = m_tunnelTile;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+IntVec2 ArenaMap::GetRandomInteriorTile(RandomNumberGenerator& rng) const
+{
+	return IntVec2(rng.GetRandomIntInRange(1, m_width - 2), rng.GetRandomIntInRange(1, m_width - 2));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+IntVec2 ArenaMap::GetRandomStep(RandomNumberGenerator& rng) const
+{
+	static const IntVec2 steps[4] = { IntVec2(1, 0), IntVec2(0, 1), IntVec2(-1, 0), IntVec2(0, -1) };
+	return steps[rng.GetRandomIntLessThan(4)];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool ArenaMap::IsInterior(int tileX, int tileY) const
+{
+	return tileX > 0 && tileY > 0 && tileX < m_width - 1 && tileY < m_width - 1;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool ArenaMap::CanHoldFood(int tileIndex) const
+{
+	eTileType tileType = m_tiles[tileIndex];
+	return tileType == TILE_TYPE_AIR || tileType == TILE_TYPE_DIRT || tileType == TILE_TYPE_CORPSE_BRIDGE;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Strand counts in the Data files are per 100 tiles of map
+//------------------------------------------------------------------------------------------------------------------------------
+int ArenaMap::GetNumStrands(const FloatRange_T& strandsPer100Tiles, RandomNumberGenerator& rng) const
+{
+	FloatRange_T strandsOnMap;
+	strandsOnMap.min = strandsPer100Tiles.min * (float)GetNumTiles() * 0.01f;
+	strandsOnMap.max = strandsPer100Tiles.max * (float)GetNumTiles() * 0.01f;
+
+	return strandsOnMap.GetRandomIntInRange(rng);
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <vector>
+#include "ArenaDefinitions.hpp"
+#include "IntVec2.hpp"
+
+class RandomNumberGenerator;
+
+//------------------------------------------------------------------------------------------------------------------------------
+// The authoritative tiles and food of a match. Generated from a MapDefinition the way the arena does it: fill, strands of
+// each TileInfo type, a stone edge, colony starts tunnelled to the centre, and food strands on anything standable
+//------------------------------------------------------------------------------------------------------------------------------
+class ArenaMap
+{
+public:
+	void				Generate(const MapDefinition_T& definition, int mapWidth, int numColonies, RandomNumberGenerator& rng);
+	void				SpawnFood(RandomNumberGenerator& rng);		//Adds this turn's share of foodSpawnedPerTurnPer100Tiles
+
+	int					GetWidth() const { return m_width; }
+	int					GetNumTiles() const { return m_width * m_width; }
+	int					GetTileIndex(int tileX, int tileY) const { return tileY * m_width + tileX; }
+	bool				IsInBounds(int tileX, int tileY) const;
+
+	eTileType			GetTileType(int tileIndex) const { return m_tiles[tileIndex]; }
+	void				SetTileType(int tileIndex, eTileType tileType) { m_tiles[tileIndex] = tileType; }
+	bool				HasFood(int tileIndex) const { return m_food[tileIndex] != 0; }
+	void				SetFood(int tileIndex, bool hasFood) { m_food[tileIndex] = hasFood ? 1 : 0; }
+
+	const IntVec2&		GetColonyStart(int colonyIndex) const { return m_colonyStarts[colonyIndex]; }
+	int					GetNumFood() const;
+
+private:
+	void				AddStrand(eTileType tileType, int length, RandomNumberGenerator& rng);
+	void				AddFoodStrand(int length, RandomNumberGenerator& rng);
+	void				AddColonyStarts(int numColonies, RandomNumberGenerator& rng);
+	void				AddTunnel(const IntVec2& start, const IntVec2& end, RandomNumberGenerator& rng);
+
+	IntVec2				GetRandomInteriorTile(RandomNumberGenerator& rng) const;
+	IntVec2				GetRandomStep(RandomNumberGenerator& rng) const;
+	bool				IsInterior(int tileX, int tileY) const;
+	bool				CanHoldFood(int tileIndex) const;
+	int					GetNumStrands(const FloatRange_T& strandsPer100Tiles, RandomNumberGenerator& rng) const;
+
+private:
+	int							m_width = 0;
+	std::vector<eTileType>		m_tiles;
+	std::vector<unsigned char>	m_food;
+	std::vector<IntVec2>		m_colonyStarts;
+
+	eTileType					m_tunnelTile = TILE_TYPE_AIR;
+	float						m_foodSpawnedPerTurnPer100Tiles = 0.f;
+	float						m_foodSpawnDebt = 0.f;		//Fractional food carried over to the next turn
+};
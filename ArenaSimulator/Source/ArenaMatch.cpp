@@ -0,0 +1,1244 @@
+#include "ArenaMatch.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+
+constexpr int ANY_COLONY = -1;
+
+//------------------------------------------------------------------------------------------------------------------------------
+static bool IsMoveOrder(eOrderCode order)
+{
+	return order >= ORDER_MOVE_EAST && order <= ORDER_MOVE_SOUTH;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static bool IsEmoteOrder(eOrderCode order)
+{
+	return order >= ORDER_EMOTE_HAPPY && order < NUM_ORDERS;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// East, north, west, south, in the order of both the move and the dig orders. (0,0) is bottom-left, so north is +y
+//------------------------------------------------------------------------------------------------------------------------------
+static void GetOrderDirection(int directionIndex, int& outStepX, int& outStepY)
+{
+	static const int stepsX[4] = { 1, 0, -1, 0 };
+	static const int stepsY[4] = { 0, 1, 0, -1 };
+
+	outStepX = stepsX[directionIndex];
+	outStepY = stepsY[directionIndex];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static short ClampToShort(int value)
+{
+	return (short)(value > SHRT_MAX ? SHRT_MAX : value);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool ArenaMatch::Init(const MatchSettings_T& settings, std::string& outError)
+{
+	m_settings = settings;
+
+	int numColonies = (int)settings.playerLibraries.size();
+	if (numColonies < 1 || numColonies > MAX_PLAYERS)
+	{
+		outError = "a match needs between 1 and " + std::to_string((int)MAX_PLAYERS) + " players";
+		return false;
+	}
+
+	MatchInfo& matchInfo = m_startupInfo.matchInfo;
+	if (!LoadAgentDefinitions(settings.dataFolder + "/AgentDefinitions.xml", matchInfo.agentTypeInfos, outError)
+		|| !LoadMapDefinition(settings.dataFolder + "/MapDefinitions.xml", settings.mapName, m_mapDefinition, outError)
+		|| !LoadMatchDefinition(settings.dataFolder + "/MatchDefinitions.xml", settings.matchName, m_matchDefinition, outError))
+	{
+		return false;
+	}
+
+	int mapWidth = m_mapDefinition.defaultSize;
+	if (settings.mapSizeOverride > 0)
+	{
+		mapWidth = settings.mapSizeOverride;
+	}
+	else if (m_matchDefinition.mapSizeOverride > 0)
+	{
+		mapWidth = m_matchDefinition.mapSizeOverride;
+	}
+
+	if (mapWidth < 8 || mapWidth > MAX_ARENA_WIDTH)
+	{
+		outError = "map width " + std::to_string(mapWidth) + " is outside 8 to " + std::to_string(MAX_ARENA_WIDTH);
+		return false;
+	}
+
+	m_rng.Seed(settings.seed);
+	m_map.Generate(m_mapDefinition, mapWidth, numColonies, m_rng);
+
+	matchInfo.numPlayers = numColonies;
+	matchInfo.numTeams = numColonies;
+	matchInfo.mapWidth = (short)mapWidth;
+	matchInfo.fogOfWar = settings.fogOfWar;
+	matchInfo.teamSharedVision = false;
+	matchInfo.teamSharedResources = false;
+	matchInfo.nutrientsEarnedPerFoodEatenByQueen = m_matchDefinition.nutrientsEarnedPerFoodEatenByQueen;
+	matchInfo.nutrientLossPerAttackerStrength = m_matchDefinition.nutrientLossPerAttackerStrength;
+	matchInfo.nutrientLossForQueenSuffocation = m_matchDefinition.nutrientLossPerQueenSuffocation;
+	matchInfo.numTurnsBeforeSuddenDeath = m_matchDefinition.turnsUntilSuddenDeath;
+	matchInfo.suddenDeathTurnsPerUpkeepIncrease = m_matchDefinition.suddenDeathTurnsPerUpkeepIncrease;
+	matchInfo.colonyMaxPopulation = m_matchDefinition.maxPopulation;
+	matchInfo.startingNutrients = m_matchDefinition.startingNutrientsPerPlayer;
+	matchInfo.foodCarryExhaustPenalty = m_matchDefinition.foodCarryExhaustPenalty;
+	matchInfo.tileCarryExhaustPenalty = m_matchDefinition.tileCarryExhaustPenalty;
+	matchInfo.combatStrengthQueenAuraBonus = 0;
+	matchInfo.combatStrengthQueenAuraDistance = 0;
+
+	m_startupInfo.expectedThreadCount = settings.threadsPerPlayer > 1 ? settings.threadsPerPlayer : 1;
+	m_startupInfo.maxTurnSeconds = settings.maxTurnSeconds > 0.0 ? settings.maxTurnSeconds : m_matchDefinition.minTurnTime;
+	m_startupInfo.freeFaultCount = FREE_FAULT_COUNT;
+	m_startupInfo.nutrientPenaltyPerFault = m_matchDefinition.nutrientPenaltyPerFault;
+	m_startupInfo.agentsKilledPerFault = m_matchDefinition.agentsKilledPerFault;
+	m_startupInfo.debugInterface = ArenaPlayer::GetStubDebugInterface();
+	m_startupInfo.RegisterEvent = ArenaPlayer::GetStubRegisterEvent();
+	ArenaPlayer::SetLogPlayerText(settings.logPlayerText);
+
+	//A library listed again is the next instance of it, loaded from its own copy
+	for (int colonyIndex = 0; colonyIndex < numColonies; colonyIndex++)
+	{
+		const std::string& libraryPath = settings.playerLibraries[colonyIndex];
+		int instanceIndex = (int)std::count(settings.playerLibraries.begin(), settings.playerLibraries.begin() + colonyIndex, libraryPath);
+
+		m_players.push_back(std::make_unique<ArenaPlayer>());
+		if (!m_players.back()->Load(libraryPath, instanceIndex, outError))
+			return false;
+	}
+
+	m_colonies.resize(numColonies);
+	for (int colonyIndex = 0; colonyIndex < numColonies; colonyIndex++)
+	{
+		ArenaColony_T& colony = m_colonies[colonyIndex];
+		colony.player = m_players[colonyIndex].get();
+		colony.playerID = (PlayerID)(SIMULATOR_FIRST_PLAYER_ID + colonyIndex);
+		colony.teamID = (TeamID)(SIMULATOR_FIRST_TEAM_ID + colonyIndex);
+		colony.nutrients = m_matchDefinition.startingNutrientsPerPlayer;
+		colony.turnState = std::make_unique<ArenaTurnStateForPlayer>();
+		colony.turnOrders = std::make_unique<PlayerTurnOrders>();
+
+		const IntVec2& start = m_map.GetColonyStart(colonyIndex);
+		for (int agentType = 0; agentType < NUM_AGENT_TYPES; agentType++)
+		{
+			for (int agentIndex = 0; agentIndex < m_matchDefinition.startingAgents[agentType]; agentIndex++)
+			{
+				AddAgent(colonyIndex, (eAgentType)agentType, start.x, start.y);
+			}
+		}
+
+		colony.peakPopulation = GetPopulation(colonyIndex);
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Every living colony gets its turn state before any is asked for orders, the same as the arena, so the players think
+// about a turn at the same time
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMatch::Run()
+{
+	StartPlayers();
+
+	double matchStartSeconds = GetCurrentTimeSeconds();
+	int numColonies = (int)m_colonies.size();
+
+	for (m_turnNumber = 0; m_turnNumber < m_settings.maxTurns; m_turnNumber++)
+	{
+		for (int colonyIndex = 0; colonyIndex < numColonies; colonyIndex++)
+		{
+			if (!m_colonies[colonyIndex].isAlive)
+				continue;
+
+			BuildTurnState(colonyIndex);
+			m_colonies[colonyIndex].player->SendTurnState(*m_colonies[colonyIndex].turnState);
+		}
+
+		for (int colonyIndex = 0; colonyIndex < numColonies; colonyIndex++)
+		{
+			if (!m_colonies[colonyIndex].isAlive)
+				continue;
+
+			m_colonies[colonyIndex].player->RequestTurnOrders(m_turnNumber, m_colonies[colonyIndex].turnOrders.get(), m_startupInfo.maxTurnSeconds);
+		}
+
+		ResolveTurn();
+
+		if (m_settings.progressInterval > 0 && (m_turnNumber + 1) % m_settings.progressInterval == 0)
+		{
+			printf("Turn %5d:", m_turnNumber + 1);
+			for (int colonyIndex = 0; colonyIndex < numColonies; colonyIndex++)
+			{
+				printf("  [%d] %d nutrients, %d agents", colonyIndex, m_colonies[colonyIndex].nutrients, GetPopulation(colonyIndex));
+			}
+			printf("\n");
+			fflush(stdout);
+		}
+
+		int numColoniesAlive = GetNumColoniesAlive();
+		if (numColoniesAlive == 0 || (numColonies > 1 && numColoniesAlive == 1))
+		{
+			m_turnNumber++;
+			break;
+		}
+	}
+
+	m_matchSeconds = GetCurrentTimeSeconds() - matchStartSeconds;
+
+	StopPlayers();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMatch::PrintResults() const
+{
+	printf("\nMatch \"%s\" on map \"%s\" (%dx%d, seed %u)\n", m_matchDefinition.name.c_str(), m_mapDefinition.name.c_str(), m_map.GetWidth(), m_map.GetWidth(), m_settings.seed);
+	printf("%d turns in %.2f s, %.1f turns per second, %d food left on the map\n", m_turnNumber, m_matchSeconds, m_matchSeconds > 0.0 ? (double)m_turnNumber / m_matchSeconds : 0.0, m_map.GetNumFood());
+
+	printf("\n %-3s %-28s %10s %7s %6s %6s %6s %6s %6s %7s %6s %9s %9s %10s\n", "#", "Player", "Nutrients", "Agents", "Peak", "Food", "Born", "Lost", "Kills", "Faults", "Late", "Avg ms", "Max ms", "Eliminated");
+	for (int colonyIndex = 0; colonyIndex < (int)m_colonies.size(); colonyIndex++)
+	{
+		const ArenaColony_T& colony = m_colonies[colonyIndex];
+		const ArenaPlayer& player = *colony.player;
+
+		double averageMilliseconds = player.m_numTurnsResponded > 0 ? player.m_totalResponseSeconds * 1000.0 / (double)player.m_numTurnsResponded : 0.0;
+		std::string eliminated = colony.turnEliminated >= 0 ? "turn " + std::to_string(colony.turnEliminated) : "-";
+
+		printf(" %-3d %-28.28s %10d %7d %6d %6d %6d %6d %6d %7d %6d %9.3f %9.3f %10s\n", colonyIndex, player.GetName().c_str(), colony.nutrients, GetPopulation(colonyIndex),
+			colony.peakPopulation, colony.foodEaten, colony.agentsBorn, colony.agentsLost, colony.enemiesKilled, colony.numFaults, player.m_numTurnsLate,
+			averageMilliseconds, player.m_maxResponseSeconds * 1000.0, eliminated.c_str());
+	}
+
+	static const char* const faultNames[FAULT_INVALID_AGENT_ID + 1] = { "none", "turn start duration", "order fetch duration",
+		"total turn duration", "invalid order", "double ordered agent", "did not own agent", "invalid agent ID" };
+
+	for (int colonyIndex = 0; colonyIndex < (int)m_colonies.size(); colonyIndex++)
+	{
+		const ArenaColony_T& colony = m_colonies[colonyIndex];
+		if (colony.numFaults == 0)
+			continue;
+
+		printf("\n [%d] faults:", colonyIndex);
+		for (int faultType = 0; faultType <= FAULT_INVALID_AGENT_ID; faultType++)
+		{
+			if (colony.faultsByType[faultType] > 0)
+			{
+				printf(" %d %s", colony.faultsByType[faultType], faultNames[faultType]);
+			}
+		}
+	}
+	printf("\n");
+
+	if (m_colonies.size() > 1 && GetNumColoniesAlive() == 1)
+	{
+		for (int colonyIndex = 0; colonyIndex < (int)m_colonies.size(); colonyIndex++)
+		{
+			if (m_colonies[colonyIndex].isAlive)
+			{
+				printf("\nWinner: [%d] %s\n", colonyIndex, m_colonies[colonyIndex].player->GetName().c_str());
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMatch::StartPlayers()
+{
+	static const Color8 colonyColors[8] = { Color8(255, 64, 64), Color8(64, 128, 255), Color8(64, 255, 64), Color8(255, 255, 64),
+		Color8(255, 64, 255), Color8(64, 255, 255), Color8(255, 160, 64), Color8(200, 200, 200) };
+
+	for (int colonyIndex = 0; colonyIndex < (int)m_colonies.size(); colonyIndex++)
+	{
+		const ArenaColony_T& colony = m_colonies[colonyIndex];
+
+		StartupInfo info = m_startupInfo;
+		info.yourPlayerInfo.playerID = colony.playerID;
+		info.yourPlayerInfo.teamID = colony.teamID;
+		info.yourPlayerInfo.teamSize = 1;
+		info.yourPlayerInfo.color = colonyColors[colonyIndex % 8];
+
+		colony.player->Startup(info);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMatch::StopPlayers()
+{
+	for (int colonyIndex = 0; colonyIndex < (int)m_colonies.size(); colonyIndex++)
+	{
+		m_colonies[colonyIndex].player->Shutdown();
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMatch::BuildTurnState(int colonyIndex)
+{
+	ArenaColony_T& colony = m_colonies[colonyIndex];
+	ArenaTurnStateForPlayer& state = *colony.turnState;
+
+	state.turnNumber = m_turnNumber;
+	state.currentNutrients = colony.nutrients;
+	state.numFaults = colony.numFaults;
+	state.nutrientsLostDueToFault = colony.nutrientsLostDueToFault;
+	state.nutrientsLostDueToQueenDamage = colony.nutrientsLostDueToQueenDamage;
+	state.nutrientsLostDueToQueenSuffocation = colony.nutrientsLostDueToQueenSuffocation;
+
+	//Living agents first, then the ones that died last turn
+	state.numReports = 0;
+	for (int agentIndex = 0; agentIndex < (int)m_agents.size() && state.numReports < MAX_REPORTS_PER_PLAYER; agentIndex++)
+	{
+		const ArenaAgent_T& agent = m_agents[agentIndex];
+		if (agent.colonyIndex != colonyIndex)
+			continue;
+
+		AgentReport& report = state.agentReports[state.numReports++];
+		report.agentID = agent.agentID;
+		report.tileX = agent.tileX;
+		report.tileY = agent.tileY;
+		report.exhaustion = agent.exhaustion;
+		report.receivedCombatDamage = agent.receivedCombatDamage;
+		report.receivedSuffocationDamage = agent.receivedSuffocationDamage;
+		report.type = agent.type;
+		report.state = agent.state;
+		report.result = agent.result;
+	}
+
+	for (int reportIndex = 0; reportIndex < (int)colony.deathReports.size() && state.numReports < MAX_REPORTS_PER_PLAYER; reportIndex++)
+	{
+		state.agentReports[state.numReports++] = colony.deathReports[reportIndex];
+	}
+
+	std::vector<unsigned char> visible;
+	MarkVisibleTiles(colonyIndex, visible);
+
+	for (int tileIndex = 0; tileIndex < m_map.GetNumTiles(); tileIndex++)
+	{
+		state.observedTiles[tileIndex] = visible[tileIndex] ? m_map.GetTileType(tileIndex) : TILE_TYPE_UNSEEN;
+		state.tilesThatHaveFood[tileIndex] = visible[tileIndex] && m_map.HasFood(tileIndex);
+	}
+
+	state.numObservedAgents = 0;
+	for (int agentIndex = 0; agentIndex < (int)m_agents.size() && state.numObservedAgents < MAX_AGENTS_TOTAL; agentIndex++)
+	{
+		const ArenaAgent_T& agent = m_agents[agentIndex];
+		if (agent.colonyIndex == colonyIndex || !visible[m_map.GetTileIndex(agent.tileX, agent.tileY)])
+			continue;
+
+		const ArenaColony_T& owner = m_colonies[agent.colonyIndex];
+
+		ObservedAgent& observed = state.observedAgents[state.numObservedAgents++];
+		observed.agentID = agent.agentID;
+		observed.playerID = owner.playerID;
+		observed.teamID = owner.teamID;
+		observed.tileX = agent.tileX;
+		observed.tileY = agent.tileY;
+		observed.receivedCombatDamage = agent.receivedCombatDamage;
+		observed.receivedSuffocationDamage = agent.receivedSuffocationDamage;
+		observed.type = agent.type;
+		observed.state = agent.state;
+		observed.lastObservedAction = agent.order;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Every agent sees a taxicab diamond of its visibilityRange, walls don't block sight
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMatch::MarkVisibleTiles(int colonyIndex, std::vector<unsigned char>& outVisible) const
+{
+	if (!m_settings.fogOfWar)
+	{
+		outVisible.assign(m_map.GetNumTiles(), 1);
+		return;
+	}
+
+	outVisible.assign(m_map.GetNumTiles(), 0);
+	int mapWidth = m_map.GetWidth();
+
+	for (int agentIndex = 0; agentIndex < (int)m_agents.size(); agentIndex++)
+	{
+		const ArenaAgent_T& agent = m_agents[agentIndex];
+		if (agent.colonyIndex != colonyIndex)
+			continue;
+
+		int range = GetTypeInfo(agent).visibilityRange;
+		int minY = std::max(agent.tileY - range, 0);
+		int maxY = std::min(agent.tileY + range, mapWidth - 1);
+
+		for (int tileY = minY; tileY <= maxY; tileY++)
+		{
+			int rowRange = range - abs(tileY - agent.tileY);
+			int minX = std::max(agent.tileX - rowRange, 0);
+			int maxX = std::min(agent.tileX + rowRange, mapWidth - 1);
+
+			for (int tileX = minX; tileX <= maxX; tileX++)
+			{
+				outVisible[m_map.GetTileIndex(tileX, tileY)] = 1;
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// All orders of a turn resolve together: actions in place first, then moves, then queens eat what they stand on, then
+// every contested tile fights. Food spawns and upkeep is paid after that, the same order the arena reports them in
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMatch::ResolveTurn()
+{
+	for (int colonyIndex = 0; colonyIndex < (int)m_colonies.size(); colonyIndex++)
+	{
+		ArenaColony_T& colony = m_colonies[colonyIndex];
+		colony.nutrientsLostDueToFault = 0;
+		colony.nutrientsLostDueToQueenDamage = 0;
+		colony.nutrientsLostDueToQueenSuffocation = 0;
+		colony.numSuicides = 0;
+		colony.deathReports.clear();
+	}
+
+	for (int agentIndex = 0; agentIndex < (int)m_agents.size(); agentIndex++)
+	{
+		ArenaAgent_T& agent = m_agents[agentIndex];
+		agent.order = ORDER_HOLD;
+		agent.result = AGENT_ORDER_SUCCESS_HELD;
+		agent.isOrdered = false;
+		agent.wasExhausted = agent.exhaustion > 0;
+		agent.hasAttacked = false;
+		agent.receivedCombatDamage = 0;
+		agent.receivedSuffocationDamage = 0;
+	}
+
+	for (int colonyIndex = 0; colonyIndex < (int)m_colonies.size(); colonyIndex++)
+	{
+		if (m_colonies[colonyIndex].isAlive)
+		{
+			ReadOrders(colonyIndex);
+		}
+	}
+
+	std::vector<int> orderedAgents = GetAgentsInTurnOrder();
+	ResolveActions(orderedAgents);
+	ResolveMoves(orderedAgents);
+	ResolveQueensEating();
+	ResolveCombat();
+
+	if (m_turnNumber < m_matchDefinition.turnsUntilSuddenDeath)
+	{
+		m_map.SpawnFood(m_rng);
+	}
+
+	ResolveUpkeep();
+
+	for (int agentIndex = 0; agentIndex < (int)m_agents.size(); agentIndex++)
+	{
+		ArenaAgent_T& agent = m_agents[agentIndex];
+		if (agent.wasExhausted && agent.exhaustion > 0)
+		{
+			agent.exhaustion--;
+		}
+	}
+
+	RemoveDeadAgents();
+
+	for (int colonyIndex = 0; colonyIndex < (int)m_colonies.size(); colonyIndex++)
+	{
+		ArenaColony_T& colony = m_colonies[colonyIndex];
+		int population = GetPopulation(colonyIndex);
+		colony.peakPopulation = std::max(colony.peakPopulation, population);
+
+		if (colony.isAlive && population == 0)
+		{
+			colony.isAlive = false;
+			colony.turnEliminated = m_turnNumber;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMatch::ReadOrders(int colonyIndex)
+{
+	const PlayerTurnOrders& orders = *m_colonies[colonyIndex].turnOrders;
+
+	int numOrders = orders.numberOfOrders;
+	if (numOrders < 0 || numOrders > MAX_ORDERS_PER_PLAYER)
+	{
+		AddFault(colonyIndex, FAULT_INVALID_ORDER);
+		numOrders = numOrders < 0 ? 0 : MAX_ORDERS_PER_PLAYER;
+	}
+
+	for (int orderIndex = 0; orderIndex < numOrders; orderIndex++)
+	{
+		const AgentOrder& order = orders.orders[orderIndex];
+
+		std::unordered_map<AgentID, int>::const_iterator agentIterator = m_agentIndices.find(order.agentID);
+		if (agentIterator == m_agentIndices.end())
+		{
+			AddFault(colonyIndex, FAULT_INVALID_AGENT_ID);
+			continue;
+		}
+
+		ArenaAgent_T& agent = m_agents[agentIterator->second];
+		if (agent.colonyIndex != colonyIndex)
+		{
+			AddFault(colonyIndex, FAULT_DID_NOT_OWN_AGENT);
+			continue;
+		}
+
+		if (agent.isOrdered)
+		{
+			AddFault(colonyIndex, FAULT_DOUBLE_ORDERED_AGENT);
+			continue;
+		}
+
+		if (order.order >= NUM_ORDERS)
+		{
+			AddFault(colonyIndex, FAULT_INVALID_ORDER);
+			continue;
+		}
+
+		agent.order = order.order;
+		agent.isOrdered = true;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMatch::AddFault(int colonyIndex, eFaultType fault)
+{
+	ArenaColony_T& colony = m_colonies[colonyIndex];
+	colony.numFaults++;
+	colony.faultsByType[fault]++;
+
+	if (colony.numFaults <= m_startupInfo.freeFaultCount)
+		return;
+
+	colony.nutrients -= m_startupInfo.nutrientPenaltyPerFault;
+	colony.nutrientsLostDueToFault += m_startupInfo.nutrientPenaltyPerFault;
+
+	for (int killIndex = 0; killIndex < m_startupInfo.agentsKilledPerFault; killIndex++)
+	{
+		int sacrificeIndex = PickSacrifice(colonyIndex);
+		if (sacrificeIndex < 0)
+			break;
+
+		KillAgent(m_agents[sacrificeIndex], AGENT_KILLED_BY_PENALTY);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Everything that doesn't move the agent. Births append to m_agents, so agents are only ever held by index here
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMatch::ResolveActions(const std::vector<int>& orderedAgents)
+{
+	for (int orderIndex = 0; orderIndex < (int)orderedAgents.size(); orderIndex++)
+	{
+		int agentIndex = orderedAgents[orderIndex];
+		if (m_agents[agentIndex].isDead)
+			continue;
+
+		eOrderCode order = m_agents[agentIndex].order;
+		if (order == ORDER_HOLD || IsEmoteOrder(order))
+			continue;
+
+		if (m_agents[agentIndex].wasExhausted)
+		{
+			m_agents[agentIndex].result = AGENT_ORDER_ERROR_EXHAUSTED;
+			continue;
+		}
+
+		switch (order)
+		{
+		case ORDER_DIG_HERE:
+		case ORDER_DIG_EAST:
+		case ORDER_DIG_NORTH:
+		case ORDER_DIG_WEST:
+		case ORDER_DIG_SOUTH:
+			Dig(m_agents[agentIndex]);
+			break;
+		case ORDER_PICK_UP_FOOD:
+			PickUpFood(m_agents[agentIndex]);
+			break;
+		case ORDER_PICK_UP_TILE:
+			PickUpTile(m_agents[agentIndex]);
+			break;
+		case ORDER_DROP_CARRIED_OBJECT:
+			Drop(m_agents[agentIndex]);
+			break;
+		case ORDER_BIRTH_SCOUT:
+		case ORDER_BIRTH_WORKER:
+		case ORDER_BIRTH_SOLDIER:
+		case ORDER_BIRTH_QUEEN:
+			Birth(agentIndex, (eAgentType)(AGENT_TYPE_SCOUT + (order - ORDER_BIRTH_SCOUT)));
+			break;
+		case ORDER_SUICIDE:
+			m_colonies[m_agents[agentIndex].colonyIndex].numSuicides++;
+			KillAgent(m_agents[agentIndex], AGENT_ORDER_SUCCESS_SUICIDE);
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Moves go one at a time in turn order, except into water: everyone stepping into the same water tile this turn arrives
+// together, the one with the highest sacrificePriority drowns and the rest walk over the bridge it leaves
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMatch::ResolveMoves(const std::vector<int>& orderedAgents)
+{
+	std::vector<int> waterTiles;
+	std::unordered_map<int, std::vector<int>> agentsIntoWater;
+
+	for (int orderIndex = 0; orderIndex < (int)orderedAgents.size(); orderIndex++)
+	{
+		ArenaAgent_T& agent = m_agents[orderedAgents[orderIndex]];
+		if (agent.isDead || agent.wasExhausted || !IsMoveOrder(agent.order))
+			continue;
+
+		int stepX = 0;
+		int stepY = 0;
+		GetOrderDirection(agent.order - ORDER_MOVE_EAST, stepX, stepY);
+
+		int targetX = agent.tileX + stepX;
+		int targetY = agent.tileY + stepY;
+		if (!m_map.IsInBounds(targetX, targetY))
+		{
+			agent.result = AGENT_ORDER_ERROR_OUT_OF_BOUNDS;
+			continue;
+		}
+
+		int targetIndex = m_map.GetTileIndex(targetX, targetY);
+		eTileType targetType = m_map.GetTileType(targetIndex);
+		if (GetTypeInfo(agent).moveExhaustPenalties[targetType] == TILE_IMPASSABLE)
+		{
+			agent.result = AGENT_ORDER_ERROR_MOVE_BLOCKED_BY_TILE;
+			continue;
+		}
+
+		if (agent.type == AGENT_TYPE_QUEEN && HasQueenOnTile(targetIndex, ANY_COLONY, &agent))
+		{
+			agent.result = AGENT_ORDER_ERROR_MOVE_BLOCKED_BY_QUEEN;
+			continue;
+		}
+
+		if (targetType == TILE_TYPE_WATER)
+		{
+			std::vector<int>& movers = agentsIntoWater[targetIndex];
+			if (movers.empty())
+			{
+				waterTiles.push_back(targetIndex);
+			}
+
+			movers.push_back(orderedAgents[orderIndex]);
+			continue;
+		}
+
+		int carryPenalty = agent.state == STATE_HOLDING_FOOD ? m_matchDefinition.foodCarryExhaustPenalty : (agent.state == STATE_HOLDING_DIRT ? m_matchDefinition.tileCarryExhaustPenalty : 0);
+		agent.tileX = (short)targetX;
+		agent.tileY = (short)targetY;
+		agent.exhaustion = ClampToShort(agent.exhaustion + GetTypeInfo(agent).moveExhaustPenalties[targetType] + carryPenalty);
+		agent.result = AGENT_ORDER_SUCCESS_MOVED;
+	}
+
+	for (int waterIndex = 0; waterIndex < (int)waterTiles.size(); waterIndex++)
+	{
+		int tileIndex = waterTiles[waterIndex];
+		const std::vector<int>& movers = agentsIntoWater[tileIndex];
+
+		int sacrificeIndex = movers[0];
+		for (int moverIndex = 1; moverIndex < (int)movers.size(); moverIndex++)
+		{
+			if (GetTypeInfo(m_agents[movers[moverIndex]]).sacrificePriority > GetTypeInfo(m_agents[sacrificeIndex]).sacrificePriority)
+			{
+				sacrificeIndex = movers[moverIndex];
+			}
+		}
+
+		m_map.SetTileType(tileIndex, TILE_TYPE_CORPSE_BRIDGE);
+
+		for (int moverIndex = 0; moverIndex < (int)movers.size(); moverIndex++)
+		{
+			ArenaAgent_T& agent = m_agents[movers[moverIndex]];
+			agent.tileX = (short)(tileIndex % m_map.GetWidth());
+			agent.tileY = (short)(tileIndex / m_map.GetWidth());
+
+			if (movers[moverIndex] == sacrificeIndex)
+			{
+				KillAgent(agent, AGENT_KILLED_BY_WATER);
+				continue;
+			}
+
+			int carryPenalty = agent.state == STATE_HOLDING_FOOD ? m_matchDefinition.foodCarryExhaustPenalty : (agent.state == STATE_HOLDING_DIRT ? m_matchDefinition.tileCarryExhaustPenalty : 0);
+			agent.exhaustion = ClampToShort(agent.exhaustion + GetTypeInfo(agent).moveExhaustPenalties[TILE_TYPE_CORPSE_BRIDGE] + carryPenalty);
+			agent.result = AGENT_ORDER_SUCCESS_MOVED;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMatch::ResolveQueensEating()
+{
+	for (int agentIndex = 0; agentIndex < (int)m_agents.size(); agentIndex++)
+	{
+		const ArenaAgent_T& agent = m_agents[agentIndex];
+		if (agent.isDead || agent.type != AGENT_TYPE_QUEEN)
+			continue;
+
+		int tileIndex = m_map.GetTileIndex(agent.tileX, agent.tileY);
+		if (!m_map.HasFood(tileIndex))
+			continue;
+
+		m_map.SetFood(tileIndex, false);
+		m_colonies[agent.colonyIndex].nutrients += m_matchDefinition.nutrientsEarnedPerFoodEatenByQueen;
+		m_colonies[agent.colonyIndex].foodEaten++;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// On every tile with more than one team, agents attack in combatPriority order, each at most once. An attacker takes on the
+// enemy with the highest combatPriority, queens last. A duel kills whoever has the lower combatStrength, both on a tie.
+// Queens are never killed, their colony pays nutrients for every point of strength that hits them
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMatch::ResolveCombat()
+{
+	std::unordered_map<int, std::vector<int>> agentsOnTiles;
+	std::vector<int> contestedTiles;
+
+	for (int agentIndex = 0; agentIndex < (int)m_agents.size(); agentIndex++)
+	{
+		const ArenaAgent_T& agent = m_agents[agentIndex];
+		if (agent.isDead)
+			continue;
+
+		int tileIndex = m_map.GetTileIndex(agent.tileX, agent.tileY);
+		std::vector<int>& agentsOnTile = agentsOnTiles[tileIndex];
+		//Contested once anyone on the tile isn't on the team of whoever got there first
+		if (!agentsOnTile.empty() && m_colonies[m_agents[agentsOnTile[0]].colonyIndex].teamID != m_colonies[agent.colonyIndex].teamID
+			&& std::find(contestedTiles.begin(), contestedTiles.end(), tileIndex) == contestedTiles.end())
+		{
+			contestedTiles.push_back(tileIndex);
+		}
+
+		agentsOnTile.push_back(agentIndex);
+	}
+
+	for (int contestedIndex = 0; contestedIndex < (int)contestedTiles.size(); contestedIndex++)
+	{
+		std::vector<int>& fighters = agentsOnTiles[contestedTiles[contestedIndex]];
+		std::stable_sort(fighters.begin(), fighters.end(), [this](int agentA, int agentB)
+		{
+			return GetTypeInfo(m_agents[agentA]).combatPriority > GetTypeInfo(m_agents[agentB]).combatPriority;
+		});
+
+		for (int attackerIndex = 0; attackerIndex < (int)fighters.size(); attackerIndex++)
+		{
+			ArenaAgent_T& attacker = m_agents[fighters[attackerIndex]];
+			if (attacker.isDead || attacker.hasAttacked || attacker.type == AGENT_TYPE_QUEEN)
+				continue;
+
+			TeamID attackerTeam = m_colonies[attacker.colonyIndex].teamID;
+			int targetIndex = -1;
+			for (int fighterIndex = 0; fighterIndex < (int)fighters.size(); fighterIndex++)
+			{
+				const ArenaAgent_T& fighter = m_agents[fighters[fighterIndex]];
+				if (fighter.isDead || m_colonies[fighter.colonyIndex].teamID == attackerTeam)
+					continue;
+
+				if (targetIndex < 0 || (m_agents[targetIndex].type == AGENT_TYPE_QUEEN && fighter.type != AGENT_TYPE_QUEEN))
+				{
+					targetIndex = fighters[fighterIndex];
+				}
+			}
+
+			if (targetIndex < 0)
+				continue;
+
+			ArenaAgent_T& target = m_agents[targetIndex];
+			ArenaColony_T& targetColony = m_colonies[target.colonyIndex];
+			int attackerStrength = GetCombatStrength(attacker);
+			attacker.hasAttacked = true;
+
+			if (target.type == AGENT_TYPE_QUEEN)
+			{
+				int nutrientLoss = m_matchDefinition.nutrientLossPerAttackerStrength * attackerStrength;
+				targetColony.nutrients -= nutrientLoss;
+				targetColony.nutrientsLostDueToQueenDamage += nutrientLoss;
+				target.receivedCombatDamage = ClampToShort(target.receivedCombatDamage + nutrientLoss);
+				continue;
+			}
+
+			int targetStrength = GetCombatStrength(target);
+			if (targetStrength <= attackerStrength)
+			{
+				target.receivedCombatDamage = 1;
+				KillAgent(target, AGENT_KILLED_BY_ENEMY);
+				m_colonies[attacker.colonyIndex].enemiesKilled++;
+			}
+
+			if (attackerStrength <= targetStrength)
+			{
+				attacker.receivedCombatDamage = 1;
+				KillAgent(attacker, AGENT_KILLED_BY_ENEMY);
+				targetColony.enemiesKilled++;
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// A colony that can't pay its upkeep starves one agent a turn, unless it gave one up itself this turn. A colony without
+// a queen has no nutrients at all, so it starves every turn until nothing is left
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMatch::ResolveUpkeep()
+{
+	for (int colonyIndex = 0; colonyIndex < (int)m_colonies.size(); colonyIndex++)
+	{
+		ArenaColony_T& colony = m_colonies[colonyIndex];
+		if (!colony.isAlive)
+			continue;
+
+		int upkeep = 0;
+		bool hasQueen = false;
+		for (int agentIndex = 0; agentIndex < (int)m_agents.size(); agentIndex++)
+		{
+			const ArenaAgent_T& agent = m_agents[agentIndex];
+			if (agent.colonyIndex != colonyIndex || agent.isDead)
+				continue;
+
+			upkeep += GetTypeInfo(agent).upkeepPerTurn;
+			hasQueen = hasQueen || agent.type == AGENT_TYPE_QUEEN;
+		}
+
+		int turnsIntoSuddenDeath = m_turnNumber - m_matchDefinition.turnsUntilSuddenDeath;
+		if (turnsIntoSuddenDeath >= 0 && m_matchDefinition.suddenDeathTurnsPerUpkeepIncrease > 0)
+		{
+			upkeep += 1 + turnsIntoSuddenDeath / m_matchDefinition.suddenDeathTurnsPerUpkeepIncrease;
+		}
+
+		if (!hasQueen)
+		{
+			colony.nutrients = 0;
+		}
+
+		colony.nutrients -= upkeep;
+		if (colony.nutrients >= 0)
+			continue;
+
+		colony.nutrients = 0;
+		if (colony.numSuicides > 0)
+			continue;
+
+		int sacrificeIndex = PickSacrifice(colonyIndex);
+		if (sacrificeIndex >= 0)
+		{
+			KillAgent(m_agents[sacrificeIndex], AGENT_KILLED_BY_STARVATION);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMatch::RemoveDeadAgents()
+{
+	int numLiving = 0;
+	for (int agentIndex = 0; agentIndex < (int)m_agents.size(); agentIndex++)
+	{
+		const ArenaAgent_T& agent = m_agents[agentIndex];
+		if (!agent.isDead)
+		{
+			m_agents[numLiving++] = agent;
+			continue;
+		}
+
+		AgentReport report;
+		report.agentID = agent.agentID;
+		report.tileX = agent.tileX;
+		report.tileY = agent.tileY;
+		report.exhaustion = agent.exhaustion;
+		report.receivedCombatDamage = agent.receivedCombatDamage;
+		report.receivedSuffocationDamage = agent.receivedSuffocationDamage;
+		report.type = agent.type;
+		report.state = STATE_DEAD;
+		report.result = agent.result;
+
+		m_colonies[agent.colonyIndex].deathReports.push_back(report);
+	}
+
+	m_agents.resize(numLiving);
+
+	m_agentIndices.clear();
+	for (int agentIndex = 0; agentIndex < numLiving; agentIndex++)
+	{
+		m_agentIndices[m_agents[agentIndex].agentID] = agentIndex;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMatch::Birth(int queenIndex, eAgentType childType)
+{
+	ArenaAgent_T& queen = m_agents[queenIndex];
+	ArenaColony_T& colony = m_colonies[queen.colonyIndex];
+	const AgentTypeInfo& childInfo = m_startupInfo.matchInfo.agentTypeInfos[childType];
+
+	if (!GetTypeInfo(queen).canBirth || childInfo.costToBirth < 0)
+	{
+		queen.result = AGENT_ORDER_ERROR_CANT_BIRTH;
+		return;
+	}
+
+	if (GetPopulation(queen.colonyIndex) >= m_matchDefinition.maxPopulation)
+	{
+		queen.result = AGENT_ORDER_ERROR_MAXIMUM_POPULATION_REACHED;
+		return;
+	}
+
+	if (colony.nutrients < childInfo.costToBirth)
+	{
+		queen.result = AGENT_ORDER_ERROR_INSUFFICIENT_FOOD;
+		return;
+	}
+
+	colony.nutrients -= childInfo.costToBirth;
+	colony.agentsBorn++;
+
+	queen.exhaustion = ClampToShort(queen.exhaustion + childInfo.exhaustAfterBirth);
+	queen.result = AGENT_ORDER_SUCCESS_GAVE_BIRTH;
+
+	//Invalidates queen
+	AddAgent(queen.colonyIndex, childType, queen.tileX, queen.tileY);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Dirt digs out to air and a corpse bridge back to water, drowning whoever stands on it. Digging where the agent stands
+// never exhausts it
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMatch::Dig(ArenaAgent_T& agent)
+{
+	int targetX = agent.tileX;
+	int targetY = agent.tileY;
+	if (agent.order != ORDER_DIG_HERE)
+	{
+		int stepX = 0;
+		int stepY = 0;
+		GetOrderDirection(agent.order - ORDER_DIG_EAST, stepX, stepY);
+
+		targetX += stepX;
+		targetY += stepY;
+	}
+
+	if (!m_map.IsInBounds(targetX, targetY))
+	{
+		agent.result = AGENT_ORDER_ERROR_OUT_OF_BOUNDS;
+		return;
+	}
+
+	if (agent.state == STATE_HOLDING_DIRT)
+	{
+		agent.result = AGENT_ORDER_ERROR_CANT_DIG_WHILE_CARRYING;
+		return;
+	}
+
+	int tileIndex = m_map.GetTileIndex(targetX, targetY);
+	eTileType tileType = m_map.GetTileType(tileIndex);
+	int digPenalty = GetTypeInfo(agent).digExhaustPenalties[tileType];
+	if (digPenalty == DIG_IMPOSSIBLE || (tileType != TILE_TYPE_DIRT && tileType != TILE_TYPE_CORPSE_BRIDGE))
+	{
+		agent.result = AGENT_ORDER_ERROR_CANT_DIG_INVALID_TILE;
+		return;
+	}
+
+	if (agent.order != ORDER_DIG_HERE)
+	{
+		agent.exhaustion = ClampToShort(agent.exhaustion + digPenalty);
+	}
+
+	agent.result = AGENT_ORDER_SUCCESS_DUG;
+
+	if (tileType == TILE_TYPE_DIRT)
+	{
+		m_map.SetTileType(tileIndex, TILE_TYPE_AIR);
+		return;
+	}
+
+	m_map.SetTileType(tileIndex, TILE_TYPE_WATER);
+	for (int agentIndex = 0; agentIndex < (int)m_agents.size(); agentIndex++)
+	{
+		ArenaAgent_T& drowned = m_agents[agentIndex];
+		if (!drowned.isDead && drowned.tileX == targetX && drowned.tileY == targetY)
+		{
+			KillAgent(drowned, AGENT_KILLED_BY_WATER);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMatch::PickUpFood(ArenaAgent_T& agent)
+{
+	if (!GetTypeInfo(agent).canCarryFood || agent.state == STATE_HOLDING_DIRT)
+	{
+		agent.result = AGENT_ORDER_ERROR_CANT_CARRY_FOOD;
+		return;
+	}
+
+	if (agent.state == STATE_HOLDING_FOOD)
+	{
+		agent.result = AGENT_ORDER_ERROR_ALREADY_CARRYING_FOOD;
+		return;
+	}
+
+	int tileIndex = m_map.GetTileIndex(agent.tileX, agent.tileY);
+	if (!m_map.HasFood(tileIndex))
+	{
+		agent.result = AGENT_ORDER_ERROR_NO_FOOD_PRESENT;
+		return;
+	}
+
+	m_map.SetFood(tileIndex, false);
+	agent.state = STATE_HOLDING_FOOD;
+	agent.result = AGENT_ORDER_SUCCESS_PICKUP;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Only dirt can be carried, picking it up leaves air behind
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMatch::PickUpTile(ArenaAgent_T& agent)
+{
+	int tileIndex = m_map.GetTileIndex(agent.tileX, agent.tileY);
+	if (!GetTypeInfo(agent).canCarryTiles || agent.state != STATE_NORMAL || m_map.GetTileType(tileIndex) != TILE_TYPE_DIRT)
+	{
+		agent.result = AGENT_ORDER_ERROR_CANT_CARRY_TILE;
+		return;
+	}
+
+	m_map.SetTileType(tileIndex, TILE_TYPE_AIR);
+	agent.state = STATE_HOLDING_DIRT;
+	agent.result = AGENT_ORDER_SUCCESS_PICKUP;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Food dropped on a friendly queen is eaten. Anywhere else it stays on the tile, unless there is food already, then the
+// tile can't hold a second and it is lost. Dropped dirt fills the tile in, suffocating whoever can't stand in dirt
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMatch::Drop(ArenaAgent_T& agent)
+{
+	if (agent.state == STATE_NORMAL)
+	{
+		agent.result = AGENT_ORDER_ERROR_NOT_CARRYING;
+		return;
+	}
+
+	int tileIndex = m_map.GetTileIndex(agent.tileX, agent.tileY);
+	agent.result = AGENT_ORDER_SUCCESS_DROP;
+
+	if (agent.state == STATE_HOLDING_FOOD)
+	{
+		agent.state = STATE_NORMAL;
+
+		if (HasQueenOnTile(tileIndex, agent.colonyIndex, nullptr))
+		{
+			m_colonies[agent.colonyIndex].nutrients += m_matchDefinition.nutrientsEarnedPerFoodEatenByQueen;
+			m_colonies[agent.colonyIndex].foodEaten++;
+			return;
+		}
+
+		m_map.SetFood(tileIndex, true);
+		return;
+	}
+
+	agent.state = STATE_NORMAL;
+	m_map.SetTileType(tileIndex, TILE_TYPE_DIRT);
+	SuffocateAgentsOnTile(tileIndex, agent);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMatch::SuffocateAgentsOnTile(int tileIndex, const ArenaAgent_T& dropper)
+{
+	for (int agentIndex = 0; agentIndex < (int)m_agents.size(); agentIndex++)
+	{
+		ArenaAgent_T& agent = m_agents[agentIndex];
+		if (agent.isDead || &agent == &dropper || m_map.GetTileIndex(agent.tileX, agent.tileY) != tileIndex)
+			continue;
+
+		if (GetTypeInfo(agent).moveExhaustPenalties[TILE_TYPE_DIRT] != TILE_IMPASSABLE)
+			continue;
+
+		if (agent.type == AGENT_TYPE_QUEEN)
+		{
+			int nutrientLoss = m_matchDefinition.nutrientLossPerQueenSuffocation;
+			ArenaColony_T& colony = m_colonies[agent.colonyIndex];
+			colony.nutrients -= nutrientLoss;
+			colony.nutrientsLostDueToQueenSuffocation += nutrientLoss;
+			agent.receivedSuffocationDamage = ClampToShort(agent.receivedSuffocationDamage + nutrientLoss);
+			continue;
+		}
+
+		agent.receivedSuffocationDamage = 1;
+		KillAgent(agent, AGENT_KILLED_BY_SUFFOCATION);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// An agent's ID carries its owner's playerID in the highest byte, the rest counts up per colony
+//------------------------------------------------------------------------------------------------------------------------------
+int ArenaMatch::AddAgent(int colonyIndex, eAgentType type, int tileX, int tileY)
+{
+	ArenaColony_T& colony = m_colonies[colonyIndex];
+
+	ArenaAgent_T agent;
+	agent.agentID = ((AgentID)colony.playerID << 24) | (AgentID)(colony.nextAgentSerial++);
+	agent.colonyIndex = colonyIndex;
+	agent.type = type;
+	agent.tileX = (short)tileX;
+	agent.tileY = (short)tileY;
+	agent.result = AGENT_WAS_CREATED;
+
+	m_agentIndices[agent.agentID] = (int)m_agents.size();
+	m_agents.push_back(agent);
+	return (int)m_agents.size() - 1;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Dead agents stay in m_agents until RemoveDeadAgents, so indices held during a turn stay good
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaMatch::KillAgent(ArenaAgent_T& agent, eAgentOrderResult cause)
+{
+	if (agent.isDead)
+		return;
+
+	agent.isDead = true;
+	agent.result = cause;
+	m_colonies[agent.colonyIndex].agentsLost++;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// The living agent with the highest sacrificePriority, the youngest of them on a tie
+//------------------------------------------------------------------------------------------------------------------------------
+int ArenaMatch::PickSacrifice(int colonyIndex) const
+{
+	int sacrificeIndex = -1;
+	for (int agentIndex = 0; agentIndex < (int)m_agents.size(); agentIndex++)
+	{
+		const ArenaAgent_T& agent = m_agents[agentIndex];
+		if (agent.isDead || agent.colonyIndex != colonyIndex)
+			continue;
+
+		if (sacrificeIndex < 0 || GetTypeInfo(agent).sacrificePriority >= GetTypeInfo(m_agents[sacrificeIndex]).sacrificePriority)
+		{
+			sacrificeIndex = agentIndex;
+		}
+	}
+
+	return sacrificeIndex;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int ArenaMatch::GetPopulation(int colonyIndex) const
+{
+	int population = 0;
+	for (int agentIndex = 0; agentIndex < (int)m_agents.size(); agentIndex++)
+	{
+		if (!m_agents[agentIndex].isDead && m_agents[agentIndex].colonyIndex == colonyIndex)
+		{
+			population++;
+		}
+	}
+
+	return population;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool ArenaMatch::HasQueenOnTile(int tileIndex, int colonyIndex, const ArenaAgent_T* except) const
+{
+	for (int agentIndex = 0; agentIndex < (int)m_agents.size(); agentIndex++)
+	{
+		const ArenaAgent_T& agent = m_agents[agentIndex];
+		if (agent.isDead || agent.type != AGENT_TYPE_QUEEN || &agent == except)
+			continue;
+
+		if (colonyIndex != ANY_COLONY && agent.colonyIndex != colonyIndex)
+			continue;
+
+		if (m_map.GetTileIndex(agent.tileX, agent.tileY) == tileIndex)
+			return true;
+	}
+
+	return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool ArenaMatch::IsQueenNear(int colonyIndex, int tileX, int tileY, int distance) const
+{
+	for (int agentIndex = 0; agentIndex < (int)m_agents.size(); agentIndex++)
+	{
+		const ArenaAgent_T& agent = m_agents[agentIndex];
+		if (agent.isDead || agent.type != AGENT_TYPE_QUEEN || agent.colonyIndex != colonyIndex)
+			continue;
+
+		if (abs(agent.tileX - tileX) + abs(agent.tileY - tileY) <= distance)
+			return true;
+	}
+
+	return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int ArenaMatch::GetCombatStrength(const ArenaAgent_T& agent) const
+{
+	const MatchInfo& matchInfo = m_startupInfo.matchInfo;
+
+	int strength = GetTypeInfo(agent).combatStrength;
+	if (matchInfo.combatStrengthQueenAuraBonus > 0 && IsQueenNear(agent.colonyIndex, agent.tileX, agent.tileY, matchInfo.combatStrengthQueenAuraDistance))
+	{
+		strength += matchInfo.combatStrengthQueenAuraBonus;
+	}
+
+	return strength;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Colonies take turns, one agent each, starting from a different colony every turn so no one always moves first
+//------------------------------------------------------------------------------------------------------------------------------
+std::vector<int> ArenaMatch::GetAgentsInTurnOrder() const
+{
+	int numColonies = (int)m_colonies.size();
+
+	std::vector<std::vector<int>> agentsPerColony(numColonies);
+	for (int agentIndex = 0; agentIndex < (int)m_agents.size(); agentIndex++)
+	{
+		agentsPerColony[m_agents[agentIndex].colonyIndex].push_back(agentIndex);
+	}
+
+	std::vector<int> orderedAgents;
+	orderedAgents.reserve(m_agents.size());
+
+	for (int round = 0; (int)orderedAgents.size() < (int)m_agents.size(); round++)
+	{
+		for (int colonyOffset = 0; colonyOffset < numColonies; colonyOffset++)
+		{
+			const std::vector<int>& colonyAgents = agentsPerColony[(m_turnNumber + colonyOffset) % numColonies];
+			if (round < (int)colonyAgents.size())
+			{
+				orderedAgents.push_back(colonyAgents[round]);
+			}
+		}
+	}
+
+	return orderedAgents;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int ArenaMatch::GetNumColoniesAlive() const
+{
+	int numAlive = 0;
+	for (int colonyIndex = 0; colonyIndex < (int)m_colonies.size(); colonyIndex++)
+	{
+		if (m_colonies[colonyIndex].isAlive)
+		{
+			numAlive++;
+		}
+	}
+
+	return numAlive;
+}
@@ -0,0 +1,145 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ArenaDefinitions.hpp"
+#include "ArenaMap.hpp"
+#include "ArenaPlayer.hpp"
+#include "SimulatorCommons.hpp"
+#include "RandomNumberGenerator.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct MatchSettings_T
+{
+	std::string		dataFolder = "Arena/Run_Windows/Data";
+	std::string		mapName = "Final";
+	std::string		matchName = "Final";
+	unsigned int	seed = 1;
+	int				mapSizeOverride = 0;		//0 keeps the match's or else the map's size
+
+	std::vector<std::string>	playerLibraries;	//One per colony, the same library may be listed more than once
+	int				threadsPerPlayer = SIMULATOR_DEFAULT_THREADS_PER_PLAYER;
+	double			maxTurnSeconds = 0.0;		//0 uses the match's minTurnTime
+	int				maxTurns = SIMULATOR_DEFAULT_MAX_TURNS;
+	bool			fogOfWar = true;
+	bool			logPlayerText = false;
+	int				progressInterval = SIMULATOR_PROGRESS_INTERVAL;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct ArenaAgent_T
+{
+	AgentID				agentID = 0;
+	int					colonyIndex = 0;
+	eAgentType			type = AGENT_TYPE_WORKER;
+	eAgentState			state = STATE_NORMAL;
+	short				tileX = 0;
+	short				tileY = 0;
+	short				exhaustion = 0;
+	short				receivedCombatDamage = 0;
+	short				receivedSuffocationDamage = 0;
+
+	eOrderCode			order = ORDER_HOLD;			//This turn's, HOLD unless the player ordered something valid
+	eAgentOrderResult	result = AGENT_ORDER_SUCCESS_HELD;
+	bool				isOrdered = false;
+	bool				isDead = false;
+	bool				wasExhausted = false;		//Exhaustion only wears off for agents that started the turn with some
+	bool				hasAttacked = false;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct ArenaColony_T
+{
+	ArenaPlayer*		player = nullptr;
+	PlayerID			playerID = 0;
+	TeamID				teamID = 0;
+	int					nutrients = 0;
+	int					nextAgentSerial = 0;
+	bool				isAlive = true;
+	int					turnEliminated = -1;
+
+	int					numFaults = 0;
+	int					faultsByType[FAULT_INVALID_AGENT_ID + 1] = {};
+	int					nutrientsLostDueToFault = 0;			//This turn's, reported with the next turn state
+	int					nutrientsLostDueToQueenDamage = 0;
+	int					nutrientsLostDueToQueenSuffocation = 0;
+	int					numSuicides = 0;
+
+	std::vector<AgentReport>					deathReports;		//Agents that died this turn, reported once
+	std::unique_ptr<ArenaTurnStateForPlayer>	turnState;
+	std::unique_ptr<PlayerTurnOrders>			turnOrders;
+
+	int					foodEaten = 0;
+	int					agentsBorn = 0;
+	int					agentsLost = 0;
+	int					enemiesKilled = 0;
+	int					peakPopulation = 0;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Plays one match between loaded players, with the rules of the arena as laid out in its README and Data files.
+// Nothing is paced to minTurnTime, a turn is resolved as soon as every player has handed over its orders or run out of
+// StartupInfo::maxTurnSeconds, which is minTurnTime unless -maxTurnSeconds says otherwise
+//------------------------------------------------------------------------------------------------------------------------------
+class ArenaMatch
+{
+public:
+	bool				Init(const MatchSettings_T& settings, std::string& outError);
+	void				Run();
+	void				PrintResults() const;
+
+private:
+	void				StartPlayers();
+	void				StopPlayers();
+
+	void				BuildTurnState(int colonyIndex);
+	void				MarkVisibleTiles(int colonyIndex, std::vector<unsigned char>& outVisible) const;
+
+	void				ResolveTurn();
+	void				ReadOrders(int colonyIndex);
+	void				AddFault(int colonyIndex, eFaultType fault);
+	void				ResolveActions(const std::vector<int>& orderedAgents);
+	void				ResolveMoves(const std::vector<int>& orderedAgents);
+	void				ResolveQueensEating();
+	void				ResolveCombat();
+	void				ResolveUpkeep();
+	void				RemoveDeadAgents();
+
+	void				Birth(int queenIndex, eAgentType childType);
+	void				Dig(ArenaAgent_T& agent);
+	void				PickUpFood(ArenaAgent_T& agent);
+	void				PickUpTile(ArenaAgent_T& agent);
+	void				Drop(ArenaAgent_T& agent);
+	void				SuffocateAgentsOnTile(int tileIndex, const ArenaAgent_T& dropper);
+
+	int					AddAgent(int colonyIndex, eAgentType type, int tileX, int tileY);
+	void				KillAgent(ArenaAgent_T& agent, eAgentOrderResult cause);
+	int					PickSacrifice(int colonyIndex) const;		//-1 when the colony has no agents left
+	int					GetPopulation(int colonyIndex) const;
+	bool				HasQueenOnTile(int tileIndex, int colonyIndex, const ArenaAgent_T* except) const;
+	bool				IsQueenNear(int colonyIndex, int tileX, int tileY, int distance) const;
+	int					GetCombatStrength(const ArenaAgent_T& agent) const;
+	const AgentTypeInfo&	GetTypeInfo(const ArenaAgent_T& agent) const { return m_startupInfo.matchInfo.agentTypeInfos[agent.type]; }
+
+	std::vector<int>	GetAgentsInTurnOrder() const;
+	int					GetNumColoniesAlive() const;
+
+private:
+	MatchSettings_T					m_settings;
+	MatchDefinition_T				m_matchDefinition;
+	MapDefinition_T					m_mapDefinition;
+	StartupInfo						m_startupInfo;
+
+	RandomNumberGenerator			m_rng;
+	ArenaMap						m_map;
+	int								m_turnNumber = 0;
+
+	std::vector<std::unique_ptr<ArenaPlayer>>	m_players;
+	std::vector<ArenaColony_T>					m_colonies;
+
+	std::vector<ArenaAgent_T>					m_agents;			//In the order they were born
+	std::unordered_map<AgentID, int>			m_agentIndices;
+
+	double							m_matchSeconds = 0.0;
+};
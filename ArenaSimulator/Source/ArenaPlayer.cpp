@@ -0,0 +1,244 @@
+#include "ArenaPlayer.hpp"
+#include "SimulatorCommons.hpp"
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <dlfcn.h>
+#include <filesystem>
+
+static bool s_logPlayerText = false;
+
+//------------------------------------------------------------------------------------------------------------------------------
+// The arena's debug draw and log calls, there is nothing to draw on so only the log can be turned on
+//------------------------------------------------------------------------------------------------------------------------------
+static void StubRequestPause()
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void StubLogText(char const* format, ...)
+{
+	if (!s_logPlayerText)
+		return;
+
+	va_list variableArgumentList;
+	va_start(variableArgumentList, format);
+	vprintf(format, variableArgumentList);
+	va_end(variableArgumentList);
+	printf("\n");
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void StubSetMoodText(char const* format, ...)
+{
+	UNUSED(format);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void StubDrawWorldText(float posX, float posY, float anchorU, float anchorV, float height, Color8 color, char const* format, ...)
+{
+	UNUSED(posX); UNUSED(posY); UNUSED(anchorU); UNUSED(anchorV); UNUSED(height); UNUSED(color); UNUSED(format);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void StubDrawVertexArray(int count, const VertexPC* vertices)
+{
+	UNUSED(count); UNUSED(vertices);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void StubFlushQueuedDraws()
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void StubRegisterEvent(const char* eventName, EventFunc func)
+{
+	UNUSED(eventName); UNUSED(func);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+ArenaPlayer::~ArenaPlayer()
+{
+	Unload();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool ArenaPlayer::Load(const std::string& libraryPath, int instanceIndex, std::string& outError)
+{
+	m_loadedPath = libraryPath;
+	m_isCopy = false;
+
+	if (instanceIndex > 0)
+	{
+		std::filesystem::path sourcePath(libraryPath);
+		std::filesystem::path copyPath = std::filesystem::temp_directory_path() / (sourcePath.stem().string() + "_instance" + std::to_string(instanceIndex) + sourcePath.extension().string());
+
+		std::error_code error;
+		std::filesystem::copy_file(sourcePath, copyPath, std::filesystem::copy_options::overwrite_existing, error);
+		if (error)
+		{
+			outError = "could not copy " + libraryPath + " to " + copyPath.string() + ": " + error.message();
+			return false;
+		}
+
+		m_loadedPath = copyPath.string();
+		m_isCopy = true;
+	}
+
+	//A path without a slash would be searched for on the library path instead of opened
+	std::string openPath = m_loadedPath.find('/') == std::string::npos ? "./" + m_loadedPath : m_loadedPath;
+	m_library = dlopen(openPath.c_str(), RTLD_NOW | RTLD_LOCAL);
+	if (m_library == nullptr)
+	{
+		outError = dlerror();
+		return false;
+	}
+
+	GiveCommandInterfaceVersionFunc giveVersion = (GiveCommandInterfaceVersionFunc)dlsym(m_library, "GiveCommonInterfaceVersion");
+	GivePlayerNameFunc givePlayerName = (GivePlayerNameFunc)dlsym(m_library, "GivePlayerName");
+	GiveAuthorNameFunc giveAuthorName = (GiveAuthorNameFunc)dlsym(m_library, "GiveAuthorName");
+
+	m_preGameStartup = (PreGameStartupFunc)dlsym(m_library, "PreGameStartup");
+	m_postGameShutdown = (PostGameShutdownFunc)dlsym(m_library, "PostGameShutdown");
+	m_playerThreadEntry = (PlayerThreadEntryFunc)dlsym(m_library, "PlayerThreadEntry");
+	m_receiveTurnState = (ReceiveTurnStateFunc)dlsym(m_library, "ReceiveTurnState");
+	m_turnOrderRequest = (TurnOrderRequestFunc)dlsym(m_library, "TurnOrderRequest");
+
+	if (giveVersion == nullptr || givePlayerName == nullptr || giveAuthorName == nullptr || m_preGameStartup == nullptr
+		|| m_postGameShutdown == nullptr || m_playerThreadEntry == nullptr || m_receiveTurnState == nullptr || m_turnOrderRequest == nullptr)
+	{
+		outError = libraryPath + " does not export the whole player interface";
+		Unload();
+		return false;
+	}
+
+	if (giveVersion() != COMMON_INTERFACE_VERSION_NUMBER)
+	{
+		outError = libraryPath + " was built against interface version " + std::to_string(giveVersion()) + ", the arena is on " + std::to_string(COMMON_INTERFACE_VERSION_NUMBER);
+		Unload();
+		return false;
+	}
+
+	m_name = givePlayerName();
+	m_author = giveAuthorName();
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaPlayer::Unload()
+{
+	if (m_library != nullptr)
+	{
+		dlclose(m_library);
+		m_library = nullptr;
+	}
+
+	if (m_isCopy)
+	{
+		std::error_code error;
+		std::filesystem::remove(m_loadedPath, error);
+		m_isCopy = false;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaPlayer::Startup(const StartupInfo& info)
+{
+	m_preGameStartup(info);
+
+	for (int threadIdx = 0; threadIdx < info.expectedThreadCount; threadIdx++)
+	{
+		m_threads.emplace_back(m_playerThreadEntry, threadIdx);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// PostGameShutdown is what tells the player's threads to return, so they are only joined after it
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaPlayer::Shutdown()
+{
+	MatchResults results;
+	m_postGameShutdown(results);
+
+	for (int threadIndex = 0; threadIndex < (int)m_threads.size(); threadIndex++)
+	{
+		m_threads[threadIndex].join();
+	}
+
+	m_threads.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ArenaPlayer::SendTurnState(const ArenaTurnStateForPlayer& state)
+{
+	m_turnStartSeconds = GetCurrentTimeSeconds();
+	m_receiveTurnState(state);
+	m_lastResponseSeconds = GetCurrentTimeSeconds() - m_turnStartSeconds;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// The arena spins on TurnOrderRequest until the player has its orders. Yielding between calls leaves the core to the
+// player's own threads, the arena has nothing else to do in the meantime
+// The turn runs out maxTurnSeconds after its state was sent. Orders that aren't in by then are dropped, the player's
+// agents hold for the turn
+//------------------------------------------------------------------------------------------------------------------------------
+bool ArenaPlayer::RequestTurnOrders(int turnNumber, PlayerTurnOrders* ordersToFill, double maxTurnSeconds)
+{
+	double requestStartSeconds = GetCurrentTimeSeconds();
+	double deadlineSeconds = m_turnStartSeconds + maxTurnSeconds;
+
+	ordersToFill->numberOfOrders = 0;
+	while (!m_turnOrderRequest(turnNumber, ordersToFill))
+	{
+		if (GetCurrentTimeSeconds() >= deadlineSeconds)
+			break;
+
+		std::this_thread::yield();
+	}
+
+	double answeredSeconds = GetCurrentTimeSeconds();
+	bool isOnTime = answeredSeconds < deadlineSeconds;
+	if (!isOnTime)
+	{
+		ordersToFill->numberOfOrders = 0;
+		m_numTurnsLate++;
+	}
+
+	m_lastResponseSeconds += answeredSeconds - requestStartSeconds;
+	m_totalResponseSeconds += m_lastResponseSeconds;
+	m_numTurnsResponded++;
+
+	if (m_lastResponseSeconds > m_maxResponseSeconds)
+	{
+		m_maxResponseSeconds = m_lastResponseSeconds;
+	}
+
+	return isOnTime;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC DebugInterface* ArenaPlayer::GetStubDebugInterface()
+{
+	static DebugInterface debugInterface = { StubRequestPause, StubLogText, StubSetMoodText, StubDrawWorldText, StubDrawVertexArray, StubFlushQueuedDraws };
+	return &debugInterface;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC RegisterEventFunc ArenaPlayer::GetStubRegisterEvent()
+{
+	return StubRegisterEvent;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC void ArenaPlayer::SetLogPlayerText(bool logPlayerText)
+{
+	s_logPlayerText = logPlayerText;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+double GetCurrentTimeSeconds()
+{
+	using namespace std::chrono;
+	return duration_cast<duration<double>>(steady_clock::now().time_since_epoch()).count();
+}
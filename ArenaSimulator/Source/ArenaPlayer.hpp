@@ -0,0 +1,58 @@
+#pragma once
+#include <string>
+#include <thread>
+#include <vector>
+#include "ArenaDefinitions.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+// One player shared object and the threads the arena gives it. dlopen only loads a library once per file, so every
+// instance after the first is loaded from its own copy and gets its own globals
+//------------------------------------------------------------------------------------------------------------------------------
+class ArenaPlayer
+{
+public:
+	~ArenaPlayer();
+
+	bool				Load(const std::string& libraryPath, int instanceIndex, std::string& outError);
+	void				Unload();
+
+	void				Startup(const StartupInfo& info);
+	void				Shutdown();
+
+	void				SendTurnState(const ArenaTurnStateForPlayer& state);
+	bool				RequestTurnOrders(int turnNumber, PlayerTurnOrders* ordersToFill, double maxTurnSeconds);	//False, with no orders, if the turn ran out
+
+	const std::string&	GetName() const { return m_name; }
+	const std::string&	GetAuthor() const { return m_author; }
+
+	static DebugInterface*		GetStubDebugInterface();
+	static RegisterEventFunc	GetStubRegisterEvent();
+	static void					SetLogPlayerText(bool logPlayerText);
+
+public:
+	double				m_lastResponseSeconds = 0.0;		//ReceiveTurnState plus every TurnOrderRequest call of the last turn
+	double				m_maxResponseSeconds = 0.0;
+	double				m_totalResponseSeconds = 0.0;
+	int					m_numTurnsResponded = 0;
+	int					m_numTurnsLate = 0;
+
+private:
+	void*						m_library = nullptr;
+	std::string					m_loadedPath;
+	bool						m_isCopy = false;
+
+	std::string					m_name;
+	std::string					m_author;
+
+	PreGameStartupFunc			m_preGameStartup = nullptr;
+	PostGameShutdownFunc		m_postGameShutdown = nullptr;
+	PlayerThreadEntryFunc		m_playerThreadEntry = nullptr;
+	ReceiveTurnStateFunc		m_receiveTurnState = nullptr;
+	TurnOrderRequestFunc		m_turnOrderRequest = nullptr;
+
+	std::vector<std::thread>	m_threads;
+	double						m_turnStartSeconds = 0.0;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+double		GetCurrentTimeSeconds();
@@ -0,0 +1,114 @@
+//------------------------------------------------------------------------------------------------------------------------------
+// Headless stand-in for AntArena2_x64.exe, so player code can be benchmarked and regression tested on Linux. It loads the
+// same Data files, generates seeded maps and plays a match as fast as the players answer, calling the player through
+// the same ArenaPlayerInterface.hpp functions the arena does
+//
+// Build, from the repository root:
+//	g++ -std=c++17 -O2 -fPIC -fvisibility=hidden -shared -pthread AICombatArena/Source/*.cpp -o libCombatAnt.so
+//	g++ -std=c++17 -O2 -pthread -IAICombatArena/Source ArenaSimulator/Source/*.cpp AICombatArena/Source/RandomNumberGenerator.cpp
+//		AICombatArena/Source/MathUtils.cpp AICombatArena/Source/Vec2.cpp AICombatArena/Source/IntVec2.cpp -ldl -o ArenaSimulator
+//
+// Run, also from the repository root:
+//	./ArenaSimulator ./libCombatAnt.so -seed 7 -map "Final" -match "Final"
+//------------------------------------------------------------------------------------------------------------------------------
+#include "ArenaMatch.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void PrintUsage(const char* programName)
+{
+	printf("Usage: %s <player.so> [<player.so> ...] [options]\n", programName);
+	printf("  -players <n>          Colonies to fill from a single listed library (default %d)\n", SIMULATOR_DEFAULT_NUM_PLAYERS);
+	printf("  -map <name>           MapDefinition to play on (default \"Final\")\n");
+	printf("  -match <name>         MatchDefinition to play (default \"Final\")\n");
+	printf("  -seed <n>             Map and food seed (default 1)\n");
+	printf("  -size <n>             Map width, overriding the map and match\n");
+	printf("  -turns <n>            Turn limit (default %d)\n", SIMULATOR_DEFAULT_MAX_TURNS);
+	printf("  -threads <n>          PlayerThreadEntry threads per player (default %d)\n", SIMULATOR_DEFAULT_THREADS_PER_PLAYER);
+	printf("  -maxTurnSeconds <s>   Turn time limit, later orders are dropped (default minTurnTime)\n");
+	printf("  -data <folder>        Folder holding the Data XMLs (default Arena/Run_Windows/Data)\n");
+	printf("  -progress <n>         Turns between progress lines, 0 for none (default %d)\n", SIMULATOR_PROGRESS_INTERVAL);
+	printf("  -nofog                Every player sees the whole map\n");
+	printf("  -log                  Print the players' LogText calls\n");
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+	MatchSettings_T settings;
+	int numPlayers = 0;
+
+	for (int argIndex = 1; argIndex < argc; argIndex++)
+	{
+		const char* arg = argv[argIndex];
+		const char* value = argIndex + 1 < argc ? argv[argIndex + 1] : nullptr;
+
+		if (arg[0] != '-')
+		{
+			settings.playerLibraries.push_back(arg);
+			continue;
+		}
+
+		if (strcmp(arg, "-nofog") == 0)
+		{
+			settings.fogOfWar = false;
+			continue;
+		}
+
+		if (strcmp(arg, "-log") == 0)
+		{
+			settings.logPlayerText = true;
+			continue;
+		}
+
+		if (value == nullptr)
+		{
+			PrintUsage(argv[0]);
+			return 1;
+		}
+
+		argIndex++;
+		if (strcmp(arg, "-players") == 0)				numPlayers = atoi(value);
+		else if (strcmp(arg, "-map") == 0)				settings.mapName = value;
+		else if (strcmp(arg, "-match") == 0)			settings.matchName = value;
+		else if (strcmp(arg, "-seed") == 0)				settings.seed = (unsigned int)strtoul(value, nullptr, 10);
+		else if (strcmp(arg, "-size") == 0)				settings.mapSizeOverride = atoi(value);
+		else if (strcmp(arg, "-turns") == 0)			settings.maxTurns = atoi(value);
+		else if (strcmp(arg, "-threads") == 0)			settings.threadsPerPlayer = atoi(value);
+		else if (strcmp(arg, "-maxTurnSeconds") == 0)	settings.maxTurnSeconds = atof(value);
+		else if (strcmp(arg, "-data") == 0)				settings.dataFolder = value;
+		else if (strcmp(arg, "-progress") == 0)			settings.progressInterval = atoi(value);
+		else
+		{
+			PrintUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (settings.playerLibraries.empty())
+	{
+		PrintUsage(argv[0]);
+		return 1;
+	}
+
+	//A single library plays against copies of itself
+	if (settings.playerLibraries.size() == 1)
+	{
+		int numCopies = numPlayers > 0 ? numPlayers : SIMULATOR_DEFAULT_NUM_PLAYERS;
+		settings.playerLibraries.resize(numCopies, settings.playerLibraries[0]);
+	}
+
+	ArenaMatch match;
+	std::string error;
+	if (!match.Init(settings, error))
+	{
+		fprintf(stderr, "ArenaSimulator: %s\n", error.c_str());
+		return 1;
+	}
+
+	match.Run();
+	match.PrintResults();
+	return 0;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Useful macros when developing
+#define UNUSED(x) (void)(x);
+#define STATIC
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Defaults for the headless arena, each can be overridden from the command line
+constexpr int SIMULATOR_DEFAULT_MAX_TURNS = 2000;			//A match with colonies still standing is called after this many turns
+constexpr int SIMULATOR_DEFAULT_THREADS_PER_PLAYER = 2;		//PlayerThreadEntry calls per player, like the real arena
+constexpr int SIMULATOR_DEFAULT_NUM_PLAYERS = 2;			//A single player library is loaded this many times
+
+constexpr int SIMULATOR_FIRST_PLAYER_ID = 100;
+constexpr int SIMULATOR_FIRST_TEAM_ID = 200;
+
+constexpr float COLONY_START_RADIUS_FRACTION = 0.35f;		//Colonies start on a circle this far out from the map's centre
+constexpr int COLONY_START_CLEAR_RADIUS = 1;				//Tiles around a colony start that are always air
+
+constexpr int FREE_FAULT_COUNT = 0;
+constexpr int SIMULATOR_PROGRESS_INTERVAL = 250;			//Turns between progress lines, 0 to only print the results
\ No newline at end of file
@@ -0,0 +1,330 @@
+#include "XmlReader.hpp"
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Recursive descent over the text, m_position always sits on the next character to read
+//------------------------------------------------------------------------------------------------------------------------------
+class XmlParser
+{
+public:
+	explicit XmlParser(const std::string& text)
+		: m_text(text)
+	{
+	}
+
+	bool				ParseDocument(XmlElement_T& outRoot);
+	const std::string&	GetError() const { return m_error; }
+
+private:
+	bool				ParseElement(XmlElement_T& outElement);
+	bool				ParseAttribute(XmlElement_T& element);
+	bool				SkipMisc();						//Whitespace, comments and <? ?> / <! > declarations
+	void				SkipWhitespace();
+	std::string			ReadName();
+	bool				Fail(const char* reason);
+
+	bool				IsAt(const char* token) const;
+	bool				IsAtEnd() const { return m_position >= m_text.size(); }
+
+private:
+	const std::string&	m_text;
+	size_t				m_position = 0;
+	std::string			m_error;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool XmlParser::ParseDocument(XmlElement_T& outRoot)
+{
+	if (!SkipMisc())
+		return false;
+
+	if (IsAtEnd() || m_text[m_position] != '<')
+		return Fail("expected a root element");
+
+	if (!ParseElement(outRoot))
+		return false;
+
+	return SkipMisc();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool XmlParser::ParseElement(XmlElement_T& outElement)
+{
+	m_position++;	//'<'
+	outElement.name = ReadName();
+	if (outElement.name.empty())
+		return Fail("expected an element name");
+
+	for (;;)
+	{
+		SkipWhitespace();
+		if (IsAtEnd())
+			return Fail("unterminated element");
+
+		if (IsAt("/>"))
+		{
+			m_position += 2;
+			return true;
+		}
+
+		if (m_text[m_position] == '>')
+		{
+			m_position++;
+			break;
+		}
+
+		if (!ParseAttribute(outElement))
+			return false;
+	}
+
+	//Children until the matching end tag, text in between is skipped
+	for (;;)
+	{
+		while (!IsAtEnd() && m_text[m_position] != '<')
+		{
+			m_position++;
+		}
+
+		if (IsAtEnd())
+			return Fail("missing end tag");
+
+		if (IsAt("</"))
+		{
+			m_position += 2;
+			std::string endName = ReadName();
+			if (endName != outElement.name)
+				return Fail("mismatched end tag");
+
+			SkipWhitespace();
+			if (IsAtEnd() || m_text[m_position] != '>')
+				return Fail("unterminated end tag");
+
+			m_position++;
+			return true;
+		}
+
+		if (IsAt("<!") || IsAt("<?"))
+		{
+			if (!SkipMisc())
+				return false;
+
+			continue;
+		}
+
+		outElement.children.emplace_back();
+		if (!ParseElement(outElement.children.back()))
+			return false;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool XmlParser::ParseAttribute(XmlElement_T& element)
+{
+	XmlAttribute_T attribute;
+	attribute.name = ReadName();
+	if (attribute.name.empty())
+		return Fail("expected an attribute name");
+
+	SkipWhitespace();
+	if (IsAtEnd() || m_text[m_position] != '=')
+		return Fail("expected '=' after an attribute name");
+
+	m_position++;
+	SkipWhitespace();
+	if (IsAtEnd() || (m_text[m_position] != '"' && m_text[m_position] != '\''))
+		return Fail("expected a quoted attribute value");
+
+	char quote = m_text[m_position++];
+	size_t valueEnd = m_text.find(quote, m_position);
+	if (valueEnd == std::string::npos)
+		return Fail("unterminated attribute value");
+
+	attribute.value = m_text.substr(m_position, valueEnd - m_position);
+	m_position = valueEnd + 1;
+
+	element.attributes.push_back(attribute);
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool XmlParser::SkipMisc()
+{
+	for (;;)
+	{
+		SkipWhitespace();
+
+		const char* terminator = nullptr;
+		if (IsAt("<!--"))
+		{
+			terminator = "-->";
+		}
+		else if (IsAt("<?"))
+		{
+			terminator = "?>";
+		}
+		else if (IsAt("<!"))
+		{
+			terminator = ">";
+		}
+		else
+		{
+			return true;
+		}
+
+		size_t end = m_text.find(terminator, m_position + 2);
+		if (end == std::string::npos)
+			return Fail("unterminated comment or declaration");
+
+		m_position = end + strlen(terminator);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void XmlParser::SkipWhitespace()
+{
+	while (!IsAtEnd() && isspace((unsigned char)m_text[m_position]))
+	{
+		m_position++;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+std::string XmlParser::ReadName()
+{
+	size_t start = m_position;
+	while (!IsAtEnd())
+	{
+		char character = m_text[m_position];
+		if (!isalnum((unsigned char)character) && character != '_' && character != '-' && character != ':' && character != '.')
+			break;
+
+		m_position++;
+	}
+
+	return m_text.substr(start, m_position - start);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool XmlParser::Fail(const char* reason)
+{
+	int lineNumber = 1;
+	for (size_t charIndex = 0; charIndex < m_position && charIndex < m_text.size(); charIndex++)
+	{
+		if (m_text[charIndex] == '\n')
+		{
+			lineNumber++;
+		}
+	}
+
+	m_error = std::string(reason) + " on line " + std::to_string(lineNumber);
+	return false;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool XmlParser::IsAt(const char* token) const
+{
+	return m_text.compare(m_position, strlen(token), token) == 0;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const char* XmlElement_T::FindAttribute(const char* attributeName) const
+{
+	for (int attributeIndex = 0; attributeIndex < (int)attributes.size(); attributeIndex++)
+	{
+		if (attributes[attributeIndex].name == attributeName)
+			return attributes[attributeIndex].value.c_str();
+	}
+
+	return nullptr;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+const XmlElement_T* XmlElement_T::FindChild(const char* childName) const
+{
+	for (int childIndex = 0; childIndex < (int)children.size(); childIndex++)
+	{
+		if (children[childIndex].name == childName)
+			return &children[childIndex];
+	}
+
+	return nullptr;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool LoadXmlFile(const std::string& filePath, XmlElement_T& outRoot, std::string& outError)
+{
+	std::ifstream file(filePath, std::ios::binary);
+	if (!file)
+	{
+		outError = "could not open " + filePath;
+		return false;
+	}
+
+	std::stringstream text;
+	text << file.rdbuf();
+
+	if (!ParseXmlText(text.str(), outRoot, outError))
+	{
+		outError = filePath + ": " + outError;
+		return false;
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool ParseXmlText(const std::string& text, XmlElement_T& outRoot, std::string& outError)
+{
+	XmlParser parser(text);
+	outRoot = XmlElement_T();
+
+	if (!parser.ParseDocument(outRoot))
+	{
+		outError = parser.GetError();
+		return false;
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+std::string GetXmlAttribute(const XmlElement_T& element, const char* attributeName, const std::string& defaultValue)
+{
+	const char* value = element.FindAttribute(attributeName);
+	return value != nullptr ? std::string(value) : defaultValue;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int GetXmlAttribute(const XmlElement_T& element, const char* attributeName, int defaultValue)
+{
+	const char* value = element.FindAttribute(attributeName);
+	return value != nullptr ? atoi(value) : defaultValue;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+float GetXmlAttribute(const XmlElement_T& element, const char* attributeName, float defaultValue)
+{
+	const char* value = element.FindAttribute(attributeName);
+	return value != nullptr ? (float)atof(value) : defaultValue;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+double GetXmlAttribute(const XmlElement_T& element, const char* attributeName, double defaultValue)
+{
+	const char* value = element.FindAttribute(attributeName);
+	return value != nullptr ? atof(value) : defaultValue;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool GetXmlAttribute(const XmlElement_T& element, const char* attributeName, bool defaultValue)
+{
+	const char* value = element.FindAttribute(attributeName);
+	if (value == nullptr)
+		return defaultValue;
+
+	return strcmp(value, "true") == 0 || strcmp(value, "1") == 0;
+}
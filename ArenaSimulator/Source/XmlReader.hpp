@@ -0,0 +1,35 @@
+#pragma once
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Just enough XML for the Arena's Data files: elements, attributes, comments and the <?xml ?> prolog. Text content and
+// entities are skipped
+//------------------------------------------------------------------------------------------------------------------------------
+struct XmlAttribute_T
+{
+	std::string		name;
+	std::string		value;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct XmlElement_T
+{
+	std::string						name;
+	std::vector<XmlAttribute_T>		attributes;
+	std::vector<XmlElement_T>		children;
+
+	const char*				FindAttribute(const char* attributeName) const;		//nullptr when it isn't set
+	const XmlElement_T*		FindChild(const char* childName) const;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool			LoadXmlFile(const std::string& filePath, XmlElement_T& outRoot, std::string& outError);
+bool			ParseXmlText(const std::string& text, XmlElement_T& outRoot, std::string& outError);
+
+//------------------------------------------------------------------------------------------------------------------------------
+std::string		GetXmlAttribute(const XmlElement_T& element, const char* attributeName, const std::string& defaultValue);
+int				GetXmlAttribute(const XmlElement_T& element, const char* attributeName, int defaultValue);
+float			GetXmlAttribute(const XmlElement_T& element, const char* attributeName, float defaultValue);
+double			GetXmlAttribute(const XmlElement_T& element, const char* attributeName, double defaultValue);
+bool			GetXmlAttribute(const XmlElement_T& element, const char* attributeName, bool defaultValue);
@@ -0,0 +1,130 @@
+#include "AgentStoreBenchmark.hpp"
+#include "AgentRegistry.hpp"
+#include "AgentStore.hpp"
+#include "RandomNumberGenerator.hpp"
+#include "TurnScheduler.hpp"
+#include "BenchmarkCommons.hpp"
+#include <algorithm>
+#include <cstdio>
+
+//------------------------------------------------------------------------------------------------------------------------------
+// The registry order is the arrival order, so the types are mixed the way they are after a few turns of spawning
+//------------------------------------------------------------------------------------------------------------------------------
+static void FillRegistry(int numAgents, unsigned int seed, AgentRegistry& registry)
+{
+	RandomNumberGenerator rng(seed);
+	registry.Init(numAgents);
+
+	for (int agentIndex = 0; agentIndex < numAgents; agentIndex++)
+	{
+		AgentReport report = {};
+		report.agentID = (AgentID)(agentIndex + 1);
+		report.tileX = (short)rng.GetRandomIntLessThan(128);
+		report.tileY = (short)rng.GetRandomIntLessThan(128);
+		report.exhaustion = rng.GetRandomFloatZeroToOne() < 0.5f ? 0 : (short)rng.GetRandomIntInRange(1, 3);
+		report.type = (eAgentType)rng.GetRandomIntLessThan(NUM_AGENT_TYPES);
+		report.state = rng.GetRandomFloatZeroToOne() < 0.05f ? STATE_DEAD : STATE_NORMAL;
+		report.result = AGENT_WAS_CREATED;
+
+		registry.Add(report);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// The readiness rule GatherReadyAgents applies, as it was written against the full Agent
+//------------------------------------------------------------------------------------------------------------------------------
+static int FilterReadyAgents(const std::vector<Agent>& agents, eAgentType type, bool isSuddenDeath, std::vector<int>& outIndices)
+{
+	int numReady = 0;
+	for (int agentIndex = 0; agentIndex < (int)agents.size(); agentIndex++)
+	{
+		const Agent& agent = agents[agentIndex];
+		if (agent.type != type || agent.state == STATE_DEAD)
+			continue;
+
+		if (isSuddenDeath || agent.exhaustion == 0)
+		{
+			outIndices.push_back(agentIndex);
+			numReady++;
+		}
+	}
+
+	return numReady;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Median nanoseconds of one pass. Passes are timed in batches so the clock read doesn't swamp a few hundred nanoseconds
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename PassFunction>
+static double TimePass(PassFunction pass, unsigned long long& checksum)
+{
+	std::vector<double> batchNanoseconds(BENCHMARK_AGENT_STORE_BATCHES);
+
+	for (int batchIndex = 0; batchIndex < BENCHMARK_AGENT_STORE_BATCHES; batchIndex++)
+	{
+		double startSeconds = TurnScheduler::GetCurrentTimeSeconds();
+		for (int passIndex = 0; passIndex < BENCHMARK_AGENT_STORE_PASSES_PER_BATCH; passIndex++)
+		{
+			checksum += (unsigned long long)pass();
+		}
+		double batchSeconds = TurnScheduler::GetCurrentTimeSeconds() - startSeconds;
+
+		batchNanoseconds[batchIndex] = batchSeconds * 1e9 / (double)BENCHMARK_AGENT_STORE_PASSES_PER_BATCH;
+	}
+
+	std::sort(batchNanoseconds.begin(), batchNanoseconds.end());
+	return batchNanoseconds[BENCHMARK_AGENT_STORE_BATCHES / 2];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void RunAgentStoreBenchmark(int numAgents, unsigned int seed)
+{
+	AgentRegistry registry;
+	FillRegistry(numAgents, seed, registry);
+
+	std::vector<Agent> agents;
+	agents.reserve(numAgents);
+	for (int agentIndex = 0; agentIndex < registry.GetNumAgents(); agentIndex++)
+	{
+		agents.push_back(registry.GetAgent(agentIndex));
+	}
+
+	AgentStore store;
+	store.Init(numAgents);
+	store.Build(registry);
+
+	std::vector<int> readyIndices;
+	readyIndices.reserve(numAgents);
+	unsigned long long checksum = 0;
+
+	double filterNanoseconds = TimePass([&]()
+	{
+		readyIndices.clear();
+		return FilterReadyAgents(agents, AGENT_TYPE_WORKER, false, readyIndices);
+	}, checksum);
+
+	double gatherNanoseconds = TimePass([&]()
+	{
+		readyIndices.clear();
+		return store.GatherReadyAgents(AGENT_TYPE_WORKER, false, readyIndices);
+	}, checksum);
+
+	double buildNanoseconds = TimePass([&]()
+	{
+		store.Build(registry);
+		readyIndices.clear();
+
+		int numReady = 0;
+		for (int typeIndex = 0; typeIndex < NUM_AGENT_TYPES; typeIndex++)
+		{
+			numReady += store.GatherReadyAgents((eAgentType)typeIndex, false, readyIndices);
+		}
+		return numReady;
+	}, checksum);
+
+	printf("%d agents, %d workers, seed %u\n", numAgents, store.GetNumAgentsOfType(AGENT_TYPE_WORKER), seed);
+	printf("%-40s %10.1f ns\n", "vector<Agent> ready worker filter", filterNanoseconds);
+	printf("%-40s %10.1f ns\n", "AgentStore::GatherReadyAgents worker", gatherNanoseconds);
+	printf("%-40s %10.1f ns\n", "AgentStore::Build + gather every type", buildNanoseconds);
+	printf("(checksum %llu)\n", checksum);
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Times the per-turn agent passes the player runs: filtering a std::vector<Agent> for its ready workers, the way the
+// queen pass and the chunks did before the AgentStore, against AgentStore::GatherReadyAgents, and the store's Build
+// plus a gather of every type, which is what a turn actually pays. Prints one line per pass
+//------------------------------------------------------------------------------------------------------------------------------
+void			RunAgentStoreBenchmark(int numAgents, unsigned int seed);
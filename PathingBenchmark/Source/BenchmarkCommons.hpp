@@ -0,0 +1,31 @@
+#pragma once
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Useful macros when developing
+#define UNUSED(x) (void)(x);
+#define STATIC
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Defaults for the pathing benchmark, each can be overridden from the command line
+constexpr int BENCHMARK_DEFAULT_QUERIES = 2000;				//Start/goal pairs per map, agent type and pather
+constexpr unsigned int BENCHMARK_DEFAULT_SEED = 1;			//Seeds the terrain noise and the query picks, so runs compare
+constexpr int BENCHMARK_WARMUP_QUERIES = 32;				//Untimed queries run first, so lazily sized buffers count as held memory
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Terrain noise. A TileInfo's strands become the tiles closest to the zero crossings of a Perlin field, which wind like
+// the arena's random walk strands. The field's scale spaces them out by strandsPer100Tiles
+constexpr float BENCHMARK_STRAND_SPACING = 10.f;			//Noise scale, in tiles, of a map with one strand per 100 tiles
+constexpr unsigned int BENCHMARK_STRAND_OCTAVES = 2;
+constexpr float BENCHMARK_STRAND_PERSISTENCE = 0.5f;
+
+constexpr const char* BENCHMARK_DEFAULT_MAPS = "Default,Final,Fertile Fields,Big Blue";
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Agent store benchmark, run with -agents in place of the pathers
+constexpr int BENCHMARK_AGENT_STORE_BATCHES = 201;				//Batches timed, the median is reported
+constexpr int BENCHMARK_AGENT_STORE_PASSES_PER_BATCH = 1000;
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Cost map benchmark, run with -costmaps in place of the pathers
+constexpr int BENCHMARK_COST_MAP_BATCHES = 201;					//Batches timed, the median is reported
+constexpr int BENCHMARK_COST_MAP_PASSES_PER_BATCH = 20;
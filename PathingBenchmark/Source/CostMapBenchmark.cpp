@@ -0,0 +1,93 @@
+#include "CostMapBenchmark.hpp"
+#include "AIPlayerController.hpp"
+#include "TurnScheduler.hpp"
+#include "BenchmarkCommons.hpp"
+#include <algorithm>
+#include <cstdio>
+
+//------------------------------------------------------------------------------------------------------------------------------
+// The tables BuildTileCostTables gives the player, a row per agent type indexed by the tile type byte
+//------------------------------------------------------------------------------------------------------------------------------
+static void FillTileCostTable(eAgentType agentType, std::vector<int>& outTable)
+{
+	outTable.assign(TILE_COST_TABLE_SIZE, 999999);
+	for (int tileType = 0; tileType < NUM_TILE_TYPES; tileType++)
+	{
+		outTable[tileType] = AIPlayerController::GetTileCostForAgentType(agentType, (eTileType)tileType);
+	}
+	outTable[TILE_TYPE_UNSEEN] = AIPlayerController::GetTileCostForAgentType(agentType, TILE_TYPE_UNSEEN);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Median microseconds of one pass, timed in batches like the agent store passes
+//------------------------------------------------------------------------------------------------------------------------------
+template <typename PassFunction>
+static double TimeCostMapPass(PassFunction pass)
+{
+	std::vector<double> batchMicroseconds(BENCHMARK_COST_MAP_BATCHES);
+
+	for (int batchIndex = 0; batchIndex < BENCHMARK_COST_MAP_BATCHES; batchIndex++)
+	{
+		double startSeconds = TurnScheduler::GetCurrentTimeSeconds();
+		for (int passIndex = 0; passIndex < BENCHMARK_COST_MAP_PASSES_PER_BATCH; passIndex++)
+		{
+			pass();
+		}
+		double batchSeconds = TurnScheduler::GetCurrentTimeSeconds() - startSeconds;
+
+		batchMicroseconds[batchIndex] = batchSeconds * 1e6 / (double)BENCHMARK_COST_MAP_PASSES_PER_BATCH;
+	}
+
+	std::sort(batchMicroseconds.begin(), batchMicroseconds.end());
+	return batchMicroseconds[BENCHMARK_COST_MAP_BATCHES / 2];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void RunCostMapBenchmark(const TerrainMap_T& map)
+{
+	int numTiles = map.width * map.width;
+	const eTileType* tileTypes = (const eTileType*)map.tileTypes.data();
+
+	std::vector<int> workerCosts;
+	std::vector<int> scoutCosts;
+	std::vector<int> soldierCosts;
+	FillTileCostTable(AGENT_TYPE_WORKER, workerCosts);
+	FillTileCostTable(AGENT_TYPE_SCOUT, scoutCosts);
+	FillTileCostTable(AGENT_TYPE_SOLDIER, soldierCosts);
+
+	std::vector<int> workerMap(numTiles);
+	std::vector<int> scoutMap(numTiles);
+	std::vector<int> soldierMap(numTiles);
+
+	double switchMicroseconds = TimeCostMapPass([&]()
+	{
+		for (int tileIndex = 0; tileIndex < numTiles; tileIndex++)
+		{
+			workerMap[tileIndex] = AIPlayerController::GetTileCostForAgentType(AGENT_TYPE_WORKER, tileTypes[tileIndex]);
+		}
+		for (int tileIndex = 0; tileIndex < numTiles; tileIndex++)
+		{
+			scoutMap[tileIndex] = AIPlayerController::GetTileCostForAgentType(AGENT_TYPE_SCOUT, tileTypes[tileIndex]);
+		}
+		for (int tileIndex = 0; tileIndex < numTiles; tileIndex++)
+		{
+			soldierMap[tileIndex] = AIPlayerController::GetTileCostForAgentType(AGENT_TYPE_SOLDIER, tileTypes[tileIndex]);
+		}
+	});
+
+	std::vector<int> expectedWorkerMap = workerMap;
+	std::vector<int> expectedScoutMap = scoutMap;
+	std::vector<int> expectedSoldierMap = soldierMap;
+
+	double tableMicroseconds = TimeCostMapPass([&]()
+	{
+		AIPlayerController::FillCostMaps(workerCosts.data(), scoutCosts.data(), soldierCosts.data(), tileTypes, numTiles,
+			workerMap.data(), scoutMap.data(), soldierMap.data());
+	});
+
+	bool isMatch = workerMap == expectedWorkerMap && scoutMap == expectedScoutMap && soldierMap == expectedSoldierMap;
+
+	printf("%s, %dx%d, seed %u\n", map.name.c_str(), map.width, map.width, map.seed);
+	printf("%-40s %10.2f us\n", "GetTileCostForAgentType, 3 passes", switchMicroseconds);
+	printf("%-40s %10.2f us%s\n", "AIPlayerController::FillCostMaps", tableMicroseconds, isMatch ? "" : "  (maps differ!)");
+}
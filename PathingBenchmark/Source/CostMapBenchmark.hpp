@@ -0,0 +1,8 @@
+#pragma once
+#include "TerrainCorpus.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Times costing one map for workers, scouts and soldiers: the three GetTileCostForAgentType passes the player ran before
+// the tile cost tables, against AIPlayerController::FillCostMaps. Prints one line per pass
+//------------------------------------------------------------------------------------------------------------------------------
+void			RunCostMapBenchmark(const TerrainMap_T& map);
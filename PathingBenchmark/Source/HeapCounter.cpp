@@ -0,0 +1,66 @@
+#include "HeapCounter.hpp"
+#include "BenchmarkCommons.hpp"
+#include <atomic>
+#include <malloc.h>
+#include <new>
+#include <stdlib.h>
+
+static std::atomic<size_t> s_heapBytesInUse(0);
+static std::atomic<size_t> s_peakHeapBytes(0);
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Counts what malloc actually handed out, so frees can be taken off without the size being passed back in. The array
+// and nothrow forms of the standard library forward to these
+//------------------------------------------------------------------------------------------------------------------------------
+void* operator new(size_t numBytes)
+{
+	void* memory = malloc(numBytes > 0 ? numBytes : 1);
+	if (memory == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+
+	size_t allocatedBytes = malloc_usable_size(memory);
+	size_t bytesInUse = s_heapBytesInUse.fetch_add(allocatedBytes, std::memory_order_relaxed) + allocatedBytes;
+	size_t peakBytes = s_peakHeapBytes.load(std::memory_order_relaxed);
+	while (bytesInUse > peakBytes && !s_peakHeapBytes.compare_exchange_weak(peakBytes, bytesInUse, std::memory_order_relaxed))
+	{
+	}
+
+	return memory;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void operator delete(void* memory) noexcept
+{
+	if (memory == nullptr)
+		return;
+
+	s_heapBytesInUse.fetch_sub(malloc_usable_size(memory), std::memory_order_relaxed);
+	free(memory);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void operator delete(void* memory, size_t numBytes) noexcept
+{
+	UNUSED(numBytes);
+	operator delete(memory);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+size_t GetHeapBytesInUse()
+{
+	return s_heapBytesInUse.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+size_t GetPeakHeapBytes()
+{
+	return s_peakHeapBytes.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void ResetPeakHeapBytes()
+{
+	s_peakHeapBytes.store(s_heapBytesInUse.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
\ No newline at end of file
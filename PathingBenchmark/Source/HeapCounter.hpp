@@ -0,0 +1,10 @@
+#pragma once
+#include <cstddef>
+
+//------------------------------------------------------------------------------------------------------------------------------
+// HeapCounter.cpp replaces the global operator new and delete for the benchmark, so the heap a pather holds on to and the
+// most it has in use during a batch can be read off without an allocator hook in the player code
+//------------------------------------------------------------------------------------------------------------------------------
+size_t			GetHeapBytesInUse();
+size_t			GetPeakHeapBytes();
+void			ResetPeakHeapBytes();		//The peak starts over from what is in use now
\ No newline at end of file
@@ -0,0 +1,194 @@
+//------------------------------------------------------------------------------------------------------------------------------
+// Pathing micro-benchmark. Generates seeded maps shaped like MapDefinitions.xml entries with SmoothNoise, costs them for
+// each agent type the way the player does, and times the same random start/goal queries through every pather variant.
+// The table goes to stdout, -csv writes one row per batch so builds of different pathers can be compared
+//
+// Build, from the repository root. It links the player sources and the arena simulator's Data file readers:
+//	g++ -std=c++17 -O2 -pthread -IAICombatArena/Source -IArenaSimulator/Source PathingBenchmark/Source/*.cpp
+//		AICombatArena/Source/*.cpp ArenaSimulator/Source/XmlReader.cpp ArenaSimulator/Source/ArenaDefinitions.cpp -o PathingBenchmark
+//
+// Run, also from the repository root:
+//	./PathingBenchmark -maps "Final,Big Blue" -queries 5000 -csv pathing.csv
+//	./PathingBenchmark -agents 256		Times the AgentStore against a std::vector<Agent> instead of the pathers
+//	./PathingBenchmark -costmaps 1		Times costing each map for the three pathing agent types instead of the pathers
+//------------------------------------------------------------------------------------------------------------------------------
+#include "PathingBenchmark.hpp"
+#include "AgentStoreBenchmark.hpp"
+#include "CostMapBenchmark.hpp"
+#include "BenchmarkCommons.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/resource.h>
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void PrintUsage(const char* programName)
+{
+	printf("Usage: %s [options]\n", programName);
+	printf("  -maps <a,b,...>       MapDefinitions to generate (default \"%s\")\n", BENCHMARK_DEFAULT_MAPS);
+	printf("  -size <n>             Map width, overriding each definition's defaultSize\n");
+	printf("  -seed <n>             Terrain and query seed (default %u)\n", BENCHMARK_DEFAULT_SEED);
+	printf("  -queries <n>          Timed queries per map, agent type and pather (default %d)\n", BENCHMARK_DEFAULT_QUERIES);
+	printf("  -limit <n>            Expansions allowed per A* or D* Lite query, 0 for the whole map (default 0)\n");
+	printf("  -pathers <a,b,...>    Any of astar, auto, jps, hpa, dstarlite, flowfield (default all)\n");
+	printf("  -data <folder>        Folder holding MapDefinitions.xml (default Arena/Run_Windows/Data)\n");
+	printf("  -csv <file>           Also write the results as CSV, \"-\" writes only the CSV to stdout\n");
+	printf("  -agents <n>           Time the agent store passes over n agents instead of the pathers\n");
+	printf("  -costmaps <0|1>       Time costing each map for workers, scouts and soldiers instead of the pathers\n");
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static std::vector<std::string> SplitCommaList(const char* text)
+{
+	std::vector<std::string> entries;
+	std::string entry;
+
+	for (const char* character = text; ; character++)
+	{
+		if (*character == ',' || *character == '\0')
+		{
+			if (!entry.empty())
+			{
+				entries.push_back(entry);
+			}
+
+			entry.clear();
+			if (*character == '\0')
+				break;
+		}
+		else
+		{
+			entry += *character;
+		}
+	}
+
+	return entries;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static bool SelectPathers(const char* patherList, BenchmarkSettings_T& settings)
+{
+	for (int variantIndex = 0; variantIndex < NUM_PATHER_VARIANTS; variantIndex++)
+	{
+		settings.runVariant[variantIndex] = false;
+	}
+
+	std::vector<std::string> names = SplitCommaList(patherList);
+	for (int nameIndex = 0; nameIndex < (int)names.size(); nameIndex++)
+	{
+		bool isKnown = false;
+		for (int variantIndex = 0; variantIndex < NUM_PATHER_VARIANTS; variantIndex++)
+		{
+			if (names[nameIndex] == PathingBenchmark::GetVariantName((ePatherVariant)variantIndex))
+			{
+				settings.runVariant[variantIndex] = true;
+				isKnown = true;
+			}
+		}
+
+		if (!isKnown)
+		{
+			fprintf(stderr, "PathingBenchmark: no pather called %s\n", names[nameIndex].c_str());
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+	BenchmarkSettings_T settings;
+	settings.numQueries = BENCHMARK_DEFAULT_QUERIES;
+	settings.seed = BENCHMARK_DEFAULT_SEED;
+
+	std::string mapList = BENCHMARK_DEFAULT_MAPS;
+	std::string dataFolder = "Arena/Run_Windows/Data";
+	std::string csvPath;
+	int sizeOverride = 0;
+	int numStoreAgents = 0;
+	bool isCostMapRun = false;
+
+	for (int argIndex = 1; argIndex < argc; argIndex++)
+	{
+		const char* arg = argv[argIndex];
+		const char* value = argIndex + 1 < argc ? argv[argIndex + 1] : nullptr;
+
+		if (value == nullptr)
+		{
+			PrintUsage(argv[0]);
+			return 1;
+		}
+
+		argIndex++;
+		if (strcmp(arg, "-maps") == 0)				mapList = value;
+		else if (strcmp(arg, "-size") == 0)			sizeOverride = atoi(value);
+		else if (strcmp(arg, "-seed") == 0)			settings.seed = (unsigned int)strtoul(value, nullptr, 10);
+		else if (strcmp(arg, "-queries") == 0)		settings.numQueries = atoi(value);
+		else if (strcmp(arg, "-limit") == 0)		settings.searchLimit = atoi(value);
+		else if (strcmp(arg, "-data") == 0)			dataFolder = value;
+		else if (strcmp(arg, "-csv") == 0)			csvPath = value;
+		else if (strcmp(arg, "-agents") == 0)		numStoreAgents = atoi(value);
+		else if (strcmp(arg, "-costmaps") == 0)		isCostMapRun = atoi(value) != 0;
+		else if (strcmp(arg, "-pathers") == 0)
+		{
+			if (!SelectPathers(value, settings))
+				return 1;
+		}
+		else
+		{
+			PrintUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (numStoreAgents > 0)
+	{
+		RunAgentStoreBenchmark(numStoreAgents, settings.seed);
+		return 0;
+	}
+
+	PathingBenchmark benchmark;
+	benchmark.Init(settings);
+
+	std::vector<std::string> mapNames = SplitCommaList(mapList.c_str());
+	for (int mapIndex = 0; mapIndex < (int)mapNames.size(); mapIndex++)
+	{
+		TerrainMap_T map;
+		std::string error;
+		if (!GenerateTerrainMap(dataFolder + "/MapDefinitions.xml", mapNames[mapIndex], sizeOverride, settings.seed, map, error))
+		{
+			fprintf(stderr, "PathingBenchmark: %s\n", error.c_str());
+			return 1;
+		}
+
+		if (isCostMapRun)
+		{
+			RunCostMapBenchmark(map);
+			continue;
+		}
+
+		benchmark.RunMap(map);
+	}
+
+	if (isCostMapRun)
+		return 0;
+
+	if (!csvPath.empty() && !benchmark.WriteCsv(csvPath))
+	{
+		fprintf(stderr, "PathingBenchmark: could not write %s\n", csvPath.c_str());
+		return 1;
+	}
+
+	if (csvPath != "-")
+	{
+		benchmark.PrintResults();
+
+		struct rusage usage;
+		getrusage(RUSAGE_SELF, &usage);
+		printf("\nPeak resident set %ld KB\n", usage.ru_maxrss);
+	}
+
+	return 0;
+}
\ No newline at end of file
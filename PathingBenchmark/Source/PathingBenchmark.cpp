@@ -0,0 +1,368 @@
+#include "PathingBenchmark.hpp"
+#include "AIPlayerController.hpp"
+#include "AStarPathing.hpp"
+#include "HierarchicalPathing.hpp"
+#include "IncrementalPathing.hpp"
+#include "Pathing.hpp"
+#include "MathUtils.hpp"
+#include "RandomNumberGenerator.hpp"
+#include "RawNoise.hpp"
+#include "TurnScheduler.hpp"
+#include "BenchmarkCommons.hpp"
+#include "HeapCounter.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+
+//------------------------------------------------------------------------------------------------------------------------------
+// The agent types the player keeps cost maps for, queens and the rest never path
+static const eAgentType g_pathingAgentTypes[] = { AGENT_TYPE_WORKER, AGENT_TYPE_SCOUT, AGENT_TYPE_SOLDIER };
+static const char* const g_pathingAgentTypeNames[] = { "Worker", "Scout", "Soldier" };
+constexpr int NUM_PATHING_AGENT_TYPES = sizeof(g_pathingAgentTypes) / sizeof(g_pathingAgentTypes[0]);
+
+static const char* const g_variantNames[NUM_PATHER_VARIANTS] = { "astar", "auto", "jps", "hpa", "dstarlite", "flowfield" };
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Only the selected variant's pathers are created, so the heap they hold can be measured on its own
+//------------------------------------------------------------------------------------------------------------------------------
+struct BenchmarkPathers_T
+{
+	std::unique_ptr<AStarPather>			aStar;
+	std::unique_ptr<JumpPointTable>			jumpPointTable;
+	std::unique_ptr<HierarchicalPather>		hierarchical;
+	std::unique_ptr<HPAQueryContext_T>		hierarchicalContext;
+	std::unique_ptr<DStarLitePather>		incremental;
+	std::unique_ptr<Pather>					flowPather;
+	std::unique_ptr<PathSolver>				flowSolver;
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+static void SetUpPathers(ePatherVariant variant, const IntVec2& mapDimensions, const std::vector<int>& tileCosts, BenchmarkPathers_T& pathers)
+{
+	switch (variant)
+	{
+	case PATHER_VARIANT_ASTAR:
+	case PATHER_VARIANT_JPS:
+		pathers.aStar = std::make_unique<AStarPather>();
+		pathers.aStar->Init(mapDimensions);
+		break;
+	case PATHER_VARIANT_AUTO:
+		pathers.aStar = std::make_unique<AStarPather>();
+		pathers.aStar->Init(mapDimensions);
+		pathers.jumpPointTable = std::make_unique<JumpPointTable>();
+		pathers.jumpPointTable->Build(mapDimensions, tileCosts);
+		break;
+	case PATHER_VARIANT_HIERARCHICAL:
+		pathers.hierarchical = std::make_unique<HierarchicalPather>();
+		pathers.hierarchical->Init(mapDimensions);
+		pathers.hierarchical->UpdateCosts(tileCosts);
+		pathers.hierarchicalContext = std::make_unique<HPAQueryContext_T>();
+		HierarchicalPather::InitQueryContext(*pathers.hierarchicalContext, mapDimensions);
+		break;
+	case PATHER_VARIANT_INCREMENTAL:
+		pathers.incremental = std::make_unique<DStarLitePather>();
+		pathers.incremental->Init(mapDimensions);
+		break;
+	case PATHER_VARIANT_FLOW_FIELD:
+		pathers.flowPather = std::make_unique<Pather>();
+		pathers.flowPather->Init(mapDimensions, 1.f);
+		pathers.flowPather->SetCostsFromCostMap(tileCosts);
+		pathers.flowSolver = std::make_unique<PathSolver>();
+		break;
+	default:
+		break;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Every variant's path comes back the way AStarPather returns it: ordered end first without the start tile
+//------------------------------------------------------------------------------------------------------------------------------
+static Path SolveQuery(ePatherVariant variant, BenchmarkPathers_T& pathers, int startTileIndex, int endTileIndex, const IntVec2& mapDimensions, const std::vector<int>& tileCosts, int uniformTileCost, int searchLimit)
+{
+	switch (variant)
+	{
+	case PATHER_VARIANT_ASTAR:
+		return pathers.aStar->CreatePathAStar(startTileIndex, endTileIndex, mapDimensions, tileCosts, searchLimit);
+	case PATHER_VARIANT_AUTO:
+		return pathers.aStar->CreatePath(startTileIndex, endTileIndex, mapDimensions, tileCosts, uniformTileCost, searchLimit, pathers.jumpPointTable.get());
+	case PATHER_VARIANT_JPS:
+		if (uniformTileCost > 0)
+			return pathers.aStar->CreatePathJPS(startTileIndex, endTileIndex, mapDimensions, tileCosts, uniformTileCost, searchLimit);
+		return pathers.aStar->CreatePathAStar(startTileIndex, endTileIndex, mapDimensions, tileCosts, searchLimit);
+	case PATHER_VARIANT_HIERARCHICAL:
+		return pathers.hierarchical->CreatePath(startTileIndex, endTileIndex, *pathers.hierarchicalContext);
+	case PATHER_VARIANT_INCREMENTAL:
+		return pathers.incremental->CreatePath(startTileIndex, endTileIndex, tileCosts, searchLimit);
+	case PATHER_VARIANT_FLOW_FIELD:
+	{
+		//The solver walks start first down to the seed, and leaves just the start when it can't get there
+		PathSolver& solver = *pathers.flowSolver;
+		solver.ClearEndsAndStart();
+		solver.AddEnd(IntVec2(endTileIndex % mapDimensions.x, endTileIndex / mapDimensions.x));
+		solver.AddStart(IntVec2(startTileIndex % mapDimensions.x, startTileIndex / mapDimensions.x));
+
+		Path path;
+		solver.StartDistanceField(pathers.flowPather.get(), &path);
+		std::reverse(path.begin(), path.end());
+		path.pop_back();
+		return path;
+	}
+	default:
+		return Path();
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+static unsigned long long GetNodesExpanded(ePatherVariant variant, const BenchmarkPathers_T& pathers)
+{
+	switch (variant)
+	{
+	case PATHER_VARIANT_ASTAR:
+	case PATHER_VARIANT_AUTO:
+	case PATHER_VARIANT_JPS:
+		return pathers.aStar->m_nodesExpanded;
+	case PATHER_VARIANT_HIERARCHICAL:
+		return pathers.hierarchicalContext->nodesExpanded;
+	case PATHER_VARIANT_INCREMENTAL:
+		return pathers.incremental->m_nodesExpanded;
+	case PATHER_VARIANT_FLOW_FIELD:
+		return pathers.flowSolver->m_nodesExpanded;
+	default:
+		return 0;
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// A failed AStarPather search still returns the end tile, so a path only counts if it also reaches back next to the start
+//------------------------------------------------------------------------------------------------------------------------------
+static bool IsPathComplete(const Path& path, const IntVec2& startTile, const IntVec2& endTile)
+{
+	return !path.empty() && path.front() == endTile && GetManhattanDistance(path.back(), startTile) == 1;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Nearest rank on latencies sorted lowest first
+//------------------------------------------------------------------------------------------------------------------------------
+static double GetPercentile(const std::vector<double>& sortedValues, int percent)
+{
+	if (sortedValues.empty())
+		return 0.0;
+
+	int rank = ((int)sortedValues.size() * percent + 99) / 100;
+	return sortedValues[rank > 0 ? rank - 1 : 0];
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PathingBenchmark::Init(const BenchmarkSettings_T& settings)
+{
+	m_settings = settings;
+	m_results.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Costs the map the way the player costs what it has seen, then runs each selected pather on the same queries
+//------------------------------------------------------------------------------------------------------------------------------
+void PathingBenchmark::RunMap(const TerrainMap_T& map)
+{
+	int numTiles = map.width * map.width;
+	std::vector<int> tileCosts(numTiles);
+	std::vector<int> queryTiles;
+
+	for (int typeIndex = 0; typeIndex < NUM_PATHING_AGENT_TYPES; typeIndex++)
+	{
+		for (int tileIndex = 0; tileIndex < numTiles; tileIndex++)
+		{
+			tileCosts[tileIndex] = AIPlayerController::GetTileCostForAgentType(g_pathingAgentTypes[typeIndex], (eTileType)map.tileTypes[tileIndex]);
+		}
+
+		PickQueries(map, typeIndex, tileCosts, queryTiles);
+		if (queryTiles.empty())
+		{
+			fprintf(stderr, "PathingBenchmark: %s has fewer than two tiles a %s can stand on, skipping it\n", map.name.c_str(), g_pathingAgentTypeNames[typeIndex]);
+			continue;
+		}
+
+		for (int variantIndex = 0; variantIndex < NUM_PATHER_VARIANTS; variantIndex++)
+		{
+			if (m_settings.runVariant[variantIndex])
+			{
+				m_results.push_back(RunBatch(map, typeIndex, (ePatherVariant)variantIndex, tileCosts, queryTiles));
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Start and end tile pairs, BENCHMARK_WARMUP_QUERIES of them first and then numQueries, all on tiles the agent type can
+// stand on. Pairs in separate pockets of the map are kept: the player asks for those too, and failing them is the
+// slowest thing a pather does
+//------------------------------------------------------------------------------------------------------------------------------
+void PathingBenchmark::PickQueries(const TerrainMap_T& map, int agentType, const std::vector<int>& tileCosts, std::vector<int>& outQueryTiles) const
+{
+	outQueryTiles.clear();
+
+	std::vector<int> passableTiles;
+	for (int tileIndex = 0; tileIndex < (int)tileCosts.size(); tileIndex++)
+	{
+		if (tileCosts[tileIndex] < ASTAR_IMPASSABLE_COST)
+		{
+			passableTiles.push_back(tileIndex);
+		}
+	}
+
+	if (passableTiles.size() < 2)
+		return;
+
+	RandomNumberGenerator rng(Get3dNoiseUint(agentType, map.width, (int)map.seed, m_settings.seed));
+
+	int numPairs = BENCHMARK_WARMUP_QUERIES + m_settings.numQueries;
+	for (int pairIndex = 0; pairIndex < numPairs; pairIndex++)
+	{
+		int startTileIndex = passableTiles[rng.GetRandomIntLessThan((int)passableTiles.size())];
+		int endTileIndex = startTileIndex;
+		while (endTileIndex == startTileIndex)
+		{
+			endTileIndex = passableTiles[rng.GetRandomIntLessThan((int)passableTiles.size())];
+		}
+
+		outQueryTiles.push_back(startTileIndex);
+		outQueryTiles.push_back(endTileIndex);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+BenchmarkResult_T PathingBenchmark::RunBatch(const TerrainMap_T& map, int agentType, ePatherVariant variant, const std::vector<int>& tileCosts, const std::vector<int>& queryTiles) const
+{
+	BenchmarkResult_T result;
+	result.mapName = map.name;
+	result.mapWidth = map.width;
+	result.seed = map.seed;
+	result.agentTypeName = g_pathingAgentTypeNames[agentType];
+	result.variantName = g_variantNames[variant];
+	result.numQueries = m_settings.numQueries;
+
+	IntVec2 mapDimensions = IntVec2(map.width, map.width);
+	int uniformTileCost = AStarPather::GetUniformTileCost(tileCosts);
+	int searchLimit = m_settings.searchLimit > 0 ? m_settings.searchLimit : map.width * map.width;
+
+	std::vector<double> latencies;
+	latencies.reserve(m_settings.numQueries);
+
+	size_t baselineBytes = GetHeapBytesInUse();
+	BenchmarkPathers_T pathers;
+
+	double setupStartSeconds = TurnScheduler::GetCurrentTimeSeconds();
+	SetUpPathers(variant, mapDimensions, tileCosts, pathers);
+	result.setupSeconds = TurnScheduler::GetCurrentTimeSeconds() - setupStartSeconds;
+
+	for (int queryIndex = 0; queryIndex < BENCHMARK_WARMUP_QUERIES; queryIndex++)
+	{
+		SolveQuery(variant, pathers, queryTiles[queryIndex * 2], queryTiles[queryIndex * 2 + 1], mapDimensions, tileCosts, uniformTileCost, searchLimit);
+	}
+
+	size_t heldBytes = GetHeapBytesInUse();
+	result.heldBytes = heldBytes - baselineBytes;
+	ResetPeakHeapBytes();
+
+	unsigned long long nodesExpandedBefore = GetNodesExpanded(variant, pathers);
+	double totalSeconds = 0.0;
+	long long totalPathLength = 0;
+	long long totalPathCost = 0;
+
+	for (int queryIndex = BENCHMARK_WARMUP_QUERIES; queryIndex < BENCHMARK_WARMUP_QUERIES + m_settings.numQueries; queryIndex++)
+	{
+		int startTileIndex = queryTiles[queryIndex * 2];
+		int endTileIndex = queryTiles[queryIndex * 2 + 1];
+
+		double queryStartSeconds = TurnScheduler::GetCurrentTimeSeconds();
+		Path path = SolveQuery(variant, pathers, startTileIndex, endTileIndex, mapDimensions, tileCosts, uniformTileCost, searchLimit);
+		double querySeconds = TurnScheduler::GetCurrentTimeSeconds() - queryStartSeconds;
+
+		totalSeconds += querySeconds;
+		latencies.push_back(querySeconds * 1000000.0);
+
+		IntVec2 startTile = IntVec2(startTileIndex % map.width, startTileIndex / map.width);
+		IntVec2 endTile = IntVec2(endTileIndex % map.width, endTileIndex / map.width);
+		if (!IsPathComplete(path, startTile, endTile))
+			continue;
+
+		result.numPathsFound++;
+		totalPathLength += (long long)path.size();
+		for (int stepIndex = 0; stepIndex < (int)path.size(); stepIndex++)
+		{
+			totalPathCost += tileCosts[path[stepIndex].y * map.width + path[stepIndex].x];
+		}
+	}
+
+	result.peakQueryBytes = GetPeakHeapBytes() - heldBytes;
+
+	if (m_settings.numQueries > 0)
+	{
+		result.nodesExpandedPerQuery = (double)(GetNodesExpanded(variant, pathers) - nodesExpandedBefore) / (double)m_settings.numQueries;
+		result.queriesPerSecond = totalSeconds > 0.0 ? (double)m_settings.numQueries / totalSeconds : 0.0;
+	}
+
+	if (result.numPathsFound > 0)
+	{
+		result.avgPathLength = (double)totalPathLength / (double)result.numPathsFound;
+		result.avgPathCost = (double)totalPathCost / (double)result.numPathsFound;
+	}
+
+	std::sort(latencies.begin(), latencies.end());
+	result.p50Microseconds = GetPercentile(latencies, 50);
+	result.p99Microseconds = GetPercentile(latencies, 99);
+	result.maxMicroseconds = latencies.empty() ? 0.0 : latencies.back();
+
+	return result;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+void PathingBenchmark::PrintResults() const
+{
+	printf("%-16s %4s %-8s %-10s %11s %11s %10s %9s %9s %9s %7s %8s %9s %9s %9s\n", "Map", "Size", "Agent", "Pather", "Found",
+		"Queries/s", "Nodes/q", "p50 us", "p99 us", "Max us", "Length", "Cost", "Setup ms", "Held KB", "Peak KB");
+
+	for (int resultIndex = 0; resultIndex < (int)m_results.size(); resultIndex++)
+	{
+		const BenchmarkResult_T& result = m_results[resultIndex];
+		printf("%-16s %4d %-8s %-10s %5d/%-5d %11.0f %10.1f %9.2f %9.2f %9.2f %7.1f %8.1f %9.3f %9.1f %9.1f\n",
+			result.mapName.c_str(), result.mapWidth, result.agentTypeName, result.variantName, result.numPathsFound, result.numQueries,
+			result.queriesPerSecond, result.nodesExpandedPerQuery, result.p50Microseconds, result.p99Microseconds, result.maxMicroseconds,
+			result.avgPathLength, result.avgPathCost, result.setupSeconds * 1000.0, (double)result.heldBytes / 1024.0, (double)result.peakQueryBytes / 1024.0);
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// One row per batch with raw units, so runs of different pather builds can be joined on map, seed, agent and pather
+//------------------------------------------------------------------------------------------------------------------------------
+bool PathingBenchmark::WriteCsv(const std::string& filePath) const
+{
+	FILE* file = filePath == "-" ? stdout : fopen(filePath.c_str(), "w");
+	if (file == nullptr)
+		return false;
+
+	fprintf(file, "map,size,seed,agent,pather,queries,found,setup_ms,queries_per_sec,nodes_per_query,p50_us,p99_us,max_us,"
+		"avg_path_length,avg_path_cost,held_bytes,peak_query_bytes\n");
+
+	for (int resultIndex = 0; resultIndex < (int)m_results.size(); resultIndex++)
+	{
+		const BenchmarkResult_T& result = m_results[resultIndex];
+		fprintf(file, "\"%s\",%d,%u,%s,%s,%d,%d,%.4f,%.1f,%.2f,%.3f,%.3f,%.3f,%.2f,%.2f,%zu,%zu\n",
+			result.mapName.c_str(), result.mapWidth, result.seed, result.agentTypeName, result.variantName, result.numQueries, result.numPathsFound,
+			result.setupSeconds * 1000.0, result.queriesPerSecond, result.nodesExpandedPerQuery, result.p50Microseconds, result.p99Microseconds,
+			result.maxMicroseconds, result.avgPathLength, result.avgPathCost, result.heldBytes, result.peakQueryBytes);
+	}
+
+	if (file != stdout)
+	{
+		fclose(file);
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+STATIC const char* PathingBenchmark::GetVariantName(ePatherVariant variant)
+{
+	return g_variantNames[variant];
+}
\ No newline at end of file
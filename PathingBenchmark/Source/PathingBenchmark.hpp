@@ -0,0 +1,77 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "TerrainCorpus.hpp"
+
+//------------------------------------------------------------------------------------------------------------------------------
+enum ePatherVariant
+{
+	PATHER_VARIANT_ASTAR = 0,		//AStarPather::CreatePathAStar
+	PATHER_VARIANT_AUTO,			//AStarPather::CreatePath, JPS+ on uniform cost maps, as the player calls it
+	PATHER_VARIANT_JPS,				//AStarPather::CreatePathJPS walking its jumps, without a jump point table
+	PATHER_VARIANT_HIERARCHICAL,	//HierarchicalPather over HPA_CLUSTER_SIZE clusters
+	PATHER_VARIANT_INCREMENTAL,		//DStarLitePather, every query is a new goal so this is its cold cost
+	PATHER_VARIANT_FLOW_FIELD,		//PathSolver flooding from the goal until the start settles
+
+	NUM_PATHER_VARIANTS
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+struct BenchmarkSettings_T
+{
+	int				numQueries = 0;
+	unsigned int	seed = 0;
+	int				searchLimit = 0;			//Expansions allowed per A* or D* Lite query, 0 allows the whole map
+	bool			runVariant[NUM_PATHER_VARIANTS] = { true, true, true, true, true, true };
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// One batch: a map, an agent type's cost map and a pather. Latencies are per query in microseconds
+//------------------------------------------------------------------------------------------------------------------------------
+struct BenchmarkResult_T
+{
+	std::string		mapName;
+	int				mapWidth = 0;
+	unsigned int	seed = 0;
+	const char*		agentTypeName = "";
+	const char*		variantName = "";
+
+	int				numQueries = 0;
+	int				numPathsFound = 0;
+
+	double			setupSeconds = 0.0;			//Init and cost upload, HPA's cluster build included
+	double			queriesPerSecond = 0.0;
+	double			nodesExpandedPerQuery = 0.0;
+	double			p50Microseconds = 0.0;
+	double			p99Microseconds = 0.0;
+	double			maxMicroseconds = 0.0;
+	double			avgPathLength = 0.0;		//Over the paths found
+	double			avgPathCost = 0.0;			//Sum of the entered tiles' costs, equal across pathers that return shortest paths
+
+	size_t			heldBytes = 0;				//Heap the pather keeps between queries, after setup and warmup
+	size_t			peakQueryBytes = 0;			//Most heap in use above that during the timed queries, returned paths included
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Runs the same seeded start/goal queries through every selected pather, once per agent type the player paths with,
+// on each map it is handed
+//------------------------------------------------------------------------------------------------------------------------------
+class PathingBenchmark
+{
+public:
+	void			Init(const BenchmarkSettings_T& settings);
+	void			RunMap(const TerrainMap_T& map);
+
+	void			PrintResults() const;
+	bool			WriteCsv(const std::string& filePath) const;		//"-" writes to stdout
+
+	static const char*		GetVariantName(ePatherVariant variant);
+
+private:
+	BenchmarkResult_T	RunBatch(const TerrainMap_T& map, int agentType, ePatherVariant variant, const std::vector<int>& tileCosts, const std::vector<int>& queryTiles) const;
+	void				PickQueries(const TerrainMap_T& map, int agentType, const std::vector<int>& tileCosts, std::vector<int>& outQueryTiles) const;
+
+private:
+	BenchmarkSettings_T				m_settings;
+	std::vector<BenchmarkResult_T>	m_results;
+};
\ No newline at end of file
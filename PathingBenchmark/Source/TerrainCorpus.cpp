@@ -0,0 +1,105 @@
+#include "TerrainCorpus.hpp"
+#include "ArenaDefinitions.hpp"
+#include "BenchmarkCommons.hpp"
+#include "RawNoise.hpp"
+#include "SmoothNoise.hpp"
+#include <algorithm>
+#include <math.h>
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Picks a value in a "min~max" range from the seed instead of an RNG, so a map only depends on its seed
+//------------------------------------------------------------------------------------------------------------------------------
+static float GetNoiseInRange(const FloatRange_T& range, int noiseIndex, unsigned int seed)
+{
+	if (range.max <= range.min)
+		return range.min;
+
+	return range.min + (range.max - range.min) * Get1dNoiseZeroToOne(noiseIndex, seed);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Covers the interior tiles a strand type would, strandsPer100Tiles * strandLength per 100 tiles, with the tiles whose
+// Perlin value is closest to zero. Ties on the threshold may cover a few extra tiles
+//------------------------------------------------------------------------------------------------------------------------------
+static void DrawNoiseStrands(TerrainMap_T& map, eTileType tileType, float strandsPer100Tiles, float strandLength, unsigned int seed)
+{
+	int interiorWidth = map.width - 2;
+	int numInteriorTiles = interiorWidth * interiorWidth;
+	int numTilesToCover = (int)((float)numInteriorTiles * strandsPer100Tiles * strandLength / 100.f);
+
+	if (numTilesToCover <= 0 || strandsPer100Tiles <= 0.f)
+		return;
+
+	if (numTilesToCover > numInteriorTiles)
+	{
+		numTilesToCover = numInteriorTiles;
+	}
+
+	float noiseScale = BENCHMARK_STRAND_SPACING / sqrtf(strandsPer100Tiles);
+
+	std::vector<float> ridgeValues(numInteriorTiles);
+	for (int tileY = 1; tileY <= interiorWidth; tileY++)
+	{
+		for (int tileX = 1; tileX <= interiorWidth; tileX++)
+		{
+			float noise = Compute2dPerlinNoise((float)tileX, (float)tileY, noiseScale, BENCHMARK_STRAND_OCTAVES, BENCHMARK_STRAND_PERSISTENCE, 2.f, true, seed);
+			ridgeValues[(tileY - 1) * interiorWidth + (tileX - 1)] = fabsf(noise);
+		}
+	}
+
+	std::vector<float> sortedValues = ridgeValues;
+	std::nth_element(sortedValues.begin(), sortedValues.begin() + (numTilesToCover - 1), sortedValues.end());
+	float threshold = sortedValues[numTilesToCover - 1];
+
+	for (int tileY = 1; tileY <= interiorWidth; tileY++)
+	{
+		for (int tileX = 1; tileX <= interiorWidth; tileX++)
+		{
+			if (ridgeValues[(tileY - 1) * interiorWidth + (tileX - 1)] <= threshold)
+			{
+				map.tileTypes[tileY * map.width + tileX] = (unsigned char)tileType;
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------------------------------------------------------
+bool GenerateTerrainMap(const std::string& mapDefinitionsPath, const std::string& mapName, int sizeOverride, unsigned int seed, TerrainMap_T& outMap, std::string& outError)
+{
+	MapDefinition_T definition;
+	if (!LoadMapDefinition(mapDefinitionsPath, mapName, definition, outError))
+		return false;
+
+	outMap = TerrainMap_T();
+	outMap.name = definition.name;
+	outMap.width = sizeOverride > 0 ? sizeOverride : definition.defaultSize;
+	outMap.seed = seed;
+
+	if (outMap.width < 3)
+	{
+		outError = "map " + mapName + " is too small to have an interior";
+		return false;
+	}
+
+	outMap.tileTypes.assign(outMap.width * outMap.width, (unsigned char)definition.fillTile);
+
+	for (int strandIndex = 0; strandIndex < (int)definition.tileStrands.size(); strandIndex++)
+	{
+		const TileStrandInfo_T& strandInfo = definition.tileStrands[strandIndex];
+
+		float strandsPer100Tiles = GetNoiseInRange(strandInfo.strandsPer100Tiles, strandIndex * 2, seed);
+		float strandLength = GetNoiseInRange(strandInfo.strandLength, strandIndex * 2 + 1, seed);
+		DrawNoiseStrands(outMap, strandInfo.type, strandsPer100Tiles, strandLength, Get1dNoiseUint(strandIndex, seed));
+	}
+
+	for (int edgeIndex = 0; edgeIndex < outMap.width; edgeIndex++)
+	{
+		int lastIndex = outMap.width - 1;
+		outMap.tileTypes[edgeIndex] = (unsigned char)definition.edgeTile;
+		outMap.tileTypes[lastIndex * outMap.width + edgeIndex] = (unsigned char)definition.edgeTile;
+		outMap.tileTypes[edgeIndex * outMap.width] = (unsigned char)definition.edgeTile;
+		outMap.tileTypes[edgeIndex * outMap.width + lastIndex] = (unsigned char)definition.edgeTile;
+	}
+
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+#pragma once
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------------------------------------------------------------
+// One generated map of the corpus. Tiles are kept as eTileType bytes so this header stays clear of both copies of
+// ArenaPlayerInterface.hpp: the generator reads MapDefinitions.xml through the arena's, the pathers cost through the player's
+//------------------------------------------------------------------------------------------------------------------------------
+struct TerrainMap_T
+{
+	std::string					name;
+	int							width = 0;
+	unsigned int				seed = 0;
+	std::vector<unsigned char>	tileTypes;		//Indexed y * width + x
+};
+
+//------------------------------------------------------------------------------------------------------------------------------
+// Shapes a map like the named MapDefinition: its fill, each TileInfo's share of the map laid down as noise strands in the
+// listed order, then its edge. Colony tunnels and food are left out, they don't change what the pathers have to search
+bool			GenerateTerrainMap(const std::string& mapDefinitionsPath, const std::string& mapName, int sizeOverride, unsigned int seed, TerrainMap_T& outMap, std::string& outError);
\ No newline at end of file